@@ -839,6 +839,16 @@ public:
   int getMinMaxReductionCost(Type *Ty, Type *CondTy, bool IsPairwiseForm,
                              bool IsUnsigned) const;
 
+  /// Calculate the cost of an add reduction of an extended vector.
+  ///
+  /// This is the cost of zero (\p IsUnsigned) or sign extending each element
+  /// of the vector \p Ty to the scalar type \p ResTy and add reducing the
+  /// result to a single \p ResTy value. Targets with widening horizontal
+  /// instructions (e.g. PSADBW on X86) can do this for less than the sum of
+  /// the vector extension and the reduction.
+  int getExtendedAddReductionCost(bool IsUnsigned, Type *ResTy, Type *Ty,
+                                  bool IsPairwiseForm) const;
+
   /// \returns The cost of Intrinsic instructions. Analyses the real arguments.
   /// Three cases are handled: 1. scalar instruction 2. vector instruction
   /// 3. scalar instruction which is to be vectorized with VF.
@@ -1133,6 +1143,8 @@ public:
                                          bool IsPairwiseForm) = 0;
   virtual int getMinMaxReductionCost(Type *Ty, Type *CondTy,
                                      bool IsPairwiseForm, bool IsUnsigned) = 0;
+  virtual int getExtendedAddReductionCost(bool IsUnsigned, Type *ResTy,
+                                          Type *Ty, bool IsPairwiseForm) = 0;
   virtual int getIntrinsicInstrCost(Intrinsic::ID ID, Type *RetTy,
                       ArrayRef<Type *> Tys, FastMathFlags FMF,
                       unsigned ScalarizationCostPassed) = 0;
@@ -1479,6 +1491,11 @@ public:
                              bool IsPairwiseForm, bool IsUnsigned) override {
     return Impl.getMinMaxReductionCost(Ty, CondTy, IsPairwiseForm, IsUnsigned);
    }
+  int getExtendedAddReductionCost(bool IsUnsigned, Type *ResTy, Type *Ty,
+                                  bool IsPairwiseForm) override {
+    return Impl.getExtendedAddReductionCost(IsUnsigned, ResTy, Ty,
+                                            IsPairwiseForm);
+  }
   int getIntrinsicInstrCost(Intrinsic::ID ID, Type *RetTy, ArrayRef<Type *> Tys,
                FastMathFlags FMF, unsigned ScalarizationCostPassed) override {
     return Impl.getIntrinsicInstrCost(ID, RetTy, Tys, FMF,
@@ -478,6 +478,10 @@ public:
 
   unsigned getMinMaxReductionCost(Type *, Type *, bool, bool) { return 1; }
 
+  unsigned getExtendedAddReductionCost(bool, Type *, Type *, bool) {
+    return 1;
+  }
+
   unsigned getCostOfKeepingLiveOverCall(ArrayRef<Type *> Tys) { return 0; }
 
   bool getTgtMemIntrinsic(IntrinsicInst *Inst, MemIntrinsicInfo &Info) {
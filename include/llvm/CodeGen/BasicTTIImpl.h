@@ -1360,6 +1360,20 @@ public:
                                            ScalarCondTy, nullptr);
   }
 
+  /// Extended add reductions are modelled as a vector extension followed by
+  /// a regular add reduction of the extended vector.
+  unsigned getExtendedAddReductionCost(bool IsUnsigned, Type *ResTy, Type *Ty,
+                                       bool IsPairwise) {
+    assert(Ty->isVectorTy() && "Expect a vector type");
+    Type *ExtTy = VectorType::get(ResTy, Ty->getVectorNumElements());
+    auto *ConcreteTTI = static_cast<T *>(this);
+    return ConcreteTTI->getCastInstrCost(IsUnsigned ? Instruction::ZExt
+                                                    : Instruction::SExt,
+                                         ExtTy, Ty) +
+           ConcreteTTI->getArithmeticReductionCost(Instruction::Add, ExtTy,
+                                                   IsPairwise);
+  }
+
   unsigned getVectorSplitCost() { return 1; }
 
   /// @}
@@ -117,6 +117,14 @@ public:
   }
 #endif // USE_OPROFILE
 
+#if LLVM_USE_PERF
+  // Construct a PerfJITEventListener, which writes the perf map and the
+  // jitdump file of the process for Linux's perf.
+  static JITEventListener *createPerfJITEventListener();
+#else
+  static JITEventListener *createPerfJITEventListener() { return nullptr; }
+#endif // USE_PERF
+
 private:
   virtual void anchor();
 };
@@ -133,4 +141,8 @@ LLVMJITEventListenerRef LLVMCreateIntelJITEventListener(void);
 LLVMJITEventListenerRef LLVMCreateOProfileJITEventListener(void);
 #endif
 
+#ifndef LLVM_USE_PERF
+LLVMJITEventListenerRef LLVMCreatePerfJITEventListener(void);
+#endif
+
 #endif // LLVM_EXECUTIONENGINE_JITEVENTLISTENER_H
@@ -16,6 +16,7 @@
 
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/Object/Binary.h"
 #include "llvm/Object/ObjectFile.h"
@@ -27,6 +28,8 @@
 #include "llvm/Target/TargetMachine.h"
 #include <algorithm>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace llvm {
 
@@ -114,6 +117,46 @@ private:
   ObjectCache *ObjCache = nullptr;
 };
 
+/// A thread-safe version of SimpleCompiler.
+///
+/// Each compile borrows a TargetMachine from a pool shared by all copies of
+/// the compiler and returns it when done, so concurrent compiles never share
+/// a TargetMachine. When every pooled TargetMachine is in use a new one is
+/// created, giving one TargetMachine per compile thread.
+///
+/// Modules compiled concurrently must not share an LLVMContext, and the
+/// ObjectCache, if any, must be thread-safe.
+class ConcurrentIRCompiler {
+public:
+  ConcurrentIRCompiler(JITTargetMachineBuilder JTMB,
+                       ObjectCache *ObjCache = nullptr);
+
+  /// Set an ObjectCache to query before compiling.
+  void setObjectCache(ObjectCache *NewCache) { ObjCache = NewCache; }
+
+  Expected<std::unique_ptr<MemoryBuffer>> operator()(Module &M);
+
+private:
+  class TargetMachinePool {
+  public:
+    TargetMachinePool(JITTargetMachineBuilder JTMB) : JTMB(std::move(JTMB)) {}
+
+    /// Take an idle TargetMachine, or create a new one if none is idle.
+    Expected<std::unique_ptr<TargetMachine>> acquire();
+
+    /// Return a TargetMachine obtained from acquire to the pool.
+    void release(std::unique_ptr<TargetMachine> TM);
+
+  private:
+    std::mutex PoolMutex;
+    JITTargetMachineBuilder JTMB;
+    std::vector<std::unique_ptr<TargetMachine>> IdleTMs;
+  };
+
+  std::shared_ptr<TargetMachinePool> Pool;
+  ObjectCache *ObjCache = nullptr;
+};
+
 } // end namespace orc
 
 } // end namespace llvm
@@ -18,7 +18,10 @@
 #include "llvm/ExecutionEngine/JITSymbol.h"
 #include "llvm/ExecutionEngine/Orc/SymbolStringPool.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/RWMutex.h"
 
+#include <array>
+#include <atomic>
 #include <list>
 #include <map>
 #include <memory>
@@ -361,7 +364,7 @@ private:
 
   mutable std::recursive_mutex SessionMutex;
   std::shared_ptr<SymbolStringPool> SSP;
-  VModuleKey LastKey = 0;
+  std::atomic<VModuleKey> LastKey{0};
   ErrorReporter ReportError = logErrorsToStdErr;
   DispatchMaterializationFunction DispatchMaterialization =
       materializeOnCurrentThread;
@@ -586,6 +589,15 @@ public:
   SymbolNameSet lookup(std::shared_ptr<AsynchronousSymbolQuery> Q,
                        SymbolNameSet Names);
 
+  /// Search the finalized symbols of this VSO for the symbols in Names,
+  /// without taking the session lock or creating a query. Found symbols are
+  /// added to Result and removed from Names.
+  ///
+  /// Finalized symbols never change, so this is safe to call concurrently
+  /// with any other VSO operation. Symbols that are not finalized yet are left
+  /// in Names even if this VSO defines them.
+  void lookupFinalized(SymbolMap &Result, SymbolNameSet &Names) const;
+
   /// Dump current VSO state to OS.
   void dump(raw_ostream &OS);
 
@@ -612,6 +624,16 @@ private:
 
   using MaterializingInfosMap = std::map<SymbolStringPtr, MaterializingInfo>;
 
+  /// A read-mostly copy of part of the finalized symbols, so that threads
+  /// looking up symbols that are ready to use don't contend on the session
+  /// lock or on each other.
+  struct FinalizedSymbolsShard {
+    mutable sys::RWMutex Mutex;
+    SymbolMap Symbols;
+  };
+
+  static const unsigned NumFinalizedSymbolsShards = 16;
+
   using LookupImplActionFlags = enum {
     None = 0,
     NotifyFullyResolved = 1 << 0U,
@@ -654,6 +676,13 @@ private:
 
   void notifyFailed(const SymbolNameSet &FailedSymbols);
 
+  void addFinalizedSymbol(const SymbolStringPtr &Name,
+                          JITEvaluatedSymbol Sym);
+
+  FinalizedSymbolsShard &getFinalizedSymbolsShard(const SymbolStringPtr &Name);
+  const FinalizedSymbolsShard &
+  getFinalizedSymbolsShard(const SymbolStringPtr &Name) const;
+
   void runOutstandingMUs();
 
   ExecutionSessionBase &ES;
@@ -662,6 +691,8 @@ private:
   UnmaterializedInfosMap UnmaterializedInfos;
   MaterializingInfosMap MaterializingInfos;
   FallbackDefinitionGeneratorFunction FallbackDefinitionGenerator;
+  std::array<FinalizedSymbolsShard, NumFinalizedSymbolsShards>
+      FinalizedSymbols;
 
   // FIXME: Remove this (and runOutstandingMUs) once the linking layer works
   //        with callbacks from asynchronous queries.
@@ -705,6 +736,9 @@ using VSOList = std::vector<VSO *>;
 /// VSOs will be searched in order and no VSO pointer may be null.
 /// All symbols must be found within the given VSOs or an error
 /// will be returned.
+///
+/// Symbols already finalized in the first VSO are returned without taking the
+/// session lock; a query is only issued for the remaining ones.
 Expected<SymbolMap> lookup(const VSOList &VSOs, SymbolNameSet Names);
 
 /// Look up a symbol by searching a list of VSOs.
@@ -21,6 +21,7 @@
 #include "llvm/ExecutionEngine/Orc/IRTransformLayer.h"
 #include "llvm/ExecutionEngine/Orc/ObjectTransformLayer.h"
 #include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Target/TargetMachine.h"
 
 namespace llvm {
@@ -34,6 +35,19 @@ public:
   Create(std::unique_ptr<ExecutionSession> ES,
          std::unique_ptr<TargetMachine> TM, DataLayout DL);
 
+  /// Create an LLJIT instance that compiles modules on NumCompileThreads
+  /// threads, each using its own TargetMachine built by JTMB. If
+  /// NumCompileThreads is zero, modules are compiled on the thread that
+  /// triggers their materialization.
+  ///
+  /// Modules that may be compiled concurrently must not share an LLVMContext.
+  static Expected<std::unique_ptr<LLJIT>>
+  Create(std::unique_ptr<ExecutionSession> ES, JITTargetMachineBuilder JTMB,
+         DataLayout DL, unsigned NumCompileThreads);
+
+  /// Waits for any in-flight compiles to finish.
+  ~LLJIT();
+
   /// Returns a reference to the ExecutionSession for this JIT instance.
   ExecutionSession &getExecutionSession() { return *ES; }
 
@@ -77,15 +91,24 @@ public:
   /// Runs all not-yet-run static destructors.
   Error runDestructors() { return DtorRunner.run(); }
 
+  /// Set an ObjectCache (e.g. a PersistentObjectCache) to query before
+  /// compiling a module. This should be called before any module is added.
+  void setObjectCache(ObjectCache *NewCache);
+
 protected:
   LLJIT(std::unique_ptr<ExecutionSession> ES, std::unique_ptr<TargetMachine> TM,
         DataLayout DL);
 
+  LLJIT(std::unique_ptr<ExecutionSession> ES, JITTargetMachineBuilder JTMB,
+        DataLayout DL, unsigned NumCompileThreads);
+
   std::shared_ptr<SymbolResolver> takeSymbolResolver(VModuleKey K);
   RTDyldObjectLinkingLayer2::Resources getRTDyldResources(VModuleKey K);
 
   std::string mangle(StringRef UnmangledName);
 
+  Expected<std::unique_ptr<MemoryBuffer>> compileModule(Module &M);
+
   std::unique_ptr<SymbolResolver> createResolverFor(VSO &V);
 
   Error applyDataLayout(Module &M);
@@ -96,6 +119,8 @@ protected:
   VSO &Main;
 
   std::unique_ptr<TargetMachine> TM;
+  std::unique_ptr<ConcurrentIRCompiler> ConcurrentCompiler;
+  ObjectCache *ObjCache = nullptr;
   DataLayout DL;
 
   std::map<VSO *, VSOList> VSOLookupOrder;
@@ -103,8 +128,11 @@ protected:
   RTDyldObjectLinkingLayer2 ObjLinkingLayer;
   IRCompileLayer2 CompileLayer;
 
+  std::mutex ResolversMutex;
   std::map<VModuleKey, std::shared_ptr<orc::SymbolResolver>> Resolvers;
   CtorDtorRunner2 CtorRunner, DtorRunner;
+
+  std::unique_ptr<ThreadPool> CompileThreads;
 };
 
 /// An extended version of LLJIT that supports lazy function-at-a-time
@@ -0,0 +1,76 @@
+//===- PersistentObjectCache.h - On-disk object cache for ORC ---*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Contains an ObjectCache that persists compiled objects in a directory, keyed
+// by a hash of the module and the target it is compiled for.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_PERSISTENTOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_PERSISTENTOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+
+class Module;
+class TargetMachine;
+
+namespace orc {
+
+/// An ObjectCache that stores compiled objects in a directory, so that they
+/// survive process restarts.
+///
+/// Objects are content addressed: the key of a module is a hash of its
+/// bitcode together with the target triple, CPU and features of the
+/// TargetMachine the cache was created for. Cached objects are memory mapped
+/// when loaded. The cache is safe to use from several compile threads, and
+/// several processes may share a cache directory.
+class PersistentObjectCache : public ObjectCache {
+public:
+  /// Create a cache for objects compiled by TM, stored in CacheDir. The
+  /// directory is created if it doesn't exist.
+  PersistentObjectCache(StringRef CacheDir, const TargetMachine &TM,
+                        CachePruningPolicy Policy = CachePruningPolicy());
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+  /// Prune the cache directory according to the pruning policy. Returns false
+  /// if the policy could not be applied.
+  bool prune();
+
+  /// Returns the path of the file caching the object for M.
+  std::string getCachePath(const Module &M);
+
+private:
+  std::string computeKey(const Module &M) const;
+  std::string getCachePathForKey(StringRef Key) const;
+
+  std::string CacheDir;
+  std::string TargetKey;
+  CachePruningPolicy Policy;
+
+  /// Keys computed by getObject for modules that missed in the cache, so
+  /// notifyObjectCompiled doesn't hash them again.
+  std::mutex PendingKeysMutex;
+  DenseMap<const Module *, std::string> PendingKeys;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_PERSISTENTOBJECTCACHE_H
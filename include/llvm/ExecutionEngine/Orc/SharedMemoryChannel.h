@@ -0,0 +1,99 @@
+//===- SharedMemoryChannel.h - RPC channel over shared memory ---*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// A RawByteChannel connecting two local processes through a pair of ring
+// buffers in a shared memory object.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_SHAREDMEMORYCHANNEL_H
+#define LLVM_EXECUTIONENGINE_ORC_SHAREDMEMORYCHANNEL_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ExecutionEngine/Orc/RawByteChannel.h"
+#include "llvm/Support/Error.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace llvm {
+namespace orc {
+namespace rpc {
+
+/// RPC channel that exchanges bytes with another process through two
+/// single-producer single-consumer ring buffers, one per direction, living in
+/// a named POSIX shared memory object.
+///
+/// Compared to a pipe, the bytes of a message are copied once into the ring
+/// by the sender and once out of it by the receiver, without system calls on
+/// the way: the code and data written by OrcRemoteTargetClient::writeMem go
+/// from the client's buffer through the ring straight into the executor's
+/// allocation. A reader waiting for data, or a writer waiting for room in the
+/// ring, spins briefly and then backs off to yielding and sleeping.
+///
+/// One process creates the channel with create() and passes its name to the
+/// other, which connects with open(). Destroying either end closes the
+/// channel: the peer then fails with ConnectionClosed once it has read the
+/// bytes already sent. The shared memory object is unlinked when the end that
+/// created it is destroyed.
+///
+/// Only supported on Unix hosts.
+class SharedMemoryChannel final : public RawByteChannel {
+public:
+  static const size_t DefaultRingSize = 1024 * 1024;
+
+  /// Creates the shared memory object \p Name, which must start with a '/',
+  /// with rings of \p RingSize bytes. \p RingSize is rounded up to a power of
+  /// two.
+  static Expected<std::unique_ptr<SharedMemoryChannel>>
+  create(StringRef Name, size_t RingSize = DefaultRingSize);
+
+  /// Connects to the channel created as \p Name by another process.
+  static Expected<std::unique_ptr<SharedMemoryChannel>> open(StringRef Name);
+
+  SharedMemoryChannel(const SharedMemoryChannel &) = delete;
+  SharedMemoryChannel &operator=(const SharedMemoryChannel &) = delete;
+
+  ~SharedMemoryChannel() override;
+
+  Error readBytes(char *Dst, unsigned Size) override;
+  Error appendBytes(const char *Src, unsigned Size) override;
+  Error send() override;
+
+  /// Returns the name of the shared memory object.
+  StringRef getName() const { return Name; }
+
+private:
+  struct Ring;
+
+  SharedMemoryChannel(std::string Name, bool Owner, void *Mapping,
+                      size_t MappingSize);
+
+  static size_t getDataOffset();
+  void publish();
+
+  std::string Name;
+  bool Owner;
+  void *Mapping;
+  size_t MappingSize;
+  uint64_t RingSize = 0;
+  Ring *In = nullptr, *Out = nullptr;
+  char *InData = nullptr, *OutData = nullptr;
+  /// The write position of the bytes appended by this end.
+  uint64_t PendingTail = 0;
+  /// The last read position of the peer seen by this end.
+  uint64_t CachedHead = 0;
+};
+
+} // end namespace rpc
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_SHAREDMEMORYCHANNEL_H
@@ -14,6 +14,7 @@
 #ifndef LLVM_EXECUTIONENGINE_ORC_SYMBOLSTRINGPOOL_H
 #define LLVM_EXECUTIONENGINE_ORC_SYMBOLSTRINGPOOL_H
 
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/StringMap.h"
 #include <atomic>
 #include <mutex>
@@ -52,6 +53,7 @@ class SymbolStringPtr {
   friend bool operator==(const SymbolStringPtr &LHS,
                          const SymbolStringPtr &RHS);
   friend bool operator<(const SymbolStringPtr &LHS, const SymbolStringPtr &RHS);
+  friend hash_code hash_value(const SymbolStringPtr &S);
 
 public:
   SymbolStringPtr() = default;
@@ -112,6 +114,10 @@ inline bool operator<(const SymbolStringPtr &LHS, const SymbolStringPtr &RHS) {
   return LHS.S < RHS.S;
 }
 
+inline hash_code hash_value(const SymbolStringPtr &S) {
+  return hash_value(S.S);
+}
+
 inline SymbolStringPool::~SymbolStringPool() {
 #ifndef NDEBUG
   clearDeadEntries();
@@ -230,6 +230,19 @@ public:
     this->ProcessAllSections = ProcessAllSections;
   }
 
+  /// Passing 'true' to this method allows RuntimeDyld to apply the relocations
+  /// of the sections of an object on multiple threads once the addresses of
+  /// their symbols are known, for the object formats and targets where the
+  /// relocations are independent of each other. This speeds up loading large
+  /// objects. Defaults to 'false'.
+  ///
+  /// Must be called before the first object file is loaded.
+  void setResolveRelocationsInParallel(bool ResolveRelocationsInParallel) {
+    assert(!Dyld && "setResolveRelocationsInParallel must be called before "
+                    "loadObject.");
+    this->ResolveRelocationsInParallel = ResolveRelocationsInParallel;
+  }
+
   /// Perform all actions needed to make the code owned by this RuntimeDyld
   /// instance executable:
   ///
@@ -256,6 +269,7 @@ private:
   MemoryManager &MemMgr;
   JITSymbolResolver &Resolver;
   bool ProcessAllSections;
+  bool ResolveRelocationsInParallel;
   RuntimeDyldCheckerImpl *Checker;
 };
 
@@ -0,0 +1,100 @@
+//===- SlabMemoryMapper.h - Slab allocator for JIT memory -------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares a SectionMemoryManager::MemoryMapper that carves the
+// memory of many JITed objects out of large shared slabs.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_SLABMEMORYMAPPER_H
+#define LLVM_EXECUTIONENGINE_SLABMEMORYMAPPER_H
+
+#include "llvm/ExecutionEngine/SectionMemoryManager.h"
+#include "llvm/Support/Memory.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <vector>
+
+namespace llvm {
+
+/// A memory mapper that packs the allocations of many SectionMemoryManager
+/// instances into a few large slabs, one set of slabs per allocation purpose.
+///
+/// JITing many small modules with the default mapper gives every object its
+/// own pages for code, read-only and read-write data, which scatters the code
+/// over the address space and costs one mapping per section group. Sharing one
+/// SlabMemoryMapper between the memory managers of all objects keeps the code
+/// of the objects next to each other, so that it can be backed by huge pages
+/// and spans few TLB entries. Memory released by a memory manager is returned
+/// to its slab and reused; a slab whose memory has all been released is
+/// unmapped, except for the last one of each purpose.
+///
+/// Requests larger than a slab are mapped directly. The mapper is thread safe.
+class SlabMemoryMapper final : public SectionMemoryManager::MemoryMapper {
+public:
+  using AllocationPurpose = SectionMemoryManager::AllocationPurpose;
+
+  static const size_t DefaultSlabSize = 2 * 1024 * 1024;
+
+  /// Creates a mapper that maps slabs of \p SlabSize bytes, rounded up to the
+  /// page size. If \p UseHugePages is set, the slabs are requested with
+  /// sys::Memory::MF_HUGE_HINT.
+  explicit SlabMemoryMapper(size_t SlabSize = DefaultSlabSize,
+                            bool UseHugePages = false);
+  SlabMemoryMapper(const SlabMemoryMapper &) = delete;
+  void operator=(const SlabMemoryMapper &) = delete;
+
+  /// Unmaps all slabs. Memory managers using this mapper must be destroyed
+  /// first.
+  ~SlabMemoryMapper() override;
+
+  sys::MemoryBlock allocateMappedMemory(AllocationPurpose Purpose,
+                                        size_t NumBytes,
+                                        const sys::MemoryBlock *const NearBlock,
+                                        unsigned Flags,
+                                        std::error_code &EC) override;
+
+  std::error_code protectMappedMemory(const sys::MemoryBlock &Block,
+                                      unsigned Flags) override;
+
+  std::error_code releaseMappedMemory(sys::MemoryBlock &M) override;
+
+  /// Returns the number of slabs currently mapped.
+  size_t getNumSlabs() const;
+
+private:
+  struct Slab {
+    sys::MemoryBlock Mem;
+    AllocationPurpose Purpose;
+    /// The free ranges of the slab, as a map from start address to size.
+    /// Adjacent ranges are always coalesced.
+    std::map<uintptr_t, size_t> FreeRanges;
+    size_t FreeBytes;
+  };
+
+  sys::MemoryBlock allocateFromSlab(Slab &S, size_t NumBytes);
+  void returnToSlab(Slab &S, const sys::MemoryBlock &M);
+  Slab *getSlabContaining(const void *Addr);
+  Slab *mapSlab(AllocationPurpose Purpose, std::error_code &EC);
+  std::error_code unmapSlab(Slab &S);
+
+  const size_t SlabSize;
+  const bool UseHugePages;
+  mutable std::mutex SlabsMutex;
+  /// The mapped slabs, keyed by their start address.
+  std::map<uintptr_t, std::unique_ptr<Slab>> Slabs;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_SLABMEMORYMAPPER_H
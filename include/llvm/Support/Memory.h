@@ -48,7 +48,11 @@ namespace sys {
     enum ProtectionFlags {
       MF_READ  = 0x1000000,
       MF_WRITE = 0x2000000,
-      MF_EXEC  = 0x4000000
+      MF_EXEC  = 0x4000000,
+
+      /// Hint to allocateMappedMemory that the block should be backed by huge
+      /// pages where the system supports it. Ignored by the other methods.
+      MF_HUGE_HINT = 0x0000001
     };
 
     /// This method allocates a block of memory that is suitable for loading
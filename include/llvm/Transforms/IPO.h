@@ -215,6 +215,10 @@ ModulePass *createBarrierNoopPass();
 /// indicating the set of functions they may target at run-time.
 ModulePass *createCalledValuePropagationPass();
 
+/// createFunctionSpecializationPass - Clone functions for call sites passing
+/// constant integer or function pointer arguments.
+ModulePass *createFunctionSpecializationPass();
+
 /// What to do with the summary when running passes that operate on it.
 enum class PassSummaryAction {
   None,   ///< Do nothing.
@@ -256,6 +260,10 @@ createWholeProgramDevirtPass(ModuleSummaryIndex *ExportSummary,
 /// devirtualization and control-flow integrity.
 ModulePass *createGlobalSplitPass();
 
+/// createHotColdSplittingPass - This pass outlines cold blocks into separate
+/// functions placed in the .text.unlikely section.
+ModulePass *createHotColdSplittingPass();
+
 //===----------------------------------------------------------------------===//
 // SampleProfilePass - Loads sample profile data from disk and generates
 // IR metadata to reflect the profile.
@@ -0,0 +1,37 @@
+//===- FunctionSpecialization.h - Specialize functions ----------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This pass clones functions for call sites passing constant integer or
+// function pointer arguments, and redirects those call sites to the clones.
+// Within a clone the specialized arguments are replaced by the constants, so
+// indirect calls through function pointer arguments (e.g. comparator callbacks
+// passed to qsort-like routines) become direct calls. The size of each clone is
+// bounded using the inline cost analysis.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TRANSFORMS_IPO_FUNCTIONSPECIALIZATION_H
+#define LLVM_TRANSFORMS_IPO_FUNCTIONSPECIALIZATION_H
+
+#include "llvm/IR/PassManager.h"
+
+namespace llvm {
+
+class Module;
+
+/// Pass to clone functions for constant arguments.
+class FunctionSpecializationPass
+    : public PassInfoMixin<FunctionSpecializationPass> {
+public:
+  PreservedAnalyses run(Module &M, ModuleAnalysisManager &AM);
+};
+
+} // end namespace llvm
+
+#endif // LLVM_TRANSFORMS_IPO_FUNCTIONSPECIALIZATION_H
@@ -530,6 +530,14 @@ int TargetTransformInfo::getMinMaxReductionCost(Type *Ty, Type *CondTy,
   return Cost;
 }
 
+int TargetTransformInfo::getExtendedAddReductionCost(
+    bool IsUnsigned, Type *ResTy, Type *Ty, bool IsPairwiseForm) const {
+  int Cost = TTIImpl->getExtendedAddReductionCost(IsUnsigned, ResTy, Ty,
+                                                  IsPairwiseForm);
+  assert(Cost >= 0 && "TTI should not produce negative costs!");
+  return Cost;
+}
+
 unsigned
 TargetTransformInfo::getCostOfKeepingLiveOverCall(ArrayRef<Type *> Tys) const {
   return TTIImpl->getCostOfKeepingLiveOverCall(Tys);
@@ -57,8 +57,11 @@
 //===----------------------------------------------------------------------===//
 #include "llvm/CodeGen/MachineOutliner.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/Twine.h"
+#include "llvm/Analysis/BlockFrequencyInfo.h"
+#include "llvm/Analysis/ProfileSummaryInfo.h"
 #include "llvm/CodeGen/MachineFunction.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
 #include "llvm/CodeGen/MachineOptimizationRemarkEmitter.h"
@@ -99,6 +102,13 @@ static cl::opt<bool> EnableLinkOnceODROutlining(
     cl::desc("Enable the machine outliner on linkonceodr functions"),
     cl::init(false));
 
+// When the module has a profile, don't outline from hot blocks, where the
+// calls to the outlined functions would cost run time.
+static cl::opt<bool> OutlinerSkipHotBlocks(
+    "outliner-skip-hot-blocks", cl::Hidden,
+    cl::desc("Don't outline from blocks the profile deems hot"),
+    cl::init(true));
+
 namespace {
 
 /// Represents an undefined index in the suffix tree.
@@ -697,11 +707,17 @@ struct MachineOutliner : public ModulePass {
   // Collection of IR functions created by the outliner.
   std::vector<Function *> CreatedIRFunctions;
 
+  /// Blocks with profile data that are neither hot nor cold. Calls from these
+  /// blocks are weighed more heavily in the cost model.
+  SmallPtrSet<const MachineBasicBlock *, 32> WarmMBBs;
+
   StringRef getPassName() const override { return "Machine Outliner"; }
 
   void getAnalysisUsage(AnalysisUsage &AU) const override {
     AU.addRequired<MachineModuleInfo>();
     AU.addPreserved<MachineModuleInfo>();
+    AU.addRequired<ProfileSummaryInfoWrapperPass>();
+    AU.addRequired<BlockFrequencyInfoWrapperPass>();
     AU.setPreservesAll();
     ModulePass::getAnalysisUsage(AU);
   }
@@ -820,8 +836,12 @@ ModulePass *createMachineOutlinerPass(bool RunOnAllFunctions) {
 
 } // namespace llvm
 
-INITIALIZE_PASS(MachineOutliner, DEBUG_TYPE, "Machine Function Outliner", false,
-                false)
+INITIALIZE_PASS_BEGIN(MachineOutliner, DEBUG_TYPE, "Machine Function Outliner",
+                      false, false)
+INITIALIZE_PASS_DEPENDENCY(BlockFrequencyInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(ProfileSummaryInfoWrapperPass)
+INITIALIZE_PASS_END(MachineOutliner, DEBUG_TYPE, "Machine Function Outliner",
+                    false, false)
 
 unsigned MachineOutliner::findCandidates(
     SuffixTree &ST, const TargetInstrInfo &TII, InstructionMapper &Mapper,
@@ -913,6 +933,15 @@ unsigned MachineOutliner::findCandidates(
     // to outline.
     TargetCostInfo TCI =
         TII.getOutlininingCandidateInfo(CandidatesForRepeatedSeq);
+
+    // Calls from warm blocks cost run time on top of their size. Count their
+    // call overhead twice.
+    unsigned NumWarm = std::count_if(
+        CandidatesForRepeatedSeq.begin(), CandidatesForRepeatedSeq.end(),
+        [this](const Candidate &C) { return WarmMBBs.count(C.getMBB()); });
+    if (NumWarm)
+      TCI.CallOverhead += divideCeil(TCI.CallOverhead * NumWarm,
+                                     CandidatesForRepeatedSeq.size());
     std::vector<unsigned> Seq;
     for (unsigned i = Leaf->SuffixIdx; i < Leaf->SuffixIdx + StringLen; i++)
       Seq.push_back(ST.Str[i]);
@@ -1357,6 +1386,11 @@ bool MachineOutliner::runOnModule(Module &M) {
   // it here.
   OutlineFromLinkOnceODRs = EnableLinkOnceODROutlining;
 
+  ProfileSummaryInfo *PSI =
+      getAnalysis<ProfileSummaryInfoWrapperPass>().getPSI();
+  bool UseProfile = OutlinerSkipHotBlocks && PSI->hasProfileSummary();
+  WarmMBBs.clear();
+
   InstructionMapper Mapper;
 
   // Build instruction mappings for each function in the module. Start by
@@ -1385,6 +1419,10 @@ bool MachineOutliner::runOnModule(Module &M) {
     if (!TII->isFunctionSafeToOutlineFrom(*MF, OutlineFromLinkOnceODRs))
       continue;
 
+    BlockFrequencyInfo *BFI = nullptr;
+    if (UseProfile && F.getEntryCount())
+      BFI = &getAnalysis<BlockFrequencyInfoWrapperPass>(F).getBFI();
+
     // We have a function suitable for outlining. Iterate over every
     // MachineBasicBlock in MF and try to map its instructions to a list of
     // unsigned integers.
@@ -1399,6 +1437,16 @@ bool MachineOutliner::runOnModule(Module &M) {
       if (MBB.hasAddressTaken())
         continue;
 
+      // Don't outline from hot blocks. Blocks created during code generation
+      // have no profile, so treat them as hot too.
+      if (BFI) {
+        const BasicBlock *BB = MBB.getBasicBlock();
+        if (!BB || PSI->isHotBB(BB, BFI))
+          continue;
+        if (!PSI->isColdBB(BB, BFI))
+          WarmMBBs.insert(&MBB);
+      }
+
       // MBB is suitable for outlining. Map it to a list of unsigneds.
       Mapper.convertToUnsignedVec(MBB, *TRI, *TII);
     }
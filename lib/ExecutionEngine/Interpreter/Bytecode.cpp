@@ -0,0 +1,933 @@
+//===-- Bytecode.cpp - Register-slot bytecode for the interpreter ---------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file lowers functions to the register-slot bytecode of the interpreter
+// fast path, and contains the threaded dispatch loop that executes it.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Bytecode.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DataLayout.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GetElementPtrTypeIterator.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/MathExtras.h"
+#include <cmath>
+#include <cstring>
+using namespace llvm;
+
+// Dispatch through computed gotos where the compiler supports them, and
+// through a switch otherwise.
+#if defined(__GNUC__)
+#define BYTECODE_THREADED 1
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+#define BYTECODE_OPS(X)                                                        \
+  X(Move) X(Add) X(Sub) X(Mul) X(UDiv) X(SDiv) X(URem) X(SRem) X(Shl) X(LShr)  \
+  X(AShr) X(And) X(Or) X(Xor) X(FAdd) X(FSub) X(FMul) X(FDiv) X(FRem)         \
+  X(ICmpEQ) X(ICmpNE) X(ICmpUGT) X(ICmpUGE) X(ICmpULT) X(ICmpULE) X(ICmpSGT)   \
+  X(ICmpSGE) X(ICmpSLT) X(ICmpSLE) X(FCmp) X(Trunc) X(SExt) X(FPTrunc)         \
+  X(FPToUI) X(FPToSI) X(UIToFP) X(SIToFP) X(FPToBits) X(BitsToFP) X(Select)    \
+  X(Load) X(LoadFloat) X(LoadDouble) X(Store) X(StoreFloat) X(StoreDouble)     \
+  X(AddImm) X(GEPIndex) X(Alloca) X(Br) X(CondBr) X(Switch) X(Ret) X(RetVoid)  \
+  X(Call) X(Unreachable)
+
+namespace {
+
+enum Opcode : unsigned {
+#define BYTECODE_ENUM(Name) BC_##Name,
+  BYTECODE_OPS(BYTECODE_ENUM)
+#undef BYTECODE_ENUM
+};
+
+} // end anonymous namespace
+
+static bool isSupportedType(Type *Ty) {
+  if (auto *ITy = dyn_cast<IntegerType>(Ty))
+    return ITy->getBitWidth() <= 64;
+  return Ty->isFloatTy() || Ty->isDoubleTy() || Ty->isPointerTy();
+}
+
+/// Returns the number of bits of the slot representation of \p Ty.
+static unsigned getSlotBits(Type *Ty) {
+  if (auto *ITy = dyn_cast<IntegerType>(Ty))
+    return ITy->getBitWidth();
+  return Ty->isFloatTy() ? 32 : 64;
+}
+
+static BytecodeFunction::Slot toSlot(const GenericValue &GV, Type *Ty) {
+  BytecodeFunction::Slot S;
+  if (Ty->isIntegerTy())
+    S.I = GV.IntVal.getZExtValue();
+  else if (Ty->isFloatTy())
+    S.F = GV.FloatVal;
+  else if (Ty->isDoubleTy())
+    S.F = GV.DoubleVal;
+  else
+    S.I = (uintptr_t)GV.PointerVal;
+  return S;
+}
+
+static GenericValue toGenericValue(BytecodeFunction::Slot S, Type *Ty) {
+  GenericValue GV;
+  if (Ty->isIntegerTy())
+    GV.IntVal = APInt(Ty->getIntegerBitWidth(), S.I);
+  else if (Ty->isFloatTy())
+    GV.FloatVal = (float)S.F;
+  else if (Ty->isDoubleTy())
+    GV.DoubleVal = S.F;
+  else if (Ty->isPointerTy())
+    GV.PointerVal = (void *)(uintptr_t)S.I;
+  return GV;
+}
+
+static bool evaluateFCmp(unsigned Pred, double A, double B) {
+  bool Unordered = std::isnan(A) || std::isnan(B);
+  switch (Pred) {
+  case FCmpInst::FCMP_FALSE: return false;
+  case FCmpInst::FCMP_OEQ:   return !Unordered && A == B;
+  case FCmpInst::FCMP_OGT:   return !Unordered && A > B;
+  case FCmpInst::FCMP_OGE:   return !Unordered && A >= B;
+  case FCmpInst::FCMP_OLT:   return !Unordered && A < B;
+  case FCmpInst::FCMP_OLE:   return !Unordered && A <= B;
+  case FCmpInst::FCMP_ONE:   return !Unordered && A != B;
+  case FCmpInst::FCMP_ORD:   return !Unordered;
+  case FCmpInst::FCMP_UNO:   return Unordered;
+  case FCmpInst::FCMP_UEQ:   return Unordered || A == B;
+  case FCmpInst::FCMP_UGT:   return Unordered || A > B;
+  case FCmpInst::FCMP_UGE:   return Unordered || A >= B;
+  case FCmpInst::FCMP_ULT:   return Unordered || A < B;
+  case FCmpInst::FCMP_ULE:   return Unordered || A <= B;
+  case FCmpInst::FCMP_UNE:   return Unordered || A != B;
+  case FCmpInst::FCMP_TRUE:  return true;
+  default:
+    llvm_unreachable("Invalid FCmp predicate");
+  }
+}
+
+namespace llvm {
+
+/// Lowers one function to bytecode. The slots of the frame are laid out as
+/// the arguments, then the instructions, then the constants, and finally the
+/// scratch slots used by the parallel PHI moves.
+class BytecodeCompiler {
+public:
+  BytecodeCompiler(Function &F, const DataLayout &DL,
+                   function_ref<GenericValue(Constant *)> GetConstantValue,
+                   SmallVectorImpl<Function *> &Callees)
+      : F(F), DL(DL), GetConstantValue(GetConstantValue), Callees(Callees),
+        BF(new BytecodeFunction()) {}
+
+  std::unique_ptr<BytecodeFunction> compile();
+
+private:
+  bool emitInstruction(Instruction &I);
+  bool emitBinaryOperator(BinaryOperator &I);
+  bool emitCast(CastInst &I);
+  bool emitGEP(GetElementPtrInst &I);
+  bool emitCall(CallInst &I);
+  uint32_t getEdge(BasicBlock *From, BasicBlock *To);
+  bool getSlot(Value *V, uint32_t &Slot);
+
+  BytecodeFunction::Inst &emit(unsigned Op, uint32_t Dst = 0, uint32_t A = 0,
+                               uint32_t B = 0, uint32_t C = 0,
+                               uint64_t Imm = 0, unsigned Bits = 0) {
+    BytecodeFunction::Inst I;
+    I.Op = Op;
+    I.Dst = Dst;
+    I.A = A;
+    I.B = B;
+    I.C = C;
+    I.Imm = Imm;
+    I.Bits = Bits;
+    BF->Code.push_back(I);
+    return BF->Code.back();
+  }
+
+  Function &F;
+  const DataLayout &DL;
+  function_ref<GenericValue(Constant *)> GetConstantValue;
+  SmallVectorImpl<Function *> &Callees;
+  std::unique_ptr<BytecodeFunction> BF;
+
+  DenseMap<Value *, uint32_t> Slots;
+  DenseMap<Constant *, uint32_t> ConstantIndices;
+  uint32_t FirstConstantSlot = 0;
+  DenseMap<BasicBlock *, uint32_t> BlockStarts;
+  /// The target blocks of the edges, patched with their start once all the
+  /// blocks have been emitted.
+  std::vector<BasicBlock *> EdgeTargets;
+};
+
+} // End llvm namespace
+
+bool BytecodeCompiler::getSlot(Value *V, uint32_t &Slot) {
+  auto It = Slots.find(V);
+  if (It != Slots.end()) {
+    Slot = It->second;
+    return true;
+  }
+
+  auto *C = dyn_cast<Constant>(V);
+  if (!C || !isSupportedType(C->getType()))
+    return false;
+  // Constant expressions are folded by the execution engine, which only
+  // handles some of them.
+  if (auto *CE = dyn_cast<ConstantExpr>(C)) {
+    if (!CE->isCast() && CE->getOpcode() != Instruction::GetElementPtr)
+      return false;
+  } else if (!isa<ConstantInt>(C) && !isa<ConstantFP>(C) &&
+             !isa<ConstantPointerNull>(C) && !isa<UndefValue>(C) &&
+             !isa<GlobalValue>(C)) {
+    return false;
+  }
+
+  auto Inserted = ConstantIndices.insert({C, BF->Constants.size()});
+  if (Inserted.second) {
+    BytecodeFunction::Slot Value;
+    Value.I = 0;
+    if (!isa<UndefValue>(C))
+      Value = toSlot(GetConstantValue(C), C->getType());
+    BF->Constants.push_back(Value);
+  }
+  Slot = FirstConstantSlot + Inserted.first->second;
+  return true;
+}
+
+uint32_t BytecodeCompiler::getEdge(BasicBlock *From, BasicBlock *To) {
+  BytecodeFunction::Edge E;
+  E.Target = 0;
+  E.MovesBegin = BF->Moves.size();
+  for (PHINode &PN : To->phis()) {
+    uint32_t Dst = Slots[&PN], Src;
+    if (!getSlot(PN.getIncomingValueForBlock(From), Src))
+      return ~0U;
+    BF->Moves.push_back({Dst, Src});
+  }
+  E.MovesEnd = BF->Moves.size();
+  BF->MaxMoves = std::max(BF->MaxMoves, E.MovesEnd - E.MovesBegin);
+  BF->Edges.push_back(E);
+  EdgeTargets.push_back(To);
+  return BF->Edges.size() - 1;
+}
+
+bool BytecodeCompiler::emitBinaryOperator(BinaryOperator &I) {
+  uint32_t A, B;
+  if (!getSlot(I.getOperand(0), A) || !getSlot(I.getOperand(1), B))
+    return false;
+  uint32_t Dst = Slots[&I];
+  unsigned Bits = getSlotBits(I.getType());
+
+  if (I.getType()->isFloatingPointTy()) {
+    unsigned Op;
+    switch (I.getOpcode()) {
+    case Instruction::FAdd: Op = BC_FAdd; break;
+    case Instruction::FSub: Op = BC_FSub; break;
+    case Instruction::FMul: Op = BC_FMul; break;
+    case Instruction::FDiv: Op = BC_FDiv; break;
+    case Instruction::FRem: Op = BC_FRem; break;
+    default:
+      return false;
+    }
+    emit(Op, Dst, A, B, 0, 0, Bits);
+    return true;
+  }
+
+  unsigned Op;
+  uint32_t C = 0;
+  switch (I.getOpcode()) {
+  case Instruction::Add:  Op = BC_Add;  break;
+  case Instruction::Sub:  Op = BC_Sub;  break;
+  case Instruction::Mul:  Op = BC_Mul;  break;
+  case Instruction::UDiv: Op = BC_UDiv; break;
+  case Instruction::SDiv: Op = BC_SDiv; break;
+  case Instruction::URem: Op = BC_URem; break;
+  case Instruction::SRem: Op = BC_SRem; break;
+  case Instruction::And:  Op = BC_And;  break;
+  case Instruction::Or:   Op = BC_Or;   break;
+  case Instruction::Xor:  Op = BC_Xor;  break;
+  case Instruction::Shl:
+  case Instruction::LShr:
+  case Instruction::AShr:
+    Op = I.getOpcode() == Instruction::Shl
+             ? BC_Shl
+             : I.getOpcode() == Instruction::LShr ? BC_LShr : BC_AShr;
+    // Out of range shift amounts are masked like the generic path does.
+    C = NextPowerOf2(Bits - 1) - 1;
+    break;
+  default:
+    return false;
+  }
+  emit(Op, Dst, A, B, C, maskTrailingOnes<uint64_t>(Bits), Bits);
+  return true;
+}
+
+bool BytecodeCompiler::emitCast(CastInst &I) {
+  uint32_t A;
+  if (!getSlot(I.getOperand(0), A))
+    return false;
+  uint32_t Dst = Slots[&I];
+  Type *SrcTy = I.getSrcTy(), *DstTy = I.getDestTy();
+  unsigned SrcBits = getSlotBits(SrcTy), DstBits = getSlotBits(DstTy);
+  uint64_t Mask = maskTrailingOnes<uint64_t>(DstBits);
+
+  switch (I.getOpcode()) {
+  case Instruction::ZExt:
+  case Instruction::FPExt:
+  case Instruction::IntToPtr:
+    emit(BC_Move, Dst, A);
+    return true;
+  case Instruction::Trunc:
+  case Instruction::PtrToInt:
+    emit(BC_Trunc, Dst, A, 0, 0, Mask);
+    return true;
+  case Instruction::SExt:
+    emit(BC_SExt, Dst, A, 0, SrcBits, Mask);
+    return true;
+  case Instruction::FPTrunc:
+    emit(BC_FPTrunc, Dst, A);
+    return true;
+  case Instruction::FPToUI:
+    emit(BC_FPToUI, Dst, A, 0, 0, Mask);
+    return true;
+  case Instruction::FPToSI:
+    emit(BC_FPToSI, Dst, A, 0, 0, Mask);
+    return true;
+  case Instruction::UIToFP:
+    emit(BC_UIToFP, Dst, A, 0, SrcBits, 0, DstBits);
+    return true;
+  case Instruction::SIToFP:
+    emit(BC_SIToFP, Dst, A, 0, SrcBits, 0, DstBits);
+    return true;
+  case Instruction::BitCast:
+    if (SrcTy->isFloatingPointTy() == DstTy->isFloatingPointTy())
+      emit(BC_Move, Dst, A);
+    else if (SrcTy->isFloatingPointTy())
+      emit(BC_FPToBits, Dst, A, 0, 0, 0, SrcBits);
+    else
+      emit(BC_BitsToFP, Dst, A, 0, 0, 0, DstBits);
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool BytecodeCompiler::emitGEP(GetElementPtrInst &I) {
+  uint32_t Base;
+  if (!getSlot(I.getPointerOperand(), Base))
+    return false;
+  uint32_t Dst = Slots[&I];
+
+  // Fold the constant indices into one offset, and scale the others at run
+  // time.
+  int64_t Offset = 0;
+  SmallVector<BytecodeFunction::Inst, 4> Indices;
+  for (gep_type_iterator GTI = gep_type_begin(I), E = gep_type_end(I);
+       GTI != E; ++GTI) {
+    Value *Idx = GTI.getOperand();
+    if (StructType *STy = GTI.getStructTypeOrNull()) {
+      unsigned Field = cast<ConstantInt>(Idx)->getZExtValue();
+      Offset += DL.getStructLayout(STy)->getElementOffset(Field);
+      continue;
+    }
+    int64_t Scale = DL.getTypeAllocSize(GTI.getIndexedType());
+    if (auto *CI = dyn_cast<ConstantInt>(Idx)) {
+      if (CI->getBitWidth() > 64)
+        return false;
+      Offset += CI->getSExtValue() * Scale;
+      continue;
+    }
+    uint32_t IdxSlot;
+    if (!isSupportedType(Idx->getType()) || !Idx->getType()->isIntegerTy() ||
+        !getSlot(Idx, IdxSlot))
+      return false;
+    BytecodeFunction::Inst Inst;
+    Inst.Op = BC_GEPIndex;
+    Inst.Dst = Dst;
+    Inst.A = Dst;
+    Inst.B = IdxSlot;
+    Inst.C = 0;
+    Inst.Imm = Scale;
+    Inst.Bits = Idx->getType()->getIntegerBitWidth();
+    Indices.push_back(Inst);
+  }
+
+  emit(BC_AddImm, Dst, Base, 0, 0, Offset);
+  BF->Code.insert(BF->Code.end(), Indices.begin(), Indices.end());
+  return true;
+}
+
+bool BytecodeCompiler::emitCall(CallInst &I) {
+  if (auto *II = dyn_cast<IntrinsicInst>(&I)) {
+    switch (II->getIntrinsicID()) {
+    case Intrinsic::dbg_declare:
+    case Intrinsic::dbg_value:
+    case Intrinsic::dbg_label:
+    case Intrinsic::lifetime_start:
+    case Intrinsic::lifetime_end:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  Function *Callee = I.getCalledFunction();
+  if (!Callee || Callee->isDeclaration() || Callee->isVarArg() ||
+      Callee->getFunctionType() != I.getFunctionType())
+    return false;
+
+  BytecodeFunction::CallInfo CS;
+  CS.Callee = Callee;
+  CS.Code = nullptr;
+  CS.ArgsBegin = BF->CallArgs.size();
+  CS.NumArgs = I.getNumArgOperands();
+  for (Value *Arg : I.arg_operands()) {
+    uint32_t Slot;
+    if (!getSlot(Arg, Slot))
+      return false;
+    BF->CallArgs.push_back(Slot);
+  }
+  BF->Calls.push_back(CS);
+  Callees.push_back(Callee);
+
+  uint32_t Dst = I.getType()->isVoidTy() ? 0 : Slots[&I];
+  emit(BC_Call, Dst, BF->Calls.size() - 1);
+  return true;
+}
+
+bool BytecodeCompiler::emitInstruction(Instruction &I) {
+  if (!I.getType()->isVoidTy() && !isSupportedType(I.getType()))
+    return false;
+
+  if (auto *BO = dyn_cast<BinaryOperator>(&I))
+    return emitBinaryOperator(*BO);
+  if (auto *CI = dyn_cast<CastInst>(&I))
+    return emitCast(*CI);
+
+  switch (I.getOpcode()) {
+  case Instruction::PHI:
+    // Lowered to moves on the incoming edges.
+    return true;
+
+  case Instruction::ICmp: {
+    auto &Cmp = cast<ICmpInst>(I);
+    uint32_t A, B;
+    if (!isSupportedType(Cmp.getOperand(0)->getType()) ||
+        !getSlot(Cmp.getOperand(0), A) || !getSlot(Cmp.getOperand(1), B))
+      return false;
+    unsigned Op;
+    switch (Cmp.getPredicate()) {
+    case ICmpInst::ICMP_EQ:  Op = BC_ICmpEQ;  break;
+    case ICmpInst::ICMP_NE:  Op = BC_ICmpNE;  break;
+    case ICmpInst::ICMP_UGT: Op = BC_ICmpUGT; break;
+    case ICmpInst::ICMP_UGE: Op = BC_ICmpUGE; break;
+    case ICmpInst::ICMP_ULT: Op = BC_ICmpULT; break;
+    case ICmpInst::ICMP_ULE: Op = BC_ICmpULE; break;
+    case ICmpInst::ICMP_SGT: Op = BC_ICmpSGT; break;
+    case ICmpInst::ICMP_SGE: Op = BC_ICmpSGE; break;
+    case ICmpInst::ICMP_SLT: Op = BC_ICmpSLT; break;
+    case ICmpInst::ICMP_SLE: Op = BC_ICmpSLE; break;
+    default:
+      return false;
+    }
+    emit(Op, Slots[&I], A, B, 0, 0, getSlotBits(Cmp.getOperand(0)->getType()));
+    return true;
+  }
+
+  case Instruction::FCmp: {
+    auto &Cmp = cast<FCmpInst>(I);
+    uint32_t A, B;
+    if (!isSupportedType(Cmp.getOperand(0)->getType()) ||
+        !getSlot(Cmp.getOperand(0), A) || !getSlot(Cmp.getOperand(1), B))
+      return false;
+    emit(BC_FCmp, Slots[&I], A, B, Cmp.getPredicate());
+    return true;
+  }
+
+  case Instruction::Select: {
+    auto &Sel = cast<SelectInst>(I);
+    uint32_t Cond, A, B;
+    if (!Sel.getCondition()->getType()->isIntegerTy(1) ||
+        !getSlot(Sel.getCondition(), Cond) ||
+        !getSlot(Sel.getTrueValue(), A) || !getSlot(Sel.getFalseValue(), B))
+      return false;
+    emit(BC_Select, Slots[&I], A, B, Cond);
+    return true;
+  }
+
+  case Instruction::Load: {
+    auto &LI = cast<LoadInst>(I);
+    uint32_t Ptr;
+    if (!LI.isSimple() || !getSlot(LI.getPointerOperand(), Ptr))
+      return false;
+    Type *Ty = LI.getType();
+    if (Ty->isFloatTy())
+      emit(BC_LoadFloat, Slots[&I], Ptr);
+    else if (Ty->isDoubleTy())
+      emit(BC_LoadDouble, Slots[&I], Ptr);
+    else
+      emit(BC_Load, Slots[&I], Ptr, 0, DL.getTypeStoreSize(Ty),
+           maskTrailingOnes<uint64_t>(getSlotBits(Ty)));
+    return true;
+  }
+
+  case Instruction::Store: {
+    auto &SI = cast<StoreInst>(I);
+    Type *Ty = SI.getValueOperand()->getType();
+    uint32_t Ptr, Val;
+    if (!SI.isSimple() || !isSupportedType(Ty) ||
+        !getSlot(SI.getPointerOperand(), Ptr) ||
+        !getSlot(SI.getValueOperand(), Val))
+      return false;
+    if (Ty->isFloatTy())
+      emit(BC_StoreFloat, 0, Ptr, Val);
+    else if (Ty->isDoubleTy())
+      emit(BC_StoreDouble, 0, Ptr, Val);
+    else
+      emit(BC_Store, 0, Ptr, Val, DL.getTypeStoreSize(Ty));
+    return true;
+  }
+
+  case Instruction::GetElementPtr:
+    return emitGEP(cast<GetElementPtrInst>(I));
+
+  case Instruction::Alloca: {
+    auto &AI = cast<AllocaInst>(I);
+    if (!AI.isStaticAlloca())
+      return false;
+    uint64_t Size = DL.getTypeAllocSize(AI.getAllocatedType()) *
+                    cast<ConstantInt>(AI.getArraySize())->getZExtValue();
+    unsigned Align = std::max(
+        AI.getAlignment(), DL.getPrefTypeAlignment(AI.getAllocatedType()));
+    BF->FrameSize = alignTo(BF->FrameSize, Align);
+    BF->FrameAlign = std::max(BF->FrameAlign, Align);
+    emit(BC_Alloca, Slots[&I], 0, 0, 0, BF->FrameSize);
+    // Allocate at least one byte, so that allocas get distinct addresses.
+    BF->FrameSize += std::max<uint64_t>(Size, 1);
+    return true;
+  }
+
+  case Instruction::Br: {
+    auto &BI = cast<BranchInst>(I);
+    BasicBlock *BB = BI.getParent();
+    if (BI.isUnconditional()) {
+      uint32_t E = getEdge(BB, BI.getSuccessor(0));
+      if (E == ~0U)
+        return false;
+      emit(BC_Br, 0, 0, 0, E);
+      return true;
+    }
+    uint32_t Cond;
+    if (!getSlot(BI.getCondition(), Cond))
+      return false;
+    uint32_t TrueEdge = getEdge(BB, BI.getSuccessor(0));
+    uint32_t FalseEdge = getEdge(BB, BI.getSuccessor(1));
+    if (TrueEdge == ~0U || FalseEdge == ~0U)
+      return false;
+    emit(BC_CondBr, 0, Cond, TrueEdge, FalseEdge);
+    return true;
+  }
+
+  case Instruction::Switch: {
+    auto &SI = cast<SwitchInst>(I);
+    uint32_t Cond;
+    if (!isSupportedType(SI.getCondition()->getType()) ||
+        !getSlot(SI.getCondition(), Cond))
+      return false;
+    BasicBlock *BB = SI.getParent();
+    uint32_t Default = getEdge(BB, SI.getDefaultDest());
+    if (Default == ~0U)
+      return false;
+    uint32_t CasesBegin = BF->SwitchCases.size();
+    for (auto Case : SI.cases()) {
+      uint32_t E = getEdge(BB, Case.getCaseSuccessor());
+      if (E == ~0U)
+        return false;
+      BF->SwitchCases.push_back({Case.getCaseValue()->getZExtValue(), E});
+    }
+    emit(BC_Switch, 0, Cond, CasesBegin, SI.getNumCases(), Default);
+    return true;
+  }
+
+  case Instruction::Ret: {
+    auto &RI = cast<ReturnInst>(I);
+    if (!RI.getReturnValue()) {
+      emit(BC_RetVoid);
+      return true;
+    }
+    uint32_t Val;
+    if (!getSlot(RI.getReturnValue(), Val))
+      return false;
+    emit(BC_Ret, 0, Val);
+    return true;
+  }
+
+  case Instruction::Call:
+    return emitCall(cast<CallInst>(I));
+
+  case Instruction::Unreachable:
+    emit(BC_Unreachable);
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+std::unique_ptr<BytecodeFunction> BytecodeCompiler::compile() {
+  // The loads and stores copy the bytes of the host representation of the
+  // slots.
+  if (F.isDeclaration() || F.isVarArg() || !DL.isLittleEndian() ||
+      !sys::IsLittleEndianHost)
+    return nullptr;
+
+  BF->RetTy = F.getReturnType();
+  if (!BF->RetTy->isVoidTy() && !isSupportedType(BF->RetTy))
+    return nullptr;
+
+  uint32_t NumSlots = 0;
+  for (Argument &Arg : F.args()) {
+    if (!isSupportedType(Arg.getType()))
+      return nullptr;
+    BF->ArgTys.push_back(Arg.getType());
+    Slots[&Arg] = NumSlots++;
+  }
+  for (Instruction &I : instructions(F))
+    if (!I.getType()->isVoidTy())
+      Slots[&I] = NumSlots++;
+  FirstConstantSlot = NumSlots;
+
+  for (BasicBlock &BB : F) {
+    BlockStarts[&BB] = BF->Code.size();
+    for (Instruction &I : BB)
+      if (!emitInstruction(I))
+        return nullptr;
+  }
+
+  for (unsigned I = 0, E = BF->Edges.size(); I != E; ++I)
+    BF->Edges[I].Target = BlockStarts[EdgeTargets[I]];
+  BF->NumSlots = FirstConstantSlot + BF->Constants.size();
+
+#ifdef BYTECODE_THREADED
+  // Replace the opcodes with the addresses of their handlers.
+  auto *Handlers =
+      (const void *const *)(uintptr_t)BF->execute(nullptr).I;
+  for (BytecodeFunction::Inst &I : BF->Code)
+    I.Handler = Handlers[I.Op];
+#endif
+
+  return std::move(BF);
+}
+
+std::unique_ptr<BytecodeFunction>
+BytecodeFunction::compile(
+    Function &F, const DataLayout &DL,
+    function_ref<GenericValue(Constant *)> GetConstantValue,
+    SmallVectorImpl<Function *> &Callees) {
+  return BytecodeCompiler(F, DL, GetConstantValue, Callees).compile();
+}
+
+void BytecodeFunction::resolveCalls(
+    function_ref<BytecodeFunction *(Function *)> GetCallee) {
+  for (CallInfo &CS : Calls) {
+    CS.Code = GetCallee(CS.Callee);
+    assert(CS.Code && "Callee has no bytecode!");
+  }
+}
+
+GenericValue BytecodeFunction::run(ArrayRef<GenericValue> Args) const {
+  SmallVector<Slot, 8> ArgSlots;
+  for (unsigned I = 0, E = ArgTys.size(); I != E; ++I)
+    ArgSlots.push_back(toSlot(Args[I], ArgTys[I]));
+  return toGenericValue(execute(ArgSlots.begin()), RetTy);
+}
+
+BytecodeFunction::Slot BytecodeFunction::execute(Slot *Args) const {
+#ifdef BYTECODE_THREADED
+#define BYTECODE_LABEL(Name) &&Op##Name,
+  static const void *const Handlers[] = {BYTECODE_OPS(BYTECODE_LABEL)};
+#undef BYTECODE_LABEL
+  if (!Args) {
+    Slot Result;
+    Result.I = (uintptr_t)Handlers;
+    return Result;
+  }
+#define OP(Name) Op##Name:
+#define DISPATCH() goto *PC->Handler
+#else
+#define OP(Name) case BC_##Name:
+#define DISPATCH() continue
+#endif
+#define NEXT()                                                                 \
+  ++PC;                                                                        \
+  DISPATCH()
+
+  SmallVector<Slot, 32> Frame(NumSlots + MaxMoves);
+  Slot *S = Frame.begin();
+  std::copy(Args, Args + ArgTys.size(), S);
+  std::copy(Constants.begin(), Constants.end(),
+            S + NumSlots - Constants.size());
+
+  std::unique_ptr<char[]> FrameMem;
+  uintptr_t FrameBase = 0;
+  if (FrameSize) {
+    FrameMem.reset(new char[FrameSize + FrameAlign]);
+    FrameBase = alignTo((uintptr_t)FrameMem.get(), FrameAlign);
+  }
+
+  // Performs the moves of the PHI nodes of an edge and returns its target.
+  auto TakeEdge = [&](uint32_t EdgeIdx) {
+    const Edge &E = Edges[EdgeIdx];
+    unsigned NumMoves = E.MovesEnd - E.MovesBegin;
+    if (NumMoves == 1) {
+      S[Moves[E.MovesBegin].first] = S[Moves[E.MovesBegin].second];
+    } else if (NumMoves) {
+      Slot *Tmp = S + NumSlots;
+      for (unsigned I = 0; I != NumMoves; ++I)
+        Tmp[I] = S[Moves[E.MovesBegin + I].second];
+      for (unsigned I = 0; I != NumMoves; ++I)
+        S[Moves[E.MovesBegin + I].first] = Tmp[I];
+    }
+    return &Code[E.Target];
+  };
+
+  const Inst *PC = Code.data();
+#ifdef BYTECODE_THREADED
+  DISPATCH();
+#else
+  for (;;) {
+    switch (PC->Op) {
+#endif
+
+  OP(Move) S[PC->Dst] = S[PC->A]; NEXT();
+
+  OP(Add) S[PC->Dst].I = (S[PC->A].I + S[PC->B].I) & PC->Imm; NEXT();
+  OP(Sub) S[PC->Dst].I = (S[PC->A].I - S[PC->B].I) & PC->Imm; NEXT();
+  OP(Mul) S[PC->Dst].I = (S[PC->A].I * S[PC->B].I) & PC->Imm; NEXT();
+  OP(UDiv) {
+    if (!S[PC->B].I)
+      report_fatal_error("Division by zero in interpreted code!");
+    S[PC->Dst].I = S[PC->A].I / S[PC->B].I;
+    NEXT();
+  }
+  OP(URem) {
+    if (!S[PC->B].I)
+      report_fatal_error("Division by zero in interpreted code!");
+    S[PC->Dst].I = S[PC->A].I % S[PC->B].I;
+    NEXT();
+  }
+  OP(SDiv) {
+    int64_t A = SignExtend64(S[PC->A].I, PC->Bits);
+    int64_t B = SignExtend64(S[PC->B].I, PC->Bits);
+    if (!B)
+      report_fatal_error("Division by zero in interpreted code!");
+    // Dividing the smallest value by -1 wraps around.
+    S[PC->Dst].I = (B == -1 ? 0 - (uint64_t)A : (uint64_t)(A / B)) & PC->Imm;
+    NEXT();
+  }
+  OP(SRem) {
+    int64_t A = SignExtend64(S[PC->A].I, PC->Bits);
+    int64_t B = SignExtend64(S[PC->B].I, PC->Bits);
+    if (!B)
+      report_fatal_error("Division by zero in interpreted code!");
+    S[PC->Dst].I = (B == -1 ? 0 : (uint64_t)(A % B)) & PC->Imm;
+    NEXT();
+  }
+  OP(Shl) {
+    uint64_t Amt = S[PC->B].I;
+    if (Amt >= PC->Bits)
+      Amt &= PC->C;
+    S[PC->Dst].I = (S[PC->A].I << Amt) & PC->Imm;
+    NEXT();
+  }
+  OP(LShr) {
+    uint64_t Amt = S[PC->B].I;
+    if (Amt >= PC->Bits)
+      Amt &= PC->C;
+    S[PC->Dst].I = (S[PC->A].I >> Amt) & PC->Imm;
+    NEXT();
+  }
+  OP(AShr) {
+    uint64_t Amt = S[PC->B].I;
+    if (Amt >= PC->Bits)
+      Amt &= PC->C;
+    S[PC->Dst].I =
+        (uint64_t)(SignExtend64(S[PC->A].I, PC->Bits) >> Amt) & PC->Imm;
+    NEXT();
+  }
+  OP(And) S[PC->Dst].I = S[PC->A].I & S[PC->B].I; NEXT();
+  OP(Or) S[PC->Dst].I = S[PC->A].I | S[PC->B].I; NEXT();
+  OP(Xor) S[PC->Dst].I = S[PC->A].I ^ S[PC->B].I; NEXT();
+
+  // Float results are computed in double and rounded, which gives the same
+  // result as computing them in float for these operations.
+#define FP_BINOP(Name, Expr)                                                   \
+  OP(Name) {                                                                   \
+    double A = S[PC->A].F, B = S[PC->B].F;                                     \
+    double R = Expr;                                                           \
+    S[PC->Dst].F = PC->Bits == 32 ? (double)(float)R : R;                      \
+    NEXT();                                                                    \
+  }
+  FP_BINOP(FAdd, A + B)
+  FP_BINOP(FSub, A - B)
+  FP_BINOP(FMul, A * B)
+  FP_BINOP(FDiv, A / B)
+  FP_BINOP(FRem, std::fmod(A, B))
+#undef FP_BINOP
+
+#define ICMP(Name, Expr)                                                       \
+  OP(Name) {                                                                   \
+    uint64_t A = S[PC->A].I, B = S[PC->B].I;                                   \
+    S[PC->Dst].I = (Expr);                                                     \
+    NEXT();                                                                    \
+  }
+  ICMP(ICmpEQ, A == B)
+  ICMP(ICmpNE, A != B)
+  ICMP(ICmpUGT, A > B)
+  ICMP(ICmpUGE, A >= B)
+  ICMP(ICmpULT, A < B)
+  ICMP(ICmpULE, A <= B)
+  ICMP(ICmpSGT, SignExtend64(A, PC->Bits) > SignExtend64(B, PC->Bits))
+  ICMP(ICmpSGE, SignExtend64(A, PC->Bits) >= SignExtend64(B, PC->Bits))
+  ICMP(ICmpSLT, SignExtend64(A, PC->Bits) < SignExtend64(B, PC->Bits))
+  ICMP(ICmpSLE, SignExtend64(A, PC->Bits) <= SignExtend64(B, PC->Bits))
+#undef ICMP
+  OP(FCmp) {
+    S[PC->Dst].I = evaluateFCmp(PC->C, S[PC->A].F, S[PC->B].F);
+    NEXT();
+  }
+
+  OP(Trunc) S[PC->Dst].I = S[PC->A].I & PC->Imm; NEXT();
+  OP(SExt) {
+    S[PC->Dst].I = (uint64_t)SignExtend64(S[PC->A].I, PC->C) & PC->Imm;
+    NEXT();
+  }
+  OP(FPTrunc) S[PC->Dst].F = (double)(float)S[PC->A].F; NEXT();
+  OP(FPToUI) S[PC->Dst].I = (uint64_t)S[PC->A].F & PC->Imm; NEXT();
+  OP(FPToSI) S[PC->Dst].I = (uint64_t)(int64_t)S[PC->A].F & PC->Imm; NEXT();
+  OP(UIToFP) {
+    uint64_t A = S[PC->A].I;
+    S[PC->Dst].F = PC->Bits == 32 ? (double)(float)A : (double)A;
+    NEXT();
+  }
+  OP(SIToFP) {
+    int64_t A = SignExtend64(S[PC->A].I, PC->C);
+    S[PC->Dst].F = PC->Bits == 32 ? (double)(float)A : (double)A;
+    NEXT();
+  }
+  OP(FPToBits) {
+    if (PC->Bits == 32) {
+      float F = S[PC->A].F;
+      uint32_t Bits;
+      memcpy(&Bits, &F, sizeof(F));
+      S[PC->Dst].I = Bits;
+    } else {
+      memcpy(&S[PC->Dst].I, &S[PC->A].F, sizeof(double));
+    }
+    NEXT();
+  }
+  OP(BitsToFP) {
+    if (PC->Bits == 32) {
+      uint32_t Bits = S[PC->A].I;
+      float F;
+      memcpy(&F, &Bits, sizeof(F));
+      S[PC->Dst].F = F;
+    } else {
+      memcpy(&S[PC->Dst].F, &S[PC->A].I, sizeof(double));
+    }
+    NEXT();
+  }
+
+  OP(Select) S[PC->Dst] = S[PC->C].I ? S[PC->A] : S[PC->B]; NEXT();
+
+  OP(Load) {
+    uint64_t V = 0;
+    memcpy(&V, (const void *)(uintptr_t)S[PC->A].I, PC->C);
+    S[PC->Dst].I = V & PC->Imm;
+    NEXT();
+  }
+  OP(LoadFloat) {
+    float F;
+    memcpy(&F, (const void *)(uintptr_t)S[PC->A].I, sizeof(F));
+    S[PC->Dst].F = F;
+    NEXT();
+  }
+  OP(LoadDouble) {
+    memcpy(&S[PC->Dst].F, (const void *)(uintptr_t)S[PC->A].I,
+           sizeof(double));
+    NEXT();
+  }
+  OP(Store) {
+    memcpy((void *)(uintptr_t)S[PC->A].I, &S[PC->B].I, PC->C);
+    NEXT();
+  }
+  OP(StoreFloat) {
+    float F = S[PC->B].F;
+    memcpy((void *)(uintptr_t)S[PC->A].I, &F, sizeof(F));
+    NEXT();
+  }
+  OP(StoreDouble) {
+    memcpy((void *)(uintptr_t)S[PC->A].I, &S[PC->B].F, sizeof(double));
+    NEXT();
+  }
+
+  OP(AddImm) S[PC->Dst].I = S[PC->A].I + PC->Imm; NEXT();
+  OP(GEPIndex) {
+    S[PC->Dst].I =
+        S[PC->A].I + (uint64_t)SignExtend64(S[PC->B].I, PC->Bits) * PC->Imm;
+    NEXT();
+  }
+  OP(Alloca) S[PC->Dst].I = FrameBase + PC->Imm; NEXT();
+
+  OP(Br) PC = TakeEdge(PC->C); DISPATCH();
+  OP(CondBr) PC = TakeEdge(S[PC->A].I ? PC->B : PC->C); DISPATCH();
+  OP(Switch) {
+    uint64_t V = S[PC->A].I;
+    uint32_t E = PC->Imm;
+    for (unsigned I = PC->B, End = PC->B + PC->C; I != End; ++I)
+      if (SwitchCases[I].first == V) {
+        E = SwitchCases[I].second;
+        break;
+      }
+    PC = TakeEdge(E);
+    DISPATCH();
+  }
+
+  OP(Ret) return S[PC->A];
+  OP(RetVoid) return Slot();
+
+  OP(Call) {
+    const CallInfo &CS = Calls[PC->A];
+    SmallVector<Slot, 8> CallArgSlots;
+    for (unsigned I = 0; I != CS.NumArgs; ++I)
+      CallArgSlots.push_back(S[CallArgs[CS.ArgsBegin + I]]);
+    Slot Result = CS.Code->execute(CallArgSlots.begin());
+    if (!CS.Callee->getReturnType()->isVoidTy())
+      S[PC->Dst] = Result;
+    NEXT();
+  }
+
+  OP(Unreachable)
+    report_fatal_error("Program executed an 'unreachable' instruction!");
+
+#ifndef BYTECODE_THREADED
+    }
+  }
+#endif
+#undef NEXT
+#undef DISPATCH
+#undef OP
+}
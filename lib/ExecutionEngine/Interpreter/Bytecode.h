@@ -0,0 +1,116 @@
+//===-- Bytecode.h - Register-slot bytecode for the interpreter -*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header defines the pre-decoded form of functions used by the fast path
+// of the interpreter.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIB_EXECUTIONENGINE_INTERPRETER_BYTECODE_H
+#define LLVM_LIB_EXECUTIONENGINE_INTERPRETER_BYTECODE_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ExecutionEngine/GenericValue.h"
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+
+class Constant;
+class DataLayout;
+class Function;
+class Type;
+
+/// A function lowered to a register-slot bytecode with unboxed operands.
+///
+/// Every value of the function (constants, arguments and instructions) lives
+/// in a 64-bit slot of the frame: integers zero-extended from their width,
+/// float and double values as doubles, pointers as integers. Instructions
+/// refer to their operands by slot index, PHI nodes are lowered to moves on
+/// the incoming edges, and the instructions are dispatched with direct
+/// threading where the host compiler supports computed gotos.
+///
+/// Only a subset of the IR is supported: scalar integer types of at most 64
+/// bits, float, double and pointers; arithmetic, comparisons, casts, select,
+/// loads and stores, getelementptr, static allocas, branches, switches,
+/// returns and direct calls of functions that are supported themselves.
+/// Functions using anything else are left to the interpreter's generic path.
+class BytecodeFunction {
+public:
+  union Slot {
+    uint64_t I;
+    double F;
+  };
+
+  /// Lowers \p F, and adds the defined functions it calls to \p Callees.
+  /// \p GetConstantValue evaluates the constants used by \p F. Returns null
+  /// if \p F uses IR the bytecode doesn't support.
+  static std::unique_ptr<BytecodeFunction>
+  compile(Function &F, const DataLayout &DL,
+          function_ref<GenericValue(Constant *)> GetConstantValue,
+          SmallVectorImpl<Function *> &Callees);
+
+  /// Binds the calls of the function to the bytecode of their callees.
+  void resolveCalls(function_ref<BytecodeFunction *(Function *)> GetCallee);
+
+  /// Runs the function on \p Args and returns its result.
+  GenericValue run(ArrayRef<GenericValue> Args) const;
+
+  struct Inst {
+    union {
+      unsigned Op;
+      const void *Handler;
+    };
+    uint32_t Dst, A, B, C;
+    uint64_t Imm;
+    unsigned Bits;
+  };
+
+private:
+  struct Edge {
+    uint32_t Target;
+    uint32_t MovesBegin, MovesEnd;
+  };
+
+  struct CallInfo {
+    Function *Callee;
+    const BytecodeFunction *Code;
+    uint32_t ArgsBegin, NumArgs;
+  };
+
+  friend class BytecodeCompiler;
+
+  BytecodeFunction() = default;
+
+  Slot execute(Slot *Args) const;
+
+  std::vector<Inst> Code;
+  std::vector<Edge> Edges;
+  /// Parallel moves lowering the PHI nodes, as (destination, source) slots.
+  std::vector<std::pair<uint32_t, uint32_t>> Moves;
+  std::vector<std::pair<uint64_t, uint32_t>> SwitchCases;
+  std::vector<CallInfo> Calls;
+  std::vector<uint32_t> CallArgs;
+  /// The initial contents of the frame: the constants of the function.
+  std::vector<Slot> Constants;
+  Type *RetTy = nullptr;
+  SmallVector<Type *, 4> ArgTys;
+  unsigned NumSlots = 0;
+  unsigned MaxMoves = 0;
+  uint64_t FrameSize = 0;
+  unsigned FrameAlign = 1;
+};
+
+} // End llvm namespace
+
+#endif
@@ -35,6 +35,11 @@ STATISTIC(NumDynamicInsts, "Number of dynamic instructions executed");
 static cl::opt<bool> PrintVolatile("interpreter-print-volatile", cl::Hidden,
           cl::desc("make the interpreter print every volatile load and store"));
 
+static cl::opt<bool> UseFastPath("interpreter-fast-path", cl::Hidden,
+          cl::init(true),
+          cl::desc("run the functions the interpreter's bytecode supports "
+                   "with the bytecode fast path"));
+
 //===----------------------------------------------------------------------===//
 //                     Various Helper Functions
 //===----------------------------------------------------------------------===//
@@ -2089,6 +2094,14 @@ void Interpreter::callFunction(Function *F, ArrayRef<GenericValue> ArgVals) {
     return;
   }
 
+  // Run the function on the fast path if it can, without interpreting its
+  // instructions one by one.
+  if (BytecodeFunction *BF = getBytecodeFunction(F)) {
+    GenericValue Result = BF->run(ArgVals);
+    popStackAndReturnValueToCaller(F->getReturnType(), Result);
+    return;
+  }
+
   // Get pointers to first LLVM BB & Instruction in function.
   StackFrame.CurBB     = &F->front();
   StackFrame.CurInst   = StackFrame.CurBB->begin();
@@ -2108,6 +2121,52 @@ void Interpreter::callFunction(Function *F, ArrayRef<GenericValue> ArgVals) {
   StackFrame.VarArgs.assign(ArgVals.begin()+i, ArgVals.end());
 }
 
+BytecodeFunction *Interpreter::getBytecodeFunction(Function *F) {
+  if (!UseFastPath)
+    return nullptr;
+  auto It = BytecodeFunctions.find(F);
+  if (It != BytecodeFunctions.end())
+    return It->second.get();
+
+  // F can only be run by the fast path if all the functions it may call can,
+  // so lower them together.
+  auto GetConstantValue = [this](Constant *C) { return getConstantValue(C); };
+  SmallVector<Function *, 8> Worklist(1, F);
+  SmallVector<Function *, 8> Lowered;
+  bool Supported = true;
+  while (Supported && !Worklist.empty()) {
+    Function *G = Worklist.pop_back_val();
+    auto It = BytecodeFunctions.find(G);
+    if (It != BytecodeFunctions.end()) {
+      Supported = It->second != nullptr;
+      continue;
+    }
+    std::unique_ptr<BytecodeFunction> BF =
+        BytecodeFunction::compile(*G, getDataLayout(), GetConstantValue,
+                                  Worklist);
+    Supported = BF != nullptr;
+    if (Supported) {
+      BytecodeFunctions[G] = std::move(BF);
+      Lowered.push_back(G);
+    }
+  }
+
+  if (!Supported) {
+    // The functions lowered so far may still be supported on their own; find
+    // out when they are called.
+    for (Function *G : Lowered)
+      BytecodeFunctions.erase(G);
+    BytecodeFunctions[F] = nullptr;
+    LLVM_DEBUG(dbgs() << "Interpreter: " << F->getName()
+                      << " can't run on the fast path\n");
+    return nullptr;
+  }
+
+  for (Function *G : Lowered)
+    BytecodeFunctions[G]->resolveCalls(
+        [this](Function *Callee) { return BytecodeFunctions[Callee].get(); });
+  return BytecodeFunctions[F].get();
+}
 
 void Interpreter::run() {
   while (!ECStack.empty()) {
@@ -14,6 +14,8 @@
 #ifndef LLVM_LIB_EXECUTIONENGINE_INTERPRETER_INTERPRETER_H
 #define LLVM_LIB_EXECUTIONENGINE_INTERPRETER_INTERPRETER_H
 
+#include "Bytecode.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/ExecutionEngine/GenericValue.h"
 #include "llvm/IR/CallSite.h"
@@ -85,6 +87,10 @@ class Interpreter : public ExecutionEngine, public InstVisitor<Interpreter> {
   // registered with the atexit() library function.
   std::vector<Function*> AtExitHandlers;
 
+  // The bytecode of the functions run by the fast path, or null for the
+  // functions it can't run.
+  DenseMap<Function *, std::unique_ptr<BytecodeFunction>> BytecodeFunctions;
+
 public:
   explicit Interpreter(std::unique_ptr<Module> M);
   ~Interpreter() override;
@@ -228,6 +234,10 @@ private:  // Helper functions
                                     Type *Ty, ExecutionContext &SF);
   void popStackAndReturnValueToCaller(Type *RetTy, GenericValue Result);
 
+  // getBytecodeFunction - Return the bytecode of F if it and all the functions
+  // it may call can be run by the fast path, or null otherwise.
+  BytecodeFunction *getBytecodeFunction(Function *F);
+
 };
 
 } // End llvm namespace
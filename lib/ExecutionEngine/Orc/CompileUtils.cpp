@@ -0,0 +1,54 @@
+//===------ CompileUtils.cpp - Utilities for compiling IR in the JIT ------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/IR/Module.h"
+
+namespace llvm {
+namespace orc {
+
+Expected<std::unique_ptr<TargetMachine>>
+ConcurrentIRCompiler::TargetMachinePool::acquire() {
+  std::lock_guard<std::mutex> Lock(PoolMutex);
+  if (IdleTMs.empty())
+    return JTMB.createTargetMachine();
+  auto TM = std::move(IdleTMs.back());
+  IdleTMs.pop_back();
+  return std::move(TM);
+}
+
+void ConcurrentIRCompiler::TargetMachinePool::release(
+    std::unique_ptr<TargetMachine> TM) {
+  std::lock_guard<std::mutex> Lock(PoolMutex);
+  IdleTMs.push_back(std::move(TM));
+}
+
+ConcurrentIRCompiler::ConcurrentIRCompiler(JITTargetMachineBuilder JTMB,
+                                           ObjectCache *ObjCache)
+    : Pool(std::make_shared<TargetMachinePool>(std::move(JTMB))),
+      ObjCache(ObjCache) {}
+
+Expected<std::unique_ptr<MemoryBuffer>>
+ConcurrentIRCompiler::operator()(Module &M) {
+  auto TM = Pool->acquire();
+  if (!TM)
+    return TM.takeError();
+
+  auto Obj = SimpleCompiler(**TM, ObjCache)(M);
+  Pool->release(std::move(*TM));
+
+  if (!Obj)
+    return make_error<StringError>("Could not compile module " +
+                                       M.getModuleIdentifier(),
+                                   inconvertibleErrorCode());
+  return std::move(Obj);
+}
+
+} // End namespace orc.
+} // End namespace llvm.
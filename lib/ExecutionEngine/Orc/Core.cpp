@@ -651,6 +651,7 @@ void VSO::finalize(const SymbolFlagsMap &Finalized) {
             auto &DependantSym = DependantVSO.Symbols[DependantName];
             DependantSym.setFlags(static_cast<JITSymbolFlags::FlagNames>(
                 DependantSym.getFlags() & ~JITSymbolFlags::Materializing));
+            DependantVSO.addFinalizedSymbol(DependantName, DependantSym);
             DependantVSO.MaterializingInfos.erase(DependantMII);
           }
         }
@@ -670,6 +671,7 @@ void VSO::finalize(const SymbolFlagsMap &Finalized) {
         auto &Sym = Symbols[Name];
         Sym.setFlags(static_cast<JITSymbolFlags::FlagNames>(
             Sym.getFlags() & ~JITSymbolFlags::Materializing));
+        addFinalizedSymbol(Name, Sym);
         MaterializingInfos.erase(MII);
       }
     }
@@ -683,6 +685,23 @@ void VSO::finalize(const SymbolFlagsMap &Finalized) {
   }
 }
 
+void VSO::addFinalizedSymbol(const SymbolStringPtr &Name,
+                             JITEvaluatedSymbol Sym) {
+  auto &Shard = getFinalizedSymbolsShard(Name);
+  sys::ScopedWriter Lock(Shard.Mutex);
+  Shard.Symbols[Name] = Sym;
+}
+
+VSO::FinalizedSymbolsShard &
+VSO::getFinalizedSymbolsShard(const SymbolStringPtr &Name) {
+  return FinalizedSymbols[hash_value(Name) % NumFinalizedSymbolsShards];
+}
+
+const VSO::FinalizedSymbolsShard &
+VSO::getFinalizedSymbolsShard(const SymbolStringPtr &Name) const {
+  return FinalizedSymbols[hash_value(Name) % NumFinalizedSymbolsShards];
+}
+
 void VSO::notifyFailed(const SymbolNameSet &FailedSymbols) {
 
   // FIXME: This should fail any transitively dependant symbols too.
@@ -834,6 +853,19 @@ SymbolNameSet VSO::lookup(std::shared_ptr<AsynchronousSymbolQuery> Q,
   return Unresolved;
 }
 
+void VSO::lookupFinalized(SymbolMap &Result, SymbolNameSet &Names) const {
+  for (auto I = Names.begin(), E = Names.end(); I != E;) {
+    auto TmpI = I++;
+    auto &Shard = getFinalizedSymbolsShard(*TmpI);
+    sys::ScopedReader Lock(Shard.Mutex);
+    auto SymI = Shard.Symbols.find(*TmpI);
+    if (SymI == Shard.Symbols.end())
+      continue;
+    Result[*TmpI] = SymI->second;
+    Names.erase(TmpI);
+  }
+}
+
 VSO::LookupImplActionFlags
 VSO::lookupImpl(std::shared_ptr<AsynchronousSymbolQuery> &Q,
                 std::vector<std::unique_ptr<MaterializationUnit>> &MUs,
@@ -1215,6 +1247,14 @@ Expected<SymbolMap> lookup(const VSOList &VSOs, SymbolNameSet Names) {
 
   auto &ES = (*VSOs.begin())->getExecutionSession();
 
+  // Symbols the first VSO has finalized can't be shadowed, so return them
+  // directly. Symbols found in later VSOs need the session lock to check that
+  // the VSOs searched before don't define them.
+  SymbolMap Result;
+  (*VSOs.begin())->lookupFinalized(Result, Names);
+  if (Names.empty())
+    return std::move(Result);
+
   auto LookupFn = [&](std::shared_ptr<AsynchronousSymbolQuery> Q,
                       SymbolNameSet Unresolved) {
     for (auto *V : VSOs) {
@@ -1226,7 +1266,11 @@ Expected<SymbolMap> lookup(const VSOList &VSOs, SymbolNameSet Names) {
     return Unresolved;
   };
 
-  return blockingLookup(ES, std::move(LookupFn), Names, true);
+  auto Remaining = blockingLookup(ES, std::move(LookupFn), Names, true);
+  if (!Remaining || Result.empty())
+    return Remaining;
+  Result.insert(Remaining->begin(), Remaining->end());
+  return std::move(Result);
 }
 
 /// Look up a symbol by searching a list of VSOs.
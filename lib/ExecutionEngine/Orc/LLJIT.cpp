@@ -22,6 +22,26 @@ LLJIT::Create(std::unique_ptr<ExecutionSession> ES,
       new LLJIT(std::move(ES), std::move(TM), std::move(DL)));
 }
 
+Expected<std::unique_ptr<LLJIT>>
+LLJIT::Create(std::unique_ptr<ExecutionSession> ES,
+              JITTargetMachineBuilder JTMB, DataLayout DL,
+              unsigned NumCompileThreads) {
+  if (NumCompileThreads == 0) {
+    auto TM = JTMB.createTargetMachine();
+    if (!TM)
+      return TM.takeError();
+    return Create(std::move(ES), std::move(*TM), std::move(DL));
+  }
+
+  return std::unique_ptr<LLJIT>(new LLJIT(std::move(ES), std::move(JTMB),
+                                          std::move(DL), NumCompileThreads));
+}
+
+LLJIT::~LLJIT() {
+  if (CompileThreads)
+    CompileThreads->wait();
+}
+
 Error LLJIT::defineAbsolute(StringRef Name, JITEvaluatedSymbol Sym) {
   auto InternedName = ES->getSymbolStringPool().intern(Name);
   SymbolMap Symbols({{InternedName, Sym}});
@@ -35,7 +55,10 @@ Error LLJIT::addIRModule(VSO &V, std::unique_ptr<Module> M) {
     return Err;
 
   auto K = ES->allocateVModule();
-  Resolvers[K] = createResolverFor(V);
+  {
+    std::lock_guard<std::mutex> Lock(ResolversMutex);
+    Resolvers[K] = createResolverFor(V);
+  }
   return CompileLayer.add(V, K, std::move(M));
 }
 
@@ -50,12 +73,51 @@ LLJIT::LLJIT(std::unique_ptr<ExecutionSession> ES,
       DL(std::move(DL)),
       ObjLinkingLayer(*this->ES,
                       [this](VModuleKey K) { return getRTDyldResources(K); }),
-      CompileLayer(*this->ES, ObjLinkingLayer, SimpleCompiler(*this->TM)),
+      CompileLayer(*this->ES, ObjLinkingLayer,
+                   [this](Module &M) { return compileModule(M); }),
+      CtorRunner(Main), DtorRunner(Main) {
+  VSOLookupOrder[&Main] = VSOList({&Main});
+}
+
+LLJIT::LLJIT(std::unique_ptr<ExecutionSession> ES,
+             JITTargetMachineBuilder JTMB, DataLayout DL,
+             unsigned NumCompileThreads)
+    : ES(std::move(ES)), Main(this->ES->createVSO("main")),
+      ConcurrentCompiler(
+          llvm::make_unique<ConcurrentIRCompiler>(std::move(JTMB))),
+      DL(std::move(DL)),
+      ObjLinkingLayer(*this->ES,
+                      [this](VModuleKey K) { return getRTDyldResources(K); }),
+      CompileLayer(*this->ES, ObjLinkingLayer,
+                   [this](Module &M) { return compileModule(M); }),
       CtorRunner(Main), DtorRunner(Main) {
+  assert(NumCompileThreads != 0 &&
+         "Multithreaded LLJIT instance requires at least one compile thread");
   VSOLookupOrder[&Main] = VSOList({&Main});
+
+  CompileThreads = llvm::make_unique<ThreadPool>(NumCompileThreads);
+  this->ES->setDispatchMaterialization(
+      [this](VSO &V, std::unique_ptr<MaterializationUnit> MU) {
+        // ThreadPool tasks must be copyable, so share ownership of the unit.
+        auto SharedMU = std::shared_ptr<MaterializationUnit>(std::move(MU));
+        CompileThreads->async([SharedMU, &V]() { SharedMU->doMaterialize(V); });
+      });
+}
+
+void LLJIT::setObjectCache(ObjectCache *NewCache) {
+  ObjCache = NewCache;
+  if (ConcurrentCompiler)
+    ConcurrentCompiler->setObjectCache(NewCache);
+}
+
+Expected<std::unique_ptr<MemoryBuffer>> LLJIT::compileModule(Module &M) {
+  if (ConcurrentCompiler)
+    return (*ConcurrentCompiler)(M);
+  return SimpleCompiler(*TM, ObjCache)(M);
 }
 
 std::shared_ptr<SymbolResolver> LLJIT::takeSymbolResolver(VModuleKey K) {
+  std::lock_guard<std::mutex> Lock(ResolversMutex);
   auto ResolverI = Resolvers.find(K);
   assert(ResolverI != Resolvers.end() && "Missing resolver");
   auto Resolver = std::move(ResolverI->second);
@@ -163,6 +225,7 @@ LLLazyJIT::LLLazyJIT(
 
 void LLLazyJIT::setSymbolResolver(VModuleKey K,
                                   std::shared_ptr<SymbolResolver> R) {
+  std::lock_guard<std::mutex> Lock(ResolversMutex);
   assert(!Resolvers.count(K) && "Resolver already present for VModule K");
   Resolvers[K] = std::move(R);
 }
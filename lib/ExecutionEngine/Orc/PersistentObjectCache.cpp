@@ -0,0 +1,112 @@
+//===---- PersistentObjectCache.cpp - On-disk object cache for ORC --------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/PersistentObjectCache.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+
+namespace llvm {
+namespace orc {
+
+PersistentObjectCache::PersistentObjectCache(StringRef CacheDir,
+                                             const TargetMachine &TM,
+                                             CachePruningPolicy Policy)
+    : CacheDir(CacheDir), Policy(std::move(Policy)) {
+  raw_string_ostream TargetKeyStream(TargetKey);
+  TargetKeyStream << TM.getTargetTriple().str() << '\0'
+                  << TM.getTargetCPU() << '\0' << TM.getTargetFeatureString();
+  TargetKeyStream.flush();
+  sys::fs::create_directories(CacheDir);
+}
+
+std::string PersistentObjectCache::computeKey(const Module &M) const {
+  SmallVector<char, 0> Bitcode;
+  {
+    raw_svector_ostream BitcodeStream(Bitcode);
+    WriteBitcodeToFile(M, BitcodeStream);
+  }
+
+  SHA1 Hasher;
+  Hasher.update(TargetKey);
+  Hasher.update(StringRef(Bitcode.data(), Bitcode.size()));
+  return toHex(Hasher.final());
+}
+
+std::string PersistentObjectCache::getCachePathForKey(StringRef Key) const {
+  // Name the files so that pruneCache recognizes them.
+  SmallString<128> Path(CacheDir);
+  sys::path::append(Path, "llvmcache-" + Key);
+  return Path.str();
+}
+
+std::string PersistentObjectCache::getCachePath(const Module &M) {
+  return getCachePathForKey(computeKey(M));
+}
+
+std::unique_ptr<MemoryBuffer>
+PersistentObjectCache::getObject(const Module *M) {
+  std::string Key = computeKey(*M);
+
+  // Object files don't need a null terminator, which lets larger objects be
+  // memory mapped rather than read.
+  auto Obj = MemoryBuffer::getFile(getCachePathForKey(Key), /*FileSize=*/-1,
+                                   /*RequiresNullTerminator=*/false);
+  if (Obj)
+    return std::move(*Obj);
+
+  std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+  PendingKeys[M] = std::move(Key);
+  return nullptr;
+}
+
+void PersistentObjectCache::notifyObjectCompiled(const Module *M,
+                                                 MemoryBufferRef Obj) {
+  std::string Key;
+  {
+    std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+    auto I = PendingKeys.find(M);
+    if (I != PendingKeys.end()) {
+      Key = std::move(I->second);
+      PendingKeys.erase(I);
+    }
+  }
+  if (Key.empty())
+    Key = computeKey(*M);
+
+  // Write the object to a temporary file and rename it into place, so that
+  // concurrent readers never see a partially written object.
+  SmallString<128> TempPath(CacheDir);
+  sys::path::append(TempPath, "tmp-%%%%%%%%.o");
+  int FD;
+  if (sys::fs::createUniqueFile(TempPath, FD, TempPath))
+    return;
+  {
+    raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << Obj.getBuffer();
+    if (OS.has_error()) {
+      OS.clear_error();
+      sys::fs::remove(TempPath);
+      return;
+    }
+  }
+  if (sys::fs::rename(TempPath, getCachePathForKey(Key)))
+    sys::fs::remove(TempPath);
+}
+
+bool PersistentObjectCache::prune() { return pruneCache(CacheDir, Policy); }
+
+} // End namespace orc.
+} // End namespace llvm.
@@ -0,0 +1,270 @@
+//===------- SharedMemoryChannel.cpp - RPC channel over shared memory -----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/SharedMemoryChannel.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/ExecutionEngine/Orc/RPCUtils.h"
+#include "llvm/Support/MathExtras.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#ifdef LLVM_ON_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace llvm;
+using namespace llvm::orc;
+using namespace llvm::orc::rpc;
+
+namespace {
+
+const uint64_t ChannelMagic = 0x4f524353484d3031; // "ORCSHM01"
+const size_t CacheLineSize = 64;
+
+struct ChannelHeader {
+  uint64_t Magic;
+  uint64_t RingSize;
+};
+
+} // end anonymous namespace
+
+/// The control block of one direction of the channel. The reader owns Head
+/// and the writer owns Tail; they live on separate cache lines so that the
+/// two processes don't contend for them.
+struct SharedMemoryChannel::Ring {
+  alignas(CacheLineSize) std::atomic<uint64_t> Head;
+  alignas(CacheLineSize) std::atomic<uint64_t> Tail;
+  alignas(CacheLineSize) std::atomic<uint32_t> Closed;
+};
+
+static size_t getRingsOffset() {
+  return alignTo(sizeof(ChannelHeader), CacheLineSize);
+}
+
+size_t SharedMemoryChannel::getDataOffset() {
+  return alignTo(getRingsOffset() + 2 * sizeof(Ring), CacheLineSize);
+}
+
+static Error errnoToError() {
+  return errorCodeToError(std::error_code(errno, std::generic_category()));
+}
+
+/// Backs off while waiting for the peer: spins first, as the peer is usually
+/// about to make progress, then yields, then sleeps.
+static void waitForPeer(unsigned &Attempts) {
+  ++Attempts;
+  if (Attempts < 1024)
+    return;
+  if (Attempts < 4096)
+    std::this_thread::yield();
+  else
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+}
+
+Expected<std::unique_ptr<SharedMemoryChannel>>
+SharedMemoryChannel::create(StringRef Name, size_t RingSize) {
+#ifdef LLVM_ON_UNIX
+  RingSize = NextPowerOf2(std::max<size_t>(RingSize, CacheLineSize) - 1);
+  size_t MappingSize = getDataOffset() + 2 * RingSize;
+
+  std::string NameStr = Name.str();
+  int FD = shm_open(NameStr.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (FD < 0)
+    return errnoToError();
+  if (ftruncate(FD, MappingSize) != 0) {
+    Error Err = errnoToError();
+    ::close(FD);
+    shm_unlink(NameStr.c_str());
+    return std::move(Err);
+  }
+  void *Mapping =
+      mmap(nullptr, MappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, FD, 0);
+  Error Err = Mapping == MAP_FAILED ? errnoToError() : Error::success();
+  ::close(FD);
+  if (Err) {
+    shm_unlink(NameStr.c_str());
+    return std::move(Err);
+  }
+
+  auto *Header = static_cast<ChannelHeader *>(Mapping);
+  Header->RingSize = RingSize;
+  char *Rings = static_cast<char *>(Mapping) + getRingsOffset();
+  for (unsigned I = 0; I != 2; ++I) {
+    Ring *R = new (Rings + I * sizeof(Ring)) Ring;
+    R->Head.store(0, std::memory_order_relaxed);
+    R->Tail.store(0, std::memory_order_relaxed);
+    R->Closed.store(0, std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  Header->Magic = ChannelMagic;
+
+  return std::unique_ptr<SharedMemoryChannel>(new SharedMemoryChannel(
+      std::move(NameStr), /*Owner=*/true, Mapping, MappingSize));
+#else
+  return make_error<StringError>(
+      "Shared memory channels are not supported on this host",
+      inconvertibleErrorCode());
+#endif
+}
+
+Expected<std::unique_ptr<SharedMemoryChannel>>
+SharedMemoryChannel::open(StringRef Name) {
+#ifdef LLVM_ON_UNIX
+  std::string NameStr = Name.str();
+  int FD = shm_open(NameStr.c_str(), O_RDWR, 0600);
+  if (FD < 0)
+    return errnoToError();
+  struct stat Stat;
+  if (fstat(FD, &Stat) != 0) {
+    Error Err = errnoToError();
+    ::close(FD);
+    return std::move(Err);
+  }
+  size_t MappingSize = Stat.st_size;
+  if (MappingSize < getDataOffset()) {
+    ::close(FD);
+    return make_error<StringError>(NameStr + " is not a shared memory channel",
+                                   inconvertibleErrorCode());
+  }
+  void *Mapping =
+      mmap(nullptr, MappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, FD, 0);
+  Error Err = Mapping == MAP_FAILED ? errnoToError() : Error::success();
+  ::close(FD);
+  if (Err)
+    return std::move(Err);
+
+  auto *Header = static_cast<const ChannelHeader *>(Mapping);
+  if (Header->Magic != ChannelMagic ||
+      MappingSize != getDataOffset() + 2 * Header->RingSize) {
+    munmap(Mapping, MappingSize);
+    return make_error<StringError>(NameStr + " is not a shared memory channel",
+                                   inconvertibleErrorCode());
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  return std::unique_ptr<SharedMemoryChannel>(new SharedMemoryChannel(
+      std::move(NameStr), /*Owner=*/false, Mapping, MappingSize));
+#else
+  return make_error<StringError>(
+      "Shared memory channels are not supported on this host",
+      inconvertibleErrorCode());
+#endif
+}
+
+SharedMemoryChannel::SharedMemoryChannel(std::string Name, bool Owner,
+                                         void *Mapping, size_t MappingSize)
+    : Name(std::move(Name)), Owner(Owner), Mapping(Mapping),
+      MappingSize(MappingSize) {
+  char *Base = static_cast<char *>(Mapping);
+  RingSize = reinterpret_cast<ChannelHeader *>(Base)->RingSize;
+
+  // The creator writes to the first ring and reads from the second one.
+  Ring *Rings = reinterpret_cast<Ring *>(Base + getRingsOffset());
+  char *Data = Base + getDataOffset();
+  unsigned OutIdx = Owner ? 0 : 1;
+  Out = &Rings[OutIdx];
+  OutData = Data + OutIdx * RingSize;
+  In = &Rings[1 - OutIdx];
+  InData = Data + (1 - OutIdx) * RingSize;
+
+  PendingTail = Out->Tail.load(std::memory_order_relaxed);
+  CachedHead = Out->Head.load(std::memory_order_acquire);
+}
+
+SharedMemoryChannel::~SharedMemoryChannel() {
+#ifdef LLVM_ON_UNIX
+  publish();
+  In->Closed.store(1, std::memory_order_release);
+  Out->Closed.store(1, std::memory_order_release);
+  munmap(Mapping, MappingSize);
+  if (Owner)
+    shm_unlink(Name.c_str());
+#endif
+}
+
+Error SharedMemoryChannel::readBytes(char *Dst, unsigned Size) {
+  assert(Dst && "Attempt to read into null.");
+  unsigned Attempts = 0;
+  while (Size) {
+    uint64_t Head = In->Head.load(std::memory_order_relaxed);
+    uint64_t Tail = In->Tail.load(std::memory_order_acquire);
+    if (Head == Tail) {
+      // Check the tail again after seeing the flag, in case the peer
+      // published its last bytes right before closing.
+      if (In->Closed.load(std::memory_order_acquire) &&
+          In->Tail.load(std::memory_order_acquire) == Head)
+        return make_error<ConnectionClosed>();
+      waitForPeer(Attempts);
+      continue;
+    }
+    Attempts = 0;
+
+    uint64_t N = std::min<uint64_t>(Size, Tail - Head);
+    uint64_t Offset = Head & (RingSize - 1);
+    uint64_t First = std::min(N, RingSize - Offset);
+    memcpy(Dst, InData + Offset, First);
+    memcpy(Dst + First, InData, N - First);
+    In->Head.store(Head + N, std::memory_order_release);
+    Dst += N;
+    Size -= N;
+  }
+  return Error::success();
+}
+
+Error SharedMemoryChannel::appendBytes(const char *Src, unsigned Size) {
+  assert(Src && "Attempt to append from null.");
+  unsigned Attempts = 0;
+  while (Size) {
+    if (Out->Closed.load(std::memory_order_acquire))
+      return make_error<ConnectionClosed>();
+
+    uint64_t Free = RingSize - (PendingTail - CachedHead);
+    if (!Free) {
+      CachedHead = Out->Head.load(std::memory_order_acquire);
+      Free = RingSize - (PendingTail - CachedHead);
+    }
+    if (!Free) {
+      // The ring is full: let the peer drain what we have written so far.
+      publish();
+      waitForPeer(Attempts);
+      continue;
+    }
+    Attempts = 0;
+
+    uint64_t N = std::min<uint64_t>(Size, Free);
+    uint64_t Offset = PendingTail & (RingSize - 1);
+    uint64_t First = std::min(N, RingSize - Offset);
+    memcpy(OutData + Offset, Src, First);
+    memcpy(OutData, Src + First, N - First);
+    PendingTail += N;
+    Src += N;
+    Size -= N;
+  }
+  // The RPC layer doesn't call send() after responses, so the bytes have to
+  // become visible right away.
+  publish();
+  return Error::success();
+}
+
+Error SharedMemoryChannel::send() {
+  publish();
+  return Error::success();
+}
+
+void SharedMemoryChannel::publish() {
+  Out->Tail.store(PendingTail, std::memory_order_release);
+}
@@ -0,0 +1,373 @@
+//===-- PerfJITEventListener.cpp - Tell Linux's perf about JITted code ----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines a JITEventListener object that tells perf about JITted
+// functions, in two formats:
+//
+//  * the perf map, /tmp/perf-<pid>.map, a text file with the address, size
+//    and name of every function, which perf report reads on its own;
+//  * the jitdump format, which also carries the code and its line table, for
+//    use with perf inject --jit.
+//
+// The jitdump format is described in tools/perf/Documentation/
+// jitdump-specification.txt in the Linux kernel sources.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm-c/ExecutionEngine.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/BinaryFormat/ELF.h"
+#include "llvm/Config/config.h"
+#include "llvm/DebugInfo/DWARF/DWARFContext.h"
+#include "llvm/ExecutionEngine/JITEventListener.h"
+#include "llvm/ExecutionEngine/RuntimeDyld.h"
+#include "llvm/Object/ObjectFile.h"
+#include "llvm/Object/SymbolSize.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/Errno.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/MutexGuard.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/raw_ostream.h"
+#include <cstdlib>
+#include <ctime>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace llvm;
+using namespace llvm::object;
+
+#define DEBUG_TYPE "perf-jit-event-listener"
+
+namespace {
+
+// The records of the jitdump format. All fields are in host byte order.
+enum JITDumpRecordType : uint32_t {
+  JIT_CODE_LOAD = 0,
+  JIT_CODE_MOVE = 1,
+  JIT_CODE_DEBUG_INFO = 2,
+  JIT_CODE_CLOSE = 3
+};
+
+struct JITDumpHeader {
+  uint32_t Magic;
+  uint32_t Version;
+  uint32_t TotalSize;
+  uint32_t ElfMach;
+  uint32_t Pad1;
+  uint32_t Pid;
+  uint64_t Timestamp;
+  uint64_t Flags;
+};
+
+struct JITDumpRecordHeader {
+  uint32_t Id;
+  uint32_t TotalSize;
+  uint64_t Timestamp;
+};
+
+struct JITDumpCodeLoad {
+  JITDumpRecordHeader Prefix;
+  uint32_t Pid;
+  uint32_t Tid;
+  uint64_t Vma;
+  uint64_t CodeAddr;
+  uint64_t CodeSize;
+  uint64_t CodeIndex;
+};
+
+struct JITDumpDebugInfo {
+  JITDumpRecordHeader Prefix;
+  uint64_t CodeAddr;
+  uint64_t NrEntry;
+};
+
+struct JITDumpDebugEntry {
+  uint64_t Addr;
+  uint32_t Line;
+  uint32_t Discrim;
+};
+
+const uint32_t JITDumpMagic = 0x4A695444; // "JiTD"
+const uint32_t JITDumpVersion = 1;
+
+class PerfJITEventListener : public JITEventListener {
+public:
+  PerfJITEventListener();
+  ~PerfJITEventListener() override;
+
+  void NotifyObjectEmitted(const ObjectFile &Obj,
+                           const RuntimeDyld::LoadedObjectInfo &L) override;
+  void NotifyFreeingObject(const ObjectFile &Obj) override;
+
+private:
+  bool openPerfMap();
+  bool openJITDump();
+  void closeJITDump();
+
+  void writePerfMapEntry(StringRef Name, uint64_t Addr, uint64_t Size);
+  void writeJITDumpDebugInfo(uint64_t Addr, const DILineInfoTable &Lines);
+  void writeJITDumpCodeLoad(StringRef Name, uint64_t Addr, uint64_t Size);
+
+  sys::Mutex Mutex;
+  uint32_t Pid;
+  uint64_t CodeIndex = 0;
+  std::unique_ptr<raw_fd_ostream> PerfMap;
+  std::unique_ptr<raw_fd_ostream> JITDump;
+  // The first page of the jitdump file, mapped executable: perf record only
+  // finds the file through this mapping.
+  void *JITDumpMarker = nullptr;
+  std::map<const char *, OwningBinary<ObjectFile>> DebugObjects;
+};
+
+// perf matches the records with its samples using CLOCK_MONOTONIC, which is
+// what perf record -k 1 uses.
+uint64_t getTimestamp() {
+  struct timespec TS;
+  if (clock_gettime(CLOCK_MONOTONIC, &TS))
+    return 0;
+  return static_cast<uint64_t>(TS.tv_sec) * 1000000000 + TS.tv_nsec;
+}
+
+uint32_t getHostElfMachine() {
+  switch (Triple(sys::getProcessTriple()).getArch()) {
+  case Triple::x86:
+    return ELF::EM_386;
+  case Triple::x86_64:
+    return ELF::EM_X86_64;
+  case Triple::arm:
+  case Triple::armeb:
+  case Triple::thumb:
+  case Triple::thumbeb:
+    return ELF::EM_ARM;
+  case Triple::aarch64:
+  case Triple::aarch64_be:
+    return ELF::EM_AARCH64;
+  case Triple::ppc:
+    return ELF::EM_PPC;
+  case Triple::ppc64:
+  case Triple::ppc64le:
+    return ELF::EM_PPC64;
+  case Triple::mips:
+  case Triple::mipsel:
+  case Triple::mips64:
+  case Triple::mips64el:
+    return ELF::EM_MIPS;
+  case Triple::systemz:
+    return ELF::EM_S390;
+  default:
+    return ELF::EM_NONE;
+  }
+}
+
+PerfJITEventListener::PerfJITEventListener()
+    : Pid(static_cast<uint32_t>(::getpid())) {
+  if (!openPerfMap())
+    LLVM_DEBUG(dbgs() << "Failed to open the perf map: " << sys::StrError()
+                      << "\n");
+  if (!openJITDump())
+    LLVM_DEBUG(dbgs() << "Failed to open the jitdump file: "
+                      << sys::StrError() << "\n");
+}
+
+PerfJITEventListener::~PerfJITEventListener() { closeJITDump(); }
+
+bool PerfJITEventListener::openPerfMap() {
+  SmallString<64> Path;
+  raw_svector_ostream(Path) << "/tmp/perf-" << Pid << ".map";
+  std::error_code EC;
+  PerfMap = llvm::make_unique<raw_fd_ostream>(Path, EC, sys::fs::F_Text);
+  if (EC) {
+    PerfMap.reset();
+    return false;
+  }
+  PerfMap->SetUnbuffered();
+  return true;
+}
+
+bool PerfJITEventListener::openJITDump() {
+  // perf inject looks for files named jit-<pid>.dump. $JITDUMPDIR selects the
+  // directory, which defaults to the temporary directory.
+  SmallString<128> Path;
+  if (const char *Dir = std::getenv("JITDUMPDIR"))
+    Path = Dir;
+  else
+    sys::path::system_temp_directory(/*ErasedOnReboot=*/true, Path);
+  sys::path::append(Path, "jit-" + Twine(Pid) + ".dump");
+
+  int FD;
+  if (sys::fs::openFileForReadWrite(Path, FD, sys::fs::CD_CreateAlways,
+                                    sys::fs::F_None))
+    return false;
+
+  size_t PageSize = sys::Process::getPageSize();
+  void *Marker =
+      ::mmap(nullptr, PageSize, PROT_READ | PROT_EXEC, MAP_PRIVATE, FD, 0);
+  if (Marker == MAP_FAILED) {
+    ::close(FD);
+    return false;
+  }
+  JITDumpMarker = Marker;
+  JITDump = llvm::make_unique<raw_fd_ostream>(FD, /*shouldClose=*/true);
+
+  JITDumpHeader Header;
+  memset(&Header, 0, sizeof(Header));
+  Header.Magic = JITDumpMagic;
+  Header.Version = JITDumpVersion;
+  Header.TotalSize = sizeof(Header);
+  Header.ElfMach = getHostElfMachine();
+  Header.Pid = Pid;
+  Header.Timestamp = getTimestamp();
+  JITDump->write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+  JITDump->flush();
+  return true;
+}
+
+void PerfJITEventListener::closeJITDump() {
+  if (!JITDump)
+    return;
+
+  JITDumpRecordHeader Close;
+  Close.Id = JIT_CODE_CLOSE;
+  Close.TotalSize = sizeof(Close);
+  Close.Timestamp = getTimestamp();
+  JITDump->write(reinterpret_cast<const char *>(&Close), sizeof(Close));
+  JITDump.reset();
+
+  ::munmap(JITDumpMarker, sys::Process::getPageSize());
+  JITDumpMarker = nullptr;
+}
+
+void PerfJITEventListener::NotifyObjectEmitted(
+    const ObjectFile &Obj, const RuntimeDyld::LoadedObjectInfo &L) {
+  if (!PerfMap && !JITDump)
+    return;
+
+  OwningBinary<ObjectFile> DebugObjOwner = L.getObjectForDebug(Obj);
+  const ObjectFile &DebugObj = *DebugObjOwner.getBinary();
+  std::unique_ptr<DIContext> Context = DWARFContext::create(DebugObj);
+
+  MutexGuard Guard(Mutex);
+
+  // Use symbol info to iterate functions in the object.
+  for (const std::pair<SymbolRef, uint64_t> &P : computeSymbolSizes(DebugObj)) {
+    SymbolRef Sym = P.first;
+    if (!Sym.getType() || *Sym.getType() != SymbolRef::ST_Function)
+      continue;
+
+    Expected<StringRef> NameOrErr = Sym.getName();
+    if (!NameOrErr) {
+      consumeError(NameOrErr.takeError());
+      continue;
+    }
+    Expected<uint64_t> AddrOrErr = Sym.getAddress();
+    if (!AddrOrErr) {
+      consumeError(AddrOrErr.takeError());
+      continue;
+    }
+    uint64_t Addr = *AddrOrErr;
+    uint64_t Size = P.second;
+    if (!Size)
+      continue;
+
+    if (PerfMap)
+      writePerfMapEntry(*NameOrErr, Addr, Size);
+
+    if (JITDump) {
+      // The line table has to precede the code it describes.
+      DILineInfoTable Lines = Context->getLineInfoForAddressRange(
+          Addr, Size, DILineInfoSpecifier(
+                          DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath,
+                          DINameKind::None));
+      if (!Lines.empty())
+        writeJITDumpDebugInfo(Addr, Lines);
+      writeJITDumpCodeLoad(*NameOrErr, Addr, Size);
+    }
+  }
+
+  if (JITDump)
+    JITDump->flush();
+
+  DebugObjects[Obj.getData().data()] = std::move(DebugObjOwner);
+}
+
+void PerfJITEventListener::NotifyFreeingObject(const ObjectFile &Obj) {
+  // Neither format can express that code was unloaded: perf attributes the
+  // samples in a reused range to the code loaded there last.
+  MutexGuard Guard(Mutex);
+  DebugObjects.erase(Obj.getData().data());
+}
+
+void PerfJITEventListener::writePerfMapEntry(StringRef Name, uint64_t Addr,
+                                             uint64_t Size) {
+  *PerfMap << format_hex_no_prefix(Addr, 1) << " "
+           << format_hex_no_prefix(Size, 1) << " " << Name << "\n";
+}
+
+void PerfJITEventListener::writeJITDumpDebugInfo(
+    uint64_t Addr, const DILineInfoTable &Lines) {
+  JITDumpDebugInfo Record;
+  Record.Prefix.Id = JIT_CODE_DEBUG_INFO;
+  Record.Prefix.Timestamp = getTimestamp();
+  Record.CodeAddr = Addr;
+  Record.NrEntry = Lines.size();
+
+  size_t TotalSize = sizeof(Record);
+  for (const auto &Line : Lines)
+    TotalSize += sizeof(JITDumpDebugEntry) + Line.second.FileName.size() + 1;
+  Record.Prefix.TotalSize = TotalSize;
+  JITDump->write(reinterpret_cast<const char *>(&Record), sizeof(Record));
+
+  for (const auto &Line : Lines) {
+    JITDumpDebugEntry Entry;
+    Entry.Addr = Line.first;
+    Entry.Line = Line.second.Line;
+    Entry.Discrim = Line.second.Discriminator;
+    JITDump->write(reinterpret_cast<const char *>(&Entry), sizeof(Entry));
+    JITDump->write(Line.second.FileName.c_str(),
+                   Line.second.FileName.size() + 1);
+  }
+}
+
+void PerfJITEventListener::writeJITDumpCodeLoad(StringRef Name, uint64_t Addr,
+                                                uint64_t Size) {
+  JITDumpCodeLoad Record;
+  Record.Prefix.Id = JIT_CODE_LOAD;
+  Record.Prefix.TotalSize = sizeof(Record) + Name.size() + 1 + Size;
+  Record.Prefix.Timestamp = getTimestamp();
+  Record.Pid = Pid;
+  Record.Tid = static_cast<uint32_t>(get_threadid());
+  Record.Vma = Addr;
+  Record.CodeAddr = Addr;
+  Record.CodeSize = Size;
+  Record.CodeIndex = CodeIndex++;
+
+  JITDump->write(reinterpret_cast<const char *>(&Record), sizeof(Record));
+  JITDump->write(Name.data(), Name.size());
+  JITDump->write('\0');
+  JITDump->write(reinterpret_cast<const char *>(Addr), Size);
+}
+
+} // end anonymous namespace
+
+namespace llvm {
+JITEventListener *JITEventListener::createPerfJITEventListener() {
+  return new PerfJITEventListener();
+}
+
+} // namespace llvm
+
+LLVMJITEventListenerRef LLVMCreatePerfJITEventListener(void) {
+  return wrap(JITEventListener::createPerfJITEventListener());
+}
@@ -22,6 +22,7 @@
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MutexGuard.h"
+#include "llvm/Support/Parallel.h"
 
 using namespace llvm;
 using namespace llvm::object;
@@ -131,6 +132,9 @@ void RuntimeDyldImpl::resolveRelocations() {
     ErrorStr = toString(std::move(Err));
   }
 
+  if (ResolveRelocationsInParallel && canResolveRelocationsConcurrently())
+    resolveRelocationsInParallel();
+
   // Iterate over all outstanding relocations
   for (auto it = Relocations.begin(), e = Relocations.end(); it != e; ++it) {
     // The Section here (Sections[i]) refers to the section in which the
@@ -149,6 +153,31 @@ void RuntimeDyldImpl::resolveRelocations() {
                  dumpSectionMemory(Sections[i], "after relocations"););
 }
 
+void RuntimeDyldImpl::resolveRelocationsInParallel() {
+  // Spreading a handful of relocations over threads costs more than it saves.
+  const size_t MinParallelRelocations = 4096;
+
+  std::vector<std::pair<const RelocationEntry *, uint64_t>> Work;
+  for (auto &KV : Relocations) {
+    uint64_t Addr = Sections[KV.first].getLoadAddress();
+    for (const RelocationEntry &RE : KV.second)
+      // Ignore relocations for sections that were not loaded
+      if (Sections[RE.SectionID].getAddress() != nullptr)
+        Work.push_back({&RE, Addr});
+  }
+  if (Work.size() < MinParallelRelocations)
+    return;
+
+  LLVM_DEBUG(dbgs() << "Resolving " << Work.size()
+                    << " relocations in parallel\n");
+  parallel::for_each(
+      parallel::par, Work.begin(), Work.end(),
+      [this](const std::pair<const RelocationEntry *, uint64_t> &R) {
+        resolveRelocation(*R.first, R.second);
+      });
+  Relocations.clear();
+}
+
 void RuntimeDyldImpl::mapSectionAddress(const void *LocalAddress,
                                         uint64_t TargetAddress) {
   MutexGuard locked(lock);
@@ -1121,6 +1150,7 @@ RuntimeDyld::RuntimeDyld(RuntimeDyld::MemoryManager &MemMgr,
   // permissions are applied.
   Dyld = nullptr;
   ProcessAllSections = false;
+  ResolveRelocationsInParallel = false;
   Checker = nullptr;
 }
 
@@ -1177,6 +1207,7 @@ RuntimeDyld::loadObject(const ObjectFile &Obj) {
                ProcessAllSections, Checker);
     else
       report_fatal_error("Incompatible object format!");
+    Dyld->setResolveRelocationsInParallel(ResolveRelocationsInParallel);
   }
 
   if (!Dyld->isCompatibleFile(Obj))
@@ -1897,6 +1897,20 @@ Error RuntimeDyldELF::finalizeLoad(const ObjectFile &Obj,
   return Error::success();
 }
 
+bool RuntimeDyldELF::canResolveRelocationsConcurrently() const {
+  // The x86 and AArch64 relocations only patch the bytes at their offset. The
+  // other targets keep state across relocations, e.g. for MIPS HI/LO pairs.
+  switch (Arch) {
+  case Triple::x86:
+  case Triple::x86_64:
+  case Triple::aarch64:
+  case Triple::aarch64_be:
+    return true;
+  default:
+    return false;
+  }
+}
+
 bool RuntimeDyldELF::isCompatibleFile(const object::ObjectFile &Obj) const {
   return Obj.isELF();
 }
@@ -301,6 +301,10 @@ protected:
   // sections containing relocations should be. Defaults to 'false'.
   bool ProcessAllSections;
 
+  // True if the relocations of the sections may be applied on multiple threads
+  // where the target allows it. Defaults to 'false'.
+  bool ResolveRelocationsInParallel;
+
   // This mutex prevents simultaneously loading objects from two different
   // threads.  This keeps us from having to protect individual data structures
   // and guarantees that section allocation requests to the memory manager
@@ -424,6 +428,14 @@ protected:
   /// \param Value Target symbol address to apply the relocation action
   virtual void resolveRelocation(const RelocationEntry &RE, uint64_t Value) = 0;
 
+  /// Returns true if resolveRelocation only writes to the location of the
+  /// relocation it applies, so that different relocations can be applied
+  /// concurrently.
+  virtual bool canResolveRelocationsConcurrently() const { return false; }
+
+  /// Apply the relocations of the Relocations map on multiple threads.
+  void resolveRelocationsInParallel();
+
   /// Parses one or more object file relocations (some object files use
   ///        relocation pairs) and stores it to Relocations or SymbolRelocations
   ///        (this depends on the object file type).
@@ -470,7 +482,8 @@ public:
   RuntimeDyldImpl(RuntimeDyld::MemoryManager &MemMgr,
                   JITSymbolResolver &Resolver)
     : MemMgr(MemMgr), Resolver(Resolver), Checker(nullptr),
-      ProcessAllSections(false), HasError(false) {
+      ProcessAllSections(false), ResolveRelocationsInParallel(false),
+      HasError(false) {
   }
 
   virtual ~RuntimeDyldImpl();
@@ -479,6 +492,10 @@ public:
     this->ProcessAllSections = ProcessAllSections;
   }
 
+  void setResolveRelocationsInParallel(bool ResolveRelocationsInParallel) {
+    this->ResolveRelocationsInParallel = ResolveRelocationsInParallel;
+  }
+
   void setRuntimeDyldChecker(RuntimeDyldCheckerImpl *Checker) {
     this->Checker = Checker;
   }
@@ -13,6 +13,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Config/config.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/Process.h"
@@ -195,9 +196,27 @@ static sys::MemoryBlock trimBlockToPageSize(sys::MemoryBlock M) {
 std::error_code
 SectionMemoryManager::applyMemoryGroupPermissions(MemoryGroup &MemGroup,
                                                   unsigned Permissions) {
-  for (sys::MemoryBlock &MB : MemGroup.PendingMem)
+  static const size_t PageSize = sys::Process::getPageSize();
+
+  // Protection is applied to whole pages, so pending blocks that share a page
+  // or sit on adjacent pages are protected with a single call.
+  llvm::sort(MemGroup.PendingMem.begin(), MemGroup.PendingMem.end(),
+             [](const sys::MemoryBlock &LHS, const sys::MemoryBlock &RHS) {
+               return LHS.base() < RHS.base();
+             });
+  for (size_t I = 0, E = MemGroup.PendingMem.size(); I != E;) {
+    uintptr_t Start = (uintptr_t)MemGroup.PendingMem[I].base();
+    uintptr_t End = Start + MemGroup.PendingMem[I].size();
+    for (++I; I != E; ++I) {
+      uintptr_t NextStart = (uintptr_t)MemGroup.PendingMem[I].base();
+      if (NextStart > alignTo(End, PageSize))
+        break;
+      End = std::max(End, NextStart + MemGroup.PendingMem[I].size());
+    }
+    sys::MemoryBlock MB((void *)Start, End - Start);
     if (std::error_code EC = MMapper.protectMappedMemory(MB, Permissions))
       return EC;
+  }
 
   MemGroup.PendingMem.clear();
 
@@ -0,0 +1,193 @@
+//===- SlabMemoryMapper.cpp - Slab allocator for JIT memory ---------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a SectionMemoryManager::MemoryMapper that carves the
+// memory of many JITed objects out of large shared slabs.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/SlabMemoryMapper.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Process.h"
+#include <iterator>
+
+using namespace llvm;
+
+static size_t getPageSize() {
+  static const size_t PageSize = sys::Process::getPageSize();
+  return PageSize;
+}
+
+SlabMemoryMapper::SlabMemoryMapper(size_t SlabSize, bool UseHugePages)
+    : SlabSize(alignTo(SlabSize, getPageSize())), UseHugePages(UseHugePages) {}
+
+SlabMemoryMapper::~SlabMemoryMapper() {
+  for (auto &KV : Slabs)
+    sys::Memory::releaseMappedMemory(KV.second->Mem);
+}
+
+sys::MemoryBlock SlabMemoryMapper::allocateMappedMemory(
+    AllocationPurpose Purpose, size_t NumBytes,
+    const sys::MemoryBlock *const NearBlock, unsigned Flags,
+    std::error_code &EC) {
+  EC = std::error_code();
+  if (NumBytes == 0)
+    return sys::MemoryBlock();
+
+  NumBytes = alignTo(NumBytes, getPageSize());
+  if (NumBytes > SlabSize)
+    return sys::Memory::allocateMappedMemory(NumBytes, NearBlock, Flags, EC);
+
+  std::lock_guard<std::mutex> Lock(SlabsMutex);
+
+  // Prefer the slab the previous allocation of this purpose came from, then
+  // the other slabs in address order.
+  sys::MemoryBlock MB;
+  Slab *NearSlab = NearBlock ? getSlabContaining(NearBlock->base()) : nullptr;
+  if (NearSlab && NearSlab->Purpose == Purpose)
+    MB = allocateFromSlab(*NearSlab, NumBytes);
+  for (auto I = Slabs.begin(), E = Slabs.end(); !MB.base() && I != E; ++I)
+    if (I->second->Purpose == Purpose)
+      MB = allocateFromSlab(*I->second, NumBytes);
+
+  if (!MB.base()) {
+    Slab *S = mapSlab(Purpose, EC);
+    if (!S)
+      return sys::MemoryBlock();
+    MB = allocateFromSlab(*S, NumBytes);
+  }
+
+  // Slab memory that isn't handed out is kept read-write.
+  if (Flags != (sys::Memory::MF_READ | sys::Memory::MF_WRITE)) {
+    EC = sys::Memory::protectMappedMemory(MB, Flags);
+    if (EC) {
+      returnToSlab(*getSlabContaining(MB.base()), MB);
+      return sys::MemoryBlock();
+    }
+  }
+  return MB;
+}
+
+std::error_code
+SlabMemoryMapper::protectMappedMemory(const sys::MemoryBlock &Block,
+                                      unsigned Flags) {
+  // Blocks handed out by this mapper are page aligned, so protecting them
+  // never affects memory of another block sharing the slab.
+  return sys::Memory::protectMappedMemory(Block, Flags);
+}
+
+std::error_code SlabMemoryMapper::releaseMappedMemory(sys::MemoryBlock &M) {
+  if (!M.base() || M.size() == 0)
+    return std::error_code();
+
+  std::unique_lock<std::mutex> Lock(SlabsMutex);
+  Slab *S = getSlabContaining(M.base());
+  if (!S) {
+    Lock.unlock();
+    return sys::Memory::releaseMappedMemory(M);
+  }
+
+  if (std::error_code EC = sys::Memory::protectMappedMemory(
+          M, sys::Memory::MF_READ | sys::Memory::MF_WRITE))
+    return EC;
+
+  returnToSlab(*S, M);
+  M = sys::MemoryBlock();
+
+  // Unmap the slab once it's unused, unless it's the last one for its purpose.
+  if (S->FreeBytes == S->Mem.size()) {
+    for (auto &KV : Slabs)
+      if (KV.second.get() != S && KV.second->Purpose == S->Purpose)
+        return unmapSlab(*S);
+  }
+  return std::error_code();
+}
+
+size_t SlabMemoryMapper::getNumSlabs() const {
+  std::lock_guard<std::mutex> Lock(SlabsMutex);
+  return Slabs.size();
+}
+
+sys::MemoryBlock SlabMemoryMapper::allocateFromSlab(Slab &S, size_t NumBytes) {
+  if (S.FreeBytes < NumBytes)
+    return sys::MemoryBlock();
+
+  // First fit: the free ranges are sorted by address, which keeps the
+  // allocations at the start of the slab.
+  for (auto I = S.FreeRanges.begin(), E = S.FreeRanges.end(); I != E; ++I) {
+    if (I->second < NumBytes)
+      continue;
+    uintptr_t Start = I->first;
+    size_t Remaining = I->second - NumBytes;
+    S.FreeRanges.erase(I);
+    if (Remaining)
+      S.FreeRanges[Start + NumBytes] = Remaining;
+    S.FreeBytes -= NumBytes;
+    return sys::MemoryBlock((void *)Start, NumBytes);
+  }
+  return sys::MemoryBlock();
+}
+
+void SlabMemoryMapper::returnToSlab(Slab &S, const sys::MemoryBlock &M) {
+  // Coalesce the block with its neighbouring free ranges.
+  uintptr_t Start = (uintptr_t)M.base();
+  size_t Size = M.size();
+  auto Next = S.FreeRanges.lower_bound(Start);
+  if (Next != S.FreeRanges.begin()) {
+    auto Prev = std::prev(Next);
+    if (Prev->first + Prev->second == Start) {
+      Start = Prev->first;
+      Size += Prev->second;
+      S.FreeRanges.erase(Prev);
+    }
+  }
+  if (Next != S.FreeRanges.end() && Start + Size == Next->first) {
+    Size += Next->second;
+    S.FreeRanges.erase(Next);
+  }
+  S.FreeRanges[Start] = Size;
+  S.FreeBytes += M.size();
+}
+
+SlabMemoryMapper::Slab *SlabMemoryMapper::getSlabContaining(const void *Addr) {
+  auto I = Slabs.upper_bound((uintptr_t)Addr);
+  if (I == Slabs.begin())
+    return nullptr;
+  Slab &S = *std::prev(I)->second;
+  if ((uintptr_t)Addr >= (uintptr_t)S.Mem.base() + S.Mem.size())
+    return nullptr;
+  return &S;
+}
+
+SlabMemoryMapper::Slab *SlabMemoryMapper::mapSlab(AllocationPurpose Purpose,
+                                                  std::error_code &EC) {
+  unsigned Flags = sys::Memory::MF_READ | sys::Memory::MF_WRITE;
+  if (UseHugePages)
+    Flags |= sys::Memory::MF_HUGE_HINT;
+  sys::MemoryBlock Mem =
+      sys::Memory::allocateMappedMemory(SlabSize, nullptr, Flags, EC);
+  if (EC)
+    return nullptr;
+
+  auto S = llvm::make_unique<Slab>();
+  S->Mem = Mem;
+  S->Purpose = Purpose;
+  S->FreeRanges[(uintptr_t)Mem.base()] = Mem.size();
+  S->FreeBytes = Mem.size();
+  Slab *Result = S.get();
+  Slabs[(uintptr_t)Mem.base()] = std::move(S);
+  return Result;
+}
+
+std::error_code SlabMemoryMapper::unmapSlab(Slab &S) {
+  sys::MemoryBlock Mem = S.Mem;
+  Slabs.erase((uintptr_t)Mem.base());
+  return sys::Memory::releaseMappedMemory(Mem);
+}
@@ -13,6 +13,7 @@
 
 #include "llvm/Object/ArchiveWriter.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/Magic.h"
 #include "llvm/IR/LLVMContext.h"
@@ -23,6 +24,7 @@
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/raw_ostream.h"
@@ -370,9 +372,19 @@ static void writeSymbolTable(raw_ostream &Out, object::Archive::Kind Kind,
     Out.write(uint8_t(0));
 }
 
-static Expected<std::vector<unsigned>>
-getSymbols(MemoryBufferRef Buf, raw_ostream &SymNames, bool &HasObject) {
-  std::vector<unsigned> Ret;
+namespace {
+/// The archive symbols of a member.
+struct MemberSymbols {
+  /// The null-terminated names of the symbols.
+  std::string Names;
+  /// The offset of the name of each symbol in Names.
+  std::vector<unsigned> Offsets;
+  bool IsObject = false;
+  std::error_code EC;
+};
+} // namespace
+
+static void getSymbols(MemoryBufferRef Buf, MemberSymbols &Symbols) {
   LLVMContext Context;
 
   Expected<std::unique_ptr<object::SymbolicFile>> ObjOrErr =
@@ -381,35 +393,109 @@ getSymbols(MemoryBufferRef Buf, raw_ostream &SymNames, bool &HasObject) {
   if (!ObjOrErr) {
     // FIXME: check only for "not an object file" errors.
     consumeError(ObjOrErr.takeError());
-    return Ret;
+    return;
   }
 
-  HasObject = true;
+  Symbols.IsObject = true;
+  raw_string_ostream SymNames(Symbols.Names);
   object::SymbolicFile &Obj = *ObjOrErr.get();
   for (const object::BasicSymbolRef &S : Obj.symbols()) {
     if (!isArchiveSymbol(S))
       continue;
-    Ret.push_back(SymNames.tell());
-    if (auto EC = S.printName(SymNames))
-      return errorCodeToError(EC);
+    Symbols.Offsets.push_back(SymNames.tell());
+    if ((Symbols.EC = S.printName(SymNames)))
+      return;
     SymNames << '\0';
   }
+}
+
+// Returns the names of the symbols that the symbol table of the archive in
+// OldArchiveBuf lists for each member, keyed by the start of the member's
+// data. The map is empty if the archive has no usable symbol table.
+static DenseMap<const char *, std::vector<StringRef>>
+getOldMemberSymbols(const MemoryBuffer *OldArchiveBuf) {
+  DenseMap<const char *, std::vector<StringRef>> Ret;
+  if (!OldArchiveBuf)
+    return Ret;
+
+  Error Err = Error::success();
+  object::Archive Old(OldArchiveBuf->getMemBufferRef(), Err);
+  if (Err) {
+    consumeError(std::move(Err));
+    return Ret;
+  }
+  // The members of a thin archive don't live in OldArchiveBuf.
+  if (Old.isThin())
+    return Ret;
+  for (const object::Archive::Symbol &S : Old.symbols()) {
+    Expected<object::Archive::Child> C = S.getMember();
+    if (!C) {
+      consumeError(C.takeError());
+      Ret.clear();
+      return Ret;
+    }
+    Expected<StringRef> Data = C->getBuffer();
+    if (!Data) {
+      consumeError(Data.takeError());
+      Ret.clear();
+      return Ret;
+    }
+    Ret[Data->data()].push_back(S.getName());
+  }
+  return Ret;
+}
+
+// Computes the archive symbols of the members in parallel. The symbols of the
+// members kept from the old archive are taken from its symbol table instead
+// of parsing the members again.
+static std::vector<MemberSymbols>
+computeMemberSymbols(ArrayRef<NewArchiveMember> NewMembers,
+                     const MemoryBuffer *OldArchiveBuf) {
+  DenseMap<const char *, std::vector<StringRef>> OldSymbols =
+      getOldMemberSymbols(OldArchiveBuf);
+
+  std::vector<MemberSymbols> Ret(NewMembers.size());
+  parallel::for_each_n(
+      parallel::par, size_t(0), NewMembers.size(), [&](size_t I) {
+        const NewArchiveMember &M = NewMembers[I];
+        MemberSymbols &Symbols = Ret[I];
+        if (!M.IsNew) {
+          auto It = OldSymbols.find(M.Buf->getBufferStart());
+          if (It != OldSymbols.end()) {
+            Symbols.IsObject = true;
+            for (StringRef Name : It->second) {
+              Symbols.Offsets.push_back(Symbols.Names.size());
+              Symbols.Names += Name;
+              Symbols.Names += '\0';
+            }
+            return;
+          }
+        }
+        getSymbols(M.Buf->getMemBufferRef(), Symbols);
+      });
   return Ret;
 }
 
 static Expected<std::vector<MemberData>>
 computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
                   object::Archive::Kind Kind, bool Thin, StringRef ArcName,
-                  ArrayRef<NewArchiveMember> NewMembers) {
+                  ArrayRef<NewArchiveMember> NewMembers, bool WriteSymtab,
+                  const MemoryBuffer *OldArchiveBuf) {
   static char PaddingData[8] = {'\n', '\n', '\n', '\n', '\n', '\n', '\n', '\n'};
 
   // This ignores the symbol table, but we only need the value mod 8 and the
   // symbol table is aligned to be a multiple of 8 bytes
   uint64_t Pos = 0;
 
+  // The symbols are only needed for the symbol table.
+  std::vector<MemberSymbols> Symbols;
+  if (WriteSymtab)
+    Symbols = computeMemberSymbols(NewMembers, OldArchiveBuf);
+
   std::vector<MemberData> Ret;
   bool HasObject = false;
-  for (const NewArchiveMember &M : NewMembers) {
+  for (size_t I = 0, E = NewMembers.size(); I != E; ++I) {
+    const NewArchiveMember &M = NewMembers[I];
     std::string Header;
     raw_string_ostream Out(Header);
 
@@ -430,13 +516,21 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
                       Buf.getBufferSize() + MemberPadding);
     Out.flush();
 
-    Expected<std::vector<unsigned>> Symbols =
-        getSymbols(Buf, SymNames, HasObject);
-    if (auto E = Symbols.takeError())
-      return std::move(E);
+    std::vector<unsigned> SymbolOffsets;
+    if (WriteSymtab) {
+      MemberSymbols &MS = Symbols[I];
+      if (MS.EC)
+        return errorCodeToError(MS.EC);
+      HasObject |= MS.IsObject;
+      uint64_t Base = SymNames.tell();
+      for (unsigned Offset : MS.Offsets)
+        SymbolOffsets.push_back(Base + Offset);
+      SymNames << MS.Names;
+      std::string().swap(MS.Names);
+    }
 
     Pos += Header.size() + Data.size() + Padding.size();
-    Ret.push_back({std::move(*Symbols), std::move(Header), Data, Padding});
+    Ret.push_back({std::move(SymbolOffsets), std::move(Header), Data, Padding});
   }
   // If there are no symbols, emit an empty symbol table, to satisfy Solaris
   // tools, older versions of which expect a symbol table in a non-empty
@@ -459,7 +553,8 @@ Error llvm::writeArchive(StringRef ArcName,
   raw_svector_ostream StringTable(StringTableBuf);
 
   Expected<std::vector<MemberData>> DataOrErr =
-      computeMemberData(StringTable, SymNames, Kind, Thin, ArcName, NewMembers);
+      computeMemberData(StringTable, SymNames, Kind, Thin, ArcName, NewMembers,
+                        WriteSymtab, OldArchiveBuf.get());
   if (Error E = DataOrErr.takeError())
     return E;
   std::vector<MemberData> &Data = *DataOrErr;
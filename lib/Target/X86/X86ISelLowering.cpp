@@ -31960,23 +31960,23 @@ static bool detectZextAbsDiff(const SDValue &Select, SDValue &Op0,
   return true;
 }
 
-// Given two zexts of <k x i8> to <k x i32>, create a PSADBW of the inputs
-// to these zexts.
-static SDValue createPSADBW(SelectionDAG &DAG, const SDValue &Zext0,
-                            const SDValue &Zext1, const SDLoc &DL,
+// Given two <k x i8> vectors (typically the inputs to zexts to <k x i32>),
+// create a PSADBW of them.
+static SDValue createPSADBW(SelectionDAG &DAG, const SDValue &Op0,
+                            const SDValue &Op1, const SDLoc &DL,
                             const X86Subtarget &Subtarget) {
   // Find the appropriate width for the PSADBW.
-  EVT InVT = Zext0.getOperand(0).getValueType();
+  EVT InVT = Op0.getValueType();
   unsigned RegSize = std::max(128u, InVT.getSizeInBits());
 
   // "Zero-extend" the i8 vectors. This is not a per-element zext, rather we
   // fill in the missing vector elements with 0.
   unsigned NumConcat = RegSize / InVT.getSizeInBits();
   SmallVector<SDValue, 16> Ops(NumConcat, DAG.getConstant(0, DL, InVT));
-  Ops[0] = Zext0.getOperand(0);
+  Ops[0] = Op0;
   MVT ExtendedVT = MVT::getVectorVT(MVT::i8, RegSize / 8);
   SDValue SadOp0 = DAG.getNode(ISD::CONCAT_VECTORS, DL, ExtendedVT, Ops);
-  Ops[0] = Zext1.getOperand(0);
+  Ops[0] = Op1;
   SDValue SadOp1 = DAG.getNode(ISD::CONCAT_VECTORS, DL, ExtendedVT, Ops);
 
   // Actually build the SAD, split as 128/256/512 bits for SSE/AVX2/AVX512BW.
@@ -32168,33 +32168,45 @@ static SDValue combineBasicSADPattern(SDNode *Extract, SelectionDAG &DAG,
   // Match shuffle + add pyramid.
   unsigned BinOp = 0;
   SDValue Root = matchBinOpReduction(Extract, BinOp, {ISD::ADD});
-
-  // The operand is expected to be zero extended from i8
-  // (verified in detectZextAbsDiff).
-  // In order to convert to i64 and above, additional any/zero/sign
-  // extend is expected.
-  // The zero extend from 32 bit has no mathematical effect on the result.
-  // Also the sign extend is basically zero extend
-  // (extends the sign bit which is zero).
-  // So it is correct to skip the sign/zero extend instruction.
-  if (Root && (Root.getOpcode() == ISD::SIGN_EXTEND ||
-    Root.getOpcode() == ISD::ZERO_EXTEND ||
-    Root.getOpcode() == ISD::ANY_EXTEND))
-    Root = Root.getOperand(0);
-
-  // If there was a match, we want Root to be a select that is the root of an
-  // abs-diff pattern.
-  if (!Root || (Root.getOpcode() != ISD::VSELECT))
+  if (!Root)
     return SDValue();
 
-  // Check whether we have an abs-diff pattern feeding into the select.
-  SDValue Zext0, Zext1;
-  if (!detectZextAbsDiff(Root, Zext0, Zext1))
-    return SDValue();
+  SDLoc DL(Extract);
+  SDValue SadOp0, SadOp1;
+  if (Root.getOpcode() == ISD::ZERO_EXTEND &&
+      Root.getOperand(0).getValueType().getVectorElementType() == MVT::i8) {
+    // A plain sum of zero extended bytes is the SAD of the bytes and a zero
+    // vector.
+    SadOp0 = Root.getOperand(0);
+    SadOp1 = DAG.getConstant(0, DL, SadOp0.getValueType());
+  } else {
+    // The operand is expected to be zero extended from i8
+    // (verified in detectZextAbsDiff).
+    // In order to convert to i64 and above, additional any/zero/sign
+    // extend is expected.
+    // The zero extend from 32 bit has no mathematical effect on the result.
+    // Also the sign extend is basically zero extend
+    // (extends the sign bit which is zero).
+    // So it is correct to skip the sign/zero extend instruction.
+    if (Root.getOpcode() == ISD::SIGN_EXTEND ||
+        Root.getOpcode() == ISD::ZERO_EXTEND ||
+        Root.getOpcode() == ISD::ANY_EXTEND)
+      Root = Root.getOperand(0);
+
+    // We want Root to be a select that is the root of an abs-diff pattern.
+    if (Root.getOpcode() != ISD::VSELECT)
+      return SDValue();
+
+    // Check whether we have an abs-diff pattern feeding into the select.
+    SDValue Zext0, Zext1;
+    if (!detectZextAbsDiff(Root, Zext0, Zext1))
+      return SDValue();
+    SadOp0 = Zext0.getOperand(0);
+    SadOp1 = Zext1.getOperand(0);
+  }
 
   // Create the SAD instruction.
-  SDLoc DL(Extract);
-  SDValue SAD = createPSADBW(DAG, Zext0, Zext1, DL, Subtarget);
+  SDValue SAD = createPSADBW(DAG, SadOp0, SadOp1, DL, Subtarget);
 
   // If the original vector was wider than 8 elements, sum over the results
   // in the SAD vector.
@@ -38677,7 +38689,8 @@ static SDValue combineLoopSADPattern(SDNode *N, SelectionDAG &DAG,
   // reduction. Note that the number of elements of the result of SAD is less
   // than the number of elements of its input. Therefore, we could only update
   // part of elements in the reduction vector.
-  SDValue Sad = createPSADBW(DAG, Op0, Op1, DL, Subtarget);
+  SDValue Sad =
+      createPSADBW(DAG, Op0.getOperand(0), Op1.getOperand(0), DL, Subtarget);
 
   // The output of PSADBW is a vector of i64.
   // We need to turn the vector of i64 into a vector of i32.
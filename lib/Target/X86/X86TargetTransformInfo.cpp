@@ -2200,6 +2200,39 @@ int X86TTIImpl::getMinMaxReductionCost(Type *ValTy, Type *CondTy,
   return BaseT::getMinMaxReductionCost(ValTy, CondTy, IsPairwise, IsUnsigned);
 }
 
+int X86TTIImpl::getExtendedAddReductionCost(bool IsUnsigned, Type *ResTy,
+                                            Type *ValTy, bool IsPairwise) {
+  // A split-form add reduction of zero extended bytes is lowered to PSADBW
+  // against a zero vector (see combineBasicSADPattern), which sums eight bytes
+  // per i64 lane, followed by a short reduction of the i64 partial sums.
+  unsigned NumElts = ValTy->getVectorNumElements();
+  unsigned RegSize = 128;
+  if (ST->useBWIRegs())
+    RegSize = 512;
+  else if (ST->hasAVX())
+    RegSize = 256;
+  if (IsUnsigned && !IsPairwise && ST->hasSSE2() &&
+      ValTy->getScalarSizeInBits() == 8 && ResTy->getScalarSizeInBits() > 16 &&
+      isPowerOf2_32(NumElts) && RegSize / NumElts >= 8) {
+    // One PSADBW per 128-bit chunk of input bytes, leaving one i64 partial
+    // sum per 8 bytes.
+    int Cost = std::max(1u, NumElts / 16);
+    unsigned NumPartialSums = std::max(1u, NumElts / 8);
+    Type *I64Ty = Type::getInt64Ty(ValTy->getContext());
+    if (NumPartialSums > 1)
+      Cost += getArithmeticReductionCost(
+          Instruction::Add, VectorType::get(I64Ty, NumPartialSums),
+          /*IsPairwise=*/false);
+    else
+      Cost += getVectorInstrCost(Instruction::ExtractElement,
+                                 VectorType::get(I64Ty, 2), 0);
+    return Cost;
+  }
+
+  return BaseT::getExtendedAddReductionCost(IsUnsigned, ResTy, ValTy,
+                                            IsPairwise);
+}
+
 /// Calculate the cost of materializing a 64-bit value. This helper
 /// method might only calculate a fraction of a larger immediate. Therefore it
 /// is valid to return a cost of ZERO.
@@ -99,6 +99,9 @@ public:
   int getMinMaxReductionCost(Type *Ty, Type *CondTy, bool IsPairwiseForm,
                              bool IsUnsigned);
 
+  int getExtendedAddReductionCost(bool IsUnsigned, Type *ResTy, Type *Ty,
+                                  bool IsPairwiseForm);
+
   int getInterleavedMemoryOpCost(unsigned Opcode, Type *VecTy,
                                  unsigned Factor, ArrayRef<unsigned> Indices,
                                  unsigned Alignment, unsigned AddressSpace);
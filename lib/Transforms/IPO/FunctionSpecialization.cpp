@@ -0,0 +1,302 @@
+//===- FunctionSpecialization.cpp - Specialize functions ------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This pass clones functions for call sites passing constant arguments that
+// the callee can take advantage of: function pointers used as the callee of an
+// indirect call, and integers compared or switched on. Call sites passing the
+// same constants share a clone. The inline cost of the call site, which models
+// the simplifications enabled by the constant arguments, bounds the size of the
+// clone.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Transforms/IPO/FunctionSpecialization.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/InlineCost.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/ProfileSummaryInfo.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/IR/CallSite.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DiagnosticInfo.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Transforms/IPO.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/ValueMapper.h"
+#include <functional>
+#include <utility>
+
+using namespace llvm;
+
+#define DEBUG_TYPE "function-specialization"
+
+STATISTIC(NumSpecsCreated, "Number of specialized functions created");
+STATISTIC(NumCallSitesSpecialized,
+          "Number of call sites redirected to a specialized function");
+
+static cl::opt<unsigned> FuncSpecMaxClones(
+    "func-spec-max-clones", cl::init(3), cl::Hidden,
+    cl::desc("The maximum number of specialized clones of a single function"));
+
+static cl::opt<int> FuncSpecThreshold(
+    "func-spec-threshold", cl::init(250), cl::Hidden,
+    cl::desc("The inline cost threshold bounding the size of a specialized "
+             "function"));
+
+namespace {
+
+/// The constant arguments of a specialization, one entry per formal argument.
+/// Arguments that are not specialized have a null entry.
+using SpecializationKey = SmallVector<Constant *, 4>;
+
+class FunctionSpecializer {
+public:
+  FunctionSpecializer(
+      std::function<AssumptionCache &(Function &)> &GetAssumptionCache,
+      function_ref<TargetTransformInfo &(Function &)> GetTTI,
+      ProfileSummaryInfo *PSI)
+      : GetAssumptionCache(GetAssumptionCache), GetTTI(GetTTI), PSI(PSI) {}
+
+  bool run(Module &M);
+
+private:
+  std::function<AssumptionCache &(Function &)> &GetAssumptionCache;
+  function_ref<TargetTransformInfo &(Function &)> GetTTI;
+  ProfileSummaryInfo *PSI;
+
+  bool specializeFunction(Function &F);
+  Function *createSpecialization(Function &F, const SpecializationKey &Key);
+};
+
+} // end anonymous namespace
+
+/// Returns true if \p A benefits from being replaced by the constant \p C.
+static bool isSpecializableArgument(Argument &A, Constant *C) {
+  if (isa<Function>(C->stripPointerCasts())) {
+    // The argument is called, so the specialization turns an indirect call
+    // into a direct one.
+    return llvm::any_of(A.uses(), [](Use &U) {
+      CallSite CS(U.getUser());
+      return CS && CS.isCallee(&U);
+    });
+  }
+  if (isa<ConstantInt>(C)) {
+    // The argument is compared or switched on, so the specialization can fold
+    // away control flow.
+    return llvm::any_of(A.users(), [](User *U) {
+      return isa<ICmpInst>(U) || isa<SwitchInst>(U);
+    });
+  }
+  return false;
+}
+
+static bool isCandidateFunction(Function &F) {
+  return !F.isDeclaration() && F.hasExactDefinition() && !F.isVarArg() &&
+         !F.hasFnAttribute(Attribute::OptimizeNone) && !F.optForSize() &&
+         !F.hasFnAttribute(Attribute::NoInline) && !F.arg_empty();
+}
+
+Function *FunctionSpecializer::createSpecialization(
+    Function &F, const SpecializationKey &Key) {
+  ValueToValueMapTy VMap;
+  Function *Clone = CloneFunction(&F, VMap);
+  Clone->setName(F.getName() + ".specialized");
+  Clone->setLinkage(GlobalValue::InternalLinkage);
+  Clone->setComdat(nullptr);
+
+  // Replace the specialized arguments by their constants. The signature is kept
+  // so the call sites only need a new callee.
+  for (Argument &A : Clone->args())
+    if (Constant *C = Key[A.getArgNo()])
+      A.replaceAllUsesWith(C);
+  return Clone;
+}
+
+bool FunctionSpecializer::specializeFunction(Function &F) {
+  // Group the direct call sites of F by the constants they pass.
+  SmallVector<std::pair<SpecializationKey, SmallVector<CallSite, 4>>, 4> Specs;
+  for (Use &U : F.uses()) {
+    CallSite CS(U.getUser());
+    if (!CS || !CS.isCallee(&U) || CS.getCaller() == &F ||
+        CS.getFunctionType() != F.getFunctionType())
+      continue;
+
+    SpecializationKey Key(F.arg_size(), nullptr);
+    bool HasConstantArg = false;
+    for (Argument &A : F.args()) {
+      auto *C = dyn_cast<Constant>(CS.getArgument(A.getArgNo()));
+      if (C && isSpecializableArgument(A, C)) {
+        Key[A.getArgNo()] = C;
+        HasConstantArg = true;
+      }
+    }
+    if (!HasConstantArg)
+      continue;
+
+    auto It = llvm::find_if(Specs, [&Key](const decltype(Specs)::value_type &S) {
+      return S.first == Key;
+    });
+    if (It == Specs.end())
+      Specs.push_back({Key, {CS}});
+    else
+      It->second.push_back(CS);
+  }
+
+  bool Changed = false;
+  unsigned NumClones = 0;
+  for (auto &Spec : Specs) {
+    if (NumClones == FuncSpecMaxClones)
+      break;
+
+    // The inline cost of a call site accounts for the instructions that are
+    // simplified by its constant arguments, which makes it a good estimate of
+    // the size of the specialized function.
+    CallSite FirstCS = Spec.second.front();
+    Function *Caller = FirstCS.getCaller();
+    OptimizationRemarkEmitter ORE(Caller);
+    InlineCost IC =
+        getInlineCost(FirstCS, &F, getInlineParams(FuncSpecThreshold),
+                      GetTTI(F), GetAssumptionCache, None, PSI, &ORE);
+    // Functions that are always inlined don't need a specialization.
+    if (IC.isAlways() || !IC) {
+      LLVM_DEBUG(dbgs() << "FnSpecialization: Not specializing " << F.getName()
+                        << " for call in " << Caller->getName()
+                        << ": too expensive\n");
+      ORE.emit([&]() {
+        return OptimizationRemarkMissed(DEBUG_TYPE, "TooCostly",
+                                        FirstCS.getInstruction())
+               << "Not specializing " << ore::NV("Callee", &F)
+               << ": specialization is too costly";
+      });
+      continue;
+    }
+
+    Function *Clone = createSpecialization(F, Spec.first);
+    for (CallSite CS : Spec.second)
+      CS.setCalledFunction(Clone);
+    LLVM_DEBUG(dbgs() << "FnSpecialization: Created " << Clone->getName()
+                      << " for " << Spec.second.size() << " call sites\n");
+    ORE.emit([&]() {
+      return OptimizationRemark(DEBUG_TYPE, "Specialized",
+                                FirstCS.getInstruction())
+             << "Specialized " << ore::NV("Callee", &F) << " into "
+             << ore::NV("Specialization", Clone) << " for "
+             << ore::NV("NumCallSites", unsigned(Spec.second.size()))
+             << " call sites";
+    });
+    ++NumSpecsCreated;
+    NumCallSitesSpecialized += Spec.second.size();
+    ++NumClones;
+    Changed = true;
+  }
+  return Changed;
+}
+
+bool FunctionSpecializer::run(Module &M) {
+  // Collect the candidates upfront so the specializations are not specialized
+  // again.
+  SmallVector<Function *, 16> Worklist;
+  for (Function &F : M)
+    if (isCandidateFunction(F))
+      Worklist.push_back(&F);
+
+  bool Changed = false;
+  for (Function *F : Worklist) {
+    if (!specializeFunction(*F))
+      continue;
+    Changed = true;
+    // The original function is dead if all of its call sites were redirected.
+    if (F->hasLocalLinkage() && F->use_empty())
+      F->eraseFromParent();
+  }
+  return Changed;
+}
+
+namespace {
+
+struct FunctionSpecializationLegacyPass : public ModulePass {
+  static char ID; // Pass identification, replacement for typeid
+
+  FunctionSpecializationLegacyPass() : ModulePass(ID) {
+    initializeFunctionSpecializationLegacyPassPass(
+        *PassRegistry::getPassRegistry());
+  }
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override {
+    AU.addRequired<AssumptionCacheTracker>();
+    AU.addRequired<ProfileSummaryInfoWrapperPass>();
+    AU.addRequired<TargetTransformInfoWrapperPass>();
+  }
+
+  bool runOnModule(Module &M) override {
+    if (skipModule(M))
+      return false;
+
+    AssumptionCacheTracker *ACT = &getAnalysis<AssumptionCacheTracker>();
+    TargetTransformInfoWrapperPass *TTIWP =
+        &getAnalysis<TargetTransformInfoWrapperPass>();
+    ProfileSummaryInfo *PSI =
+        getAnalysis<ProfileSummaryInfoWrapperPass>().getPSI();
+
+    std::function<AssumptionCache &(Function &)> GetAssumptionCache =
+        [&ACT](Function &F) -> AssumptionCache & {
+      return ACT->getAssumptionCache(F);
+    };
+    auto GetTTI = [&TTIWP](Function &F) -> TargetTransformInfo & {
+      return TTIWP->getTTI(F);
+    };
+
+    return FunctionSpecializer(GetAssumptionCache, GetTTI, PSI).run(M);
+  }
+};
+
+} // end anonymous namespace
+
+char FunctionSpecializationLegacyPass::ID = 0;
+
+INITIALIZE_PASS_BEGIN(FunctionSpecializationLegacyPass,
+                      "function-specialization",
+                      "Specialize functions for constant arguments", false,
+                      false)
+INITIALIZE_PASS_DEPENDENCY(AssumptionCacheTracker)
+INITIALIZE_PASS_DEPENDENCY(ProfileSummaryInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(TargetTransformInfoWrapperPass)
+INITIALIZE_PASS_END(FunctionSpecializationLegacyPass, "function-specialization",
+                    "Specialize functions for constant arguments", false,
+                    false)
+
+ModulePass *llvm::createFunctionSpecializationPass() {
+  return new FunctionSpecializationLegacyPass();
+}
+
+PreservedAnalyses FunctionSpecializationPass::run(Module &M,
+                                                  ModuleAnalysisManager &AM) {
+  auto &FAM = AM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager();
+
+  std::function<AssumptionCache &(Function &)> GetAssumptionCache =
+      [&FAM](Function &F) -> AssumptionCache & {
+    return FAM.getResult<AssumptionAnalysis>(F);
+  };
+  auto GetTTI = [&FAM](Function &F) -> TargetTransformInfo & {
+    return FAM.getResult<TargetIRAnalysis>(F);
+  };
+  ProfileSummaryInfo *PSI = &AM.getResult<ProfileSummaryAnalysis>(M);
+
+  if (!FunctionSpecializer(GetAssumptionCache, GetTTI, PSI).run(M))
+    return PreservedAnalyses::all();
+  return PreservedAnalyses::none();
+}
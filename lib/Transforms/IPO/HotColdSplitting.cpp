@@ -0,0 +1,265 @@
+//===- HotColdSplitting.cpp - Outline cold regions ------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This pass uses the profile summary and block frequencies to find regions of
+// cold blocks, and outlines them with the CodeExtractor into functions placed
+// in the .text.unlikely section. A region is a single-entry set of cold blocks
+// dominated by its entry; the outlined functions are marked cold and noinline
+// so that later passes keep them out of the hot code.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Transforms/IPO/HotColdSplitting.h"
+#include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/BlockFrequencyInfo.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/ProfileSummaryInfo.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/CFG.h"
+#include "llvm/IR/DiagnosticInfo.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Transforms/IPO.h"
+#include "llvm/Transforms/Utils/CodeExtractor.h"
+
+using namespace llvm;
+
+#define DEBUG_TYPE "hotcoldsplit"
+
+STATISTIC(NumColdRegionsOutlined, "Number of cold regions outlined");
+
+static cl::opt<unsigned> MinOutliningSize(
+    "hotcoldsplit-threshold", cl::init(3), cl::Hidden,
+    cl::desc("The minimum number of instructions of an outlined cold region"));
+
+namespace {
+
+using ColdRegion = SmallVector<BasicBlock *, 8>;
+
+class HotColdSplitting {
+public:
+  HotColdSplitting(ProfileSummaryInfo *PSI,
+                   function_ref<BlockFrequencyInfo *(Function &)> GetBFI)
+      : PSI(PSI), GetBFI(GetBFI) {}
+
+  bool run(Module &M);
+
+private:
+  ProfileSummaryInfo *PSI;
+  function_ref<BlockFrequencyInfo *(Function &)> GetBFI;
+
+  bool shouldSplitFunction(Function &F);
+  void findColdRegions(Function &F, BlockFrequencyInfo &BFI,
+                       SmallVectorImpl<ColdRegion> &Regions);
+  Function *outlineColdRegion(Function &F, ArrayRef<BasicBlock *> Region);
+};
+
+} // end anonymous namespace
+
+bool HotColdSplitting::shouldSplitFunction(Function &F) {
+  if (F.isDeclaration() || F.hasFnAttribute(Attribute::OptimizeNone) ||
+      F.hasFnAttribute(Attribute::Naked))
+    return false;
+  // Splitting a function that is cold as a whole doesn't shrink hot code.
+  if (!F.getEntryCount() || PSI->isFunctionEntryCold(&F))
+    return false;
+  // Don't split functions with EH personalities or funclets; outlining parts
+  // of them would require duplicating the personality.
+  return !F.hasPersonalityFn();
+}
+
+/// Returns the number of instructions of \p Region worth outlining, or zero if
+/// the region can't be outlined.
+static unsigned getOutliningSize(ArrayRef<BasicBlock *> Region) {
+  unsigned Size = 0;
+  for (BasicBlock *BB : Region) {
+    // Returning from the caller can't be expressed by the outlined function.
+    if (isa<ReturnInst>(BB->getTerminator()))
+      return 0;
+    for (Instruction &I : *BB) {
+      if (isa<PHINode>(I) || isa<DbgInfoIntrinsic>(I))
+        continue;
+      if (isa<AllocaInst>(I))
+        return 0;
+      ++Size;
+    }
+  }
+  return Size;
+}
+
+void HotColdSplitting::findColdRegions(Function &F, BlockFrequencyInfo &BFI,
+                                       SmallVectorImpl<ColdRegion> &Regions) {
+  DominatorTree DT(F);
+  SmallPtrSet<BasicBlock *, 32> Visited;
+  ReversePostOrderTraversal<Function *> RPOT(&F);
+  for (BasicBlock *Entry : RPOT) {
+    if (Entry == &F.getEntryBlock() || Visited.count(Entry) ||
+        !PSI->isColdBB(Entry, &BFI) || Entry->isEHPad())
+      continue;
+
+    // Collect the cold blocks dominated by the region entry, then drop the
+    // blocks that can be entered from outside the region until it has a single
+    // entry.
+    SetVector<BasicBlock *> Region;
+    SmallVector<BasicBlock *, 8> Worklist(1, Entry);
+    while (!Worklist.empty()) {
+      BasicBlock *BB = Worklist.pop_back_val();
+      if (Visited.count(BB) || !DT.dominates(Entry, BB) ||
+          !PSI->isColdBB(BB, &BFI) || !Region.insert(BB))
+        continue;
+      for (BasicBlock *Succ : successors(BB))
+        Worklist.push_back(Succ);
+    }
+    bool Changed = true;
+    while (Changed) {
+      Changed = false;
+      for (BasicBlock *BB : Region) {
+        if (BB == Entry)
+          continue;
+        if (llvm::any_of(predecessors(BB), [&Region](BasicBlock *Pred) {
+              return !Region.count(Pred);
+            })) {
+          Region.remove(BB);
+          Changed = true;
+          break;
+        }
+      }
+    }
+
+    for (BasicBlock *BB : Region)
+      Visited.insert(BB);
+    if (getOutliningSize(Region.getArrayRef()) < MinOutliningSize)
+      continue;
+    Regions.emplace_back(Region.begin(), Region.end());
+  }
+}
+
+Function *HotColdSplitting::outlineColdRegion(Function &F,
+                                              ArrayRef<BasicBlock *> Region) {
+  DominatorTree DT(F);
+  CodeExtractor CE(Region, &DT);
+  if (!CE.isEligible())
+    return nullptr;
+  Function *OutF = CE.extractCodeRegion();
+  if (!OutF)
+    return nullptr;
+
+  // Keep the outlined function out of the hot code: place it in the
+  // .text.unlikely section and don't let the inliner undo the split.
+  OutF->addFnAttr(Attribute::Cold);
+  OutF->addFnAttr(Attribute::NoInline);
+  OutF->addFnAttr(Attribute::MinSize);
+  OutF->setSectionPrefix(".unlikely");
+  for (User *U : OutF->users())
+    if (auto *CI = dyn_cast<CallInst>(U))
+      CI->setIsNoInline();
+  return OutF;
+}
+
+bool HotColdSplitting::run(Module &M) {
+  if (!PSI->hasProfileSummary())
+    return false;
+
+  SmallVector<Function *, 16> Worklist;
+  for (Function &F : M)
+    if (shouldSplitFunction(F))
+      Worklist.push_back(&F);
+
+  bool Changed = false;
+  for (Function *F : Worklist) {
+    SmallVector<ColdRegion, 4> Regions;
+    findColdRegions(*F, *GetBFI(*F), Regions);
+    // The regions are disjoint, so extracting one region leaves the blocks of
+    // the others intact.
+    for (ColdRegion &Region : Regions) {
+      OptimizationRemarkEmitter ORE(F);
+      Function *OutF = outlineColdRegion(*F, Region);
+      if (!OutF) {
+        LLVM_DEBUG(dbgs() << "HotColdSplitting: Failed to outline region in "
+                          << F->getName() << "\n");
+        continue;
+      }
+      LLVM_DEBUG(dbgs() << "HotColdSplitting: Outlined " << OutF->getName()
+                        << " from " << F->getName() << "\n");
+      ORE.emit([&]() {
+        return OptimizationRemark(DEBUG_TYPE, "Outlined",
+                                  cast<Instruction>(OutF->user_back()))
+               << "Outlined cold region into " << ore::NV("Outlined", OutF);
+      });
+      ++NumColdRegionsOutlined;
+      Changed = true;
+    }
+  }
+  return Changed;
+}
+
+namespace {
+
+struct HotColdSplittingLegacyPass : public ModulePass {
+  static char ID; // Pass identification, replacement for typeid
+
+  HotColdSplittingLegacyPass() : ModulePass(ID) {
+    initializeHotColdSplittingLegacyPassPass(*PassRegistry::getPassRegistry());
+  }
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override {
+    AU.addRequired<BlockFrequencyInfoWrapperPass>();
+    AU.addRequired<ProfileSummaryInfoWrapperPass>();
+  }
+
+  bool runOnModule(Module &M) override {
+    if (skipModule(M))
+      return false;
+
+    ProfileSummaryInfo *PSI =
+        getAnalysis<ProfileSummaryInfoWrapperPass>().getPSI();
+    auto GetBFI = [this](Function &F) {
+      return &this->getAnalysis<BlockFrequencyInfoWrapperPass>(F).getBFI();
+    };
+    return HotColdSplitting(PSI, GetBFI).run(M);
+  }
+};
+
+} // end anonymous namespace
+
+char HotColdSplittingLegacyPass::ID = 0;
+
+INITIALIZE_PASS_BEGIN(HotColdSplittingLegacyPass, "hotcoldsplit",
+                      "Hot Cold Splitting", false, false)
+INITIALIZE_PASS_DEPENDENCY(BlockFrequencyInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(ProfileSummaryInfoWrapperPass)
+INITIALIZE_PASS_END(HotColdSplittingLegacyPass, "hotcoldsplit",
+                    "Hot Cold Splitting", false, false)
+
+ModulePass *llvm::createHotColdSplittingPass() {
+  return new HotColdSplittingLegacyPass();
+}
+
+PreservedAnalyses HotColdSplittingPass::run(Module &M,
+                                            ModuleAnalysisManager &AM) {
+  auto &FAM = AM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager();
+  auto GetBFI = [&FAM](Function &F) {
+    return &FAM.getResult<BlockFrequencyAnalysis>(F);
+  };
+  ProfileSummaryInfo *PSI = &AM.getResult<ProfileSummaryAnalysis>(M);
+
+  if (!HotColdSplitting(PSI, GetBFI).run(M))
+    return PreservedAnalyses::all();
+  return PreservedAnalyses::none();
+}
@@ -49,6 +49,15 @@ static cl::opt<bool>
     RunPartialInlining("enable-partial-inlining", cl::init(false), cl::Hidden,
                        cl::ZeroOrMore, cl::desc("Run Partial inlinining pass"));
 
+static cl::opt<bool> EnableHotColdSplit(
+    "enable-hot-cold-split", cl::init(false), cl::Hidden, cl::ZeroOrMore,
+    cl::desc("Enable hot-cold splitting pass (default = off)"));
+
+static cl::opt<bool> EnableFunctionSpecialization(
+    "enable-function-specialization", cl::init(false), cl::Hidden,
+    cl::ZeroOrMore,
+    cl::desc("Enable the function specialization pass (default = off)"));
+
 static cl::opt<bool>
     RunLoopVectorization("vectorize-loops", cl::Hidden,
                          cl::desc("Run the Loop vectorization passes"));
@@ -495,6 +504,8 @@ void PassManagerBuilder::populateModulePassManager(
     MPM.add(createCallSiteSplittingPass());
 
   MPM.add(createIPSCCPPass());          // IP SCCP
+  if (EnableFunctionSpecialization && OptLevel > 2)
+    MPM.add(createFunctionSpecializationPass());
   MPM.add(createCalledValuePropagationPass());
   MPM.add(createGlobalOptimizerPass()); // Optimize out global vars
   // Promote any localized global vars.
@@ -543,6 +554,10 @@ void PassManagerBuilder::populateModulePassManager(
   if (RunPartialInlining)
     MPM.add(createPartialInliningPass());
 
+  // Outline cold regions after the inliner has seen the whole functions.
+  if (EnableHotColdSplit && !PrepareForLTO && !PrepareForThinLTO)
+    MPM.add(createHotColdSplittingPass());
+
   if (OptLevel > 1 && !PrepareForLTO && !PrepareForThinLTO)
     // Remove avail extern fns and globals definitions if we aren't
     // compiling an object file for later LTO. For LTO we want to preserve
@@ -5422,6 +5422,10 @@ class HorizontalReduction {
   /// splits the vector in halves and adds those halves.
   bool IsPairwiseReduction = false;
 
+  /// Should we build the tree over the operands of the extended reduced values
+  /// and fold the extension into the reduction, e.g. PSADBW on X86.
+  bool IsWideningReduction = false;
+
   /// Checks if the ParentStackElem.first should be marked as a reduction
   /// operation with an extra argument or as extra argument itself.
   void markExtraArg(std::pair<Instruction *, unsigned> &ParentStackElem,
@@ -5619,14 +5623,32 @@ public:
     if (NumReducedVals < 4)
       return false;
 
-    unsigned ReduxWidth = PowerOf2Floor(NumReducedVals);
+    // Reduced values extended from different types (e.g. a mix of zext'ed i8
+    // and i16 loads) can't be put into one vector bundle. Keep the values with
+    // the same source type together, so that each group is vectorized on its
+    // own. Groups are ordered by the first appearance of their source type.
+    if (isa<ZExtInst>(ReducedVals[0]) || isa<SExtInst>(ReducedVals[0])) {
+      SmallVector<Type *, 4> SrcTypes;
+      for (Value *V : ReducedVals)
+        if (!is_contained(SrcTypes, cast<CastInst>(V)->getSrcTy()))
+          SrcTypes.push_back(cast<CastInst>(V)->getSrcTy());
+      if (SrcTypes.size() > 1) {
+        auto GetSrcTyIdx = [&SrcTypes](Value *V) {
+          return llvm::find(SrcTypes, cast<CastInst>(V)->getSrcTy()) -
+                 SrcTypes.begin();
+        };
+        std::stable_sort(ReducedVals.begin(), ReducedVals.end(),
+                         [&GetSrcTyIdx](Value *V1, Value *V2) {
+                           return GetSrcTyIdx(V1) < GetSrcTyIdx(V2);
+                         });
+      }
+    }
 
     Value *VectorizedTree = nullptr;
     IRBuilder<> Builder(ReductionRoot);
     FastMathFlags Unsafe;
     Unsafe.setFast();
     Builder.setFastMathFlags(Unsafe);
-    unsigned i = 0;
 
     BoUpSLP::ExtraValueToDebugLocsMap ExternallyUsedValues;
     // The same extra argument may be used several time, so log each attempt
@@ -5636,73 +5658,108 @@ public:
     SmallVector<Value *, 16> IgnoreList;
     for (auto &V : ReductionOps)
       IgnoreList.append(V.begin(), V.end());
-    while (i < NumReducedVals - ReduxWidth + 1 && ReduxWidth > 2) {
-      auto VL = makeArrayRef(&ReducedVals[i], ReduxWidth);
-      V.buildTree(VL, ExternallyUsedValues, IgnoreList);
-      Optional<ArrayRef<unsigned>> Order = V.bestOrder();
-      // TODO: Handle orders of size less than number of elements in the vector.
-      if (Order && Order->size() == VL.size()) {
-        // TODO: reorder tree nodes without tree rebuilding.
-        SmallVector<Value *, 4> ReorderedOps(VL.size());
-        llvm::transform(*Order, ReorderedOps.begin(),
-                        [VL](const unsigned Idx) { return VL[Idx]; });
-        V.buildTree(ReorderedOps, ExternallyUsedValues, IgnoreList);
-      }
-      if (V.isTreeTinyAndNotFullyVectorizable())
-        break;
-
-      V.computeMinimumValueSizes();
-
-      // Estimate cost.
-      int TreeCost = V.getTreeCost();
-      int ReductionCost = getReductionCost(TTI, ReducedVals[i], ReduxWidth);
-      int Cost = TreeCost + ReductionCost;
-      if (Cost >= -SLPCostThreshold) {
-          V.getORE()->emit([&]() {
-              return OptimizationRemarkMissed(
-                         SV_NAME, "HorSLPNotBeneficial", cast<Instruction>(VL[0]))
-                     << "Vectorizing horizontal reduction is possible"
-                     << "but not beneficial with cost "
-                     << ore::NV("Cost", Cost) << " and threshold "
-                     << ore::NV("Threshold", -SLPCostThreshold);
-          });
+    // Reduced values that were not vectorized and must be added to the
+    // reduction as scalars.
+    SmallVector<Value *, 16> RemainingVals;
+    for (unsigned GroupBegin = 0; GroupBegin < NumReducedVals;) {
+      unsigned GroupEnd = GroupBegin + 1;
+      while (GroupEnd < NumReducedVals &&
+             haveSameSourceType(ReducedVals[GroupBegin], ReducedVals[GroupEnd]))
+        ++GroupEnd;
+
+      unsigned i = GroupBegin;
+      unsigned ReduxWidth = PowerOf2Floor(GroupEnd - GroupBegin);
+      while (i < GroupEnd - ReduxWidth + 1 && ReduxWidth > 2) {
+        auto VL = makeArrayRef(&ReducedVals[i], ReduxWidth);
+        // For widening reductions the tree is built over the narrow values
+        // and the extension is folded into the reduction itself.
+        IsWideningReduction = isProfitableWideningReduction(TTI, VL);
+        SmallVector<Value *, 16> TreeVals(VL.begin(), VL.end());
+        SmallVector<Value *, 16> TreeIgnoreList(IgnoreList.begin(),
+                                                IgnoreList.end());
+        if (IsWideningReduction) {
+          for (Value *&TreeV : TreeVals)
+            TreeV = cast<CastInst>(TreeV)->getOperand(0);
+          TreeIgnoreList.append(VL.begin(), VL.end());
+        }
+        V.buildTree(TreeVals, ExternallyUsedValues, TreeIgnoreList);
+        Optional<ArrayRef<unsigned>> Order = V.bestOrder();
+        // TODO: Handle orders of size less than number of elements in the
+        // vector.
+        if (Order && Order->size() == TreeVals.size()) {
+          // TODO: reorder tree nodes without tree rebuilding.
+          SmallVector<Value *, 4> ReorderedOps(TreeVals.size());
+          llvm::transform(*Order, ReorderedOps.begin(),
+                          [&TreeVals](const unsigned Idx) {
+                            return TreeVals[Idx];
+                          });
+          V.buildTree(ReorderedOps, ExternallyUsedValues, TreeIgnoreList);
+        }
+        if (V.isTreeTinyAndNotFullyVectorizable())
           break;
-      }
 
-      LLVM_DEBUG(dbgs() << "SLP: Vectorizing horizontal reduction at cost:"
-                        << Cost << ". (HorRdx)\n");
-      V.getORE()->emit([&]() {
-          return OptimizationRemark(
-                     SV_NAME, "VectorizedHorizontalReduction", cast<Instruction>(VL[0]))
-          << "Vectorized horizontal reduction with cost "
-          << ore::NV("Cost", Cost) << " and with tree size "
-          << ore::NV("TreeSize", V.getTreeSize());
-      });
+        V.computeMinimumValueSizes();
+
+        // Estimate cost.
+        int TreeCost = V.getTreeCost();
+        int ReductionCost = getReductionCost(TTI, ReducedVals[i], ReduxWidth);
+        int Cost = TreeCost + ReductionCost;
+        if (Cost >= -SLPCostThreshold) {
+            V.getORE()->emit([&]() {
+                return OptimizationRemarkMissed(
+                           SV_NAME, "HorSLPNotBeneficial", cast<Instruction>(VL[0]))
+                       << "Vectorizing horizontal reduction is possible"
+                       << "but not beneficial with cost "
+                       << ore::NV("Cost", Cost) << " and threshold "
+                       << ore::NV("Threshold", -SLPCostThreshold);
+            });
+            break;
+        }
+
+        LLVM_DEBUG(dbgs() << "SLP: Vectorizing horizontal reduction at cost:"
+                          << Cost << ". (HorRdx)\n");
+        V.getORE()->emit([&]() {
+            return OptimizationRemark(
+                       SV_NAME, "VectorizedHorizontalReduction", cast<Instruction>(VL[0]))
+            << "Vectorized horizontal reduction with cost "
+            << ore::NV("Cost", Cost) << " and with tree size "
+            << ore::NV("TreeSize", V.getTreeSize());
+        });
 
-      // Vectorize a tree.
-      DebugLoc Loc = cast<Instruction>(ReducedVals[i])->getDebugLoc();
-      Value *VectorizedRoot = V.vectorizeTree(ExternallyUsedValues);
+        // Vectorize a tree.
+        DebugLoc Loc = cast<Instruction>(ReducedVals[i])->getDebugLoc();
+        Value *VectorizedRoot = V.vectorizeTree(ExternallyUsedValues);
+        if (IsWideningReduction) {
+          auto *Ext = cast<CastInst>(VL[0]);
+          VectorizedRoot = Builder.CreateCast(
+              Ext->getOpcode(), VectorizedRoot,
+              VectorType::get(Ext->getDestTy(), ReduxWidth));
+        }
 
-      // Emit a reduction.
-      Value *ReducedSubTree =
-          emitReduction(VectorizedRoot, Builder, ReduxWidth, TTI);
-      if (VectorizedTree) {
-        Builder.SetCurrentDebugLocation(Loc);
-        OperationData VectReductionData(ReductionData.getOpcode(),
-                                        VectorizedTree, ReducedSubTree,
-                                        ReductionData.getKind());
-        VectorizedTree =
-            VectReductionData.createOp(Builder, "op.rdx", ReductionOps);
-      } else
-        VectorizedTree = ReducedSubTree;
-      i += ReduxWidth;
-      ReduxWidth = PowerOf2Floor(NumReducedVals - i);
+        // Emit a reduction.
+        Value *ReducedSubTree =
+            emitReduction(VectorizedRoot, Builder, ReduxWidth, TTI);
+        if (VectorizedTree) {
+          Builder.SetCurrentDebugLocation(Loc);
+          OperationData VectReductionData(ReductionData.getOpcode(),
+                                          VectorizedTree, ReducedSubTree,
+                                          ReductionData.getKind());
+          VectorizedTree =
+              VectReductionData.createOp(Builder, "op.rdx", ReductionOps);
+        } else
+          VectorizedTree = ReducedSubTree;
+        i += ReduxWidth;
+        ReduxWidth = PowerOf2Floor(GroupEnd - i);
+      }
+      RemainingVals.append(ReducedVals.begin() + i,
+                           ReducedVals.begin() + GroupEnd);
+      GroupBegin = GroupEnd;
     }
 
     if (VectorizedTree) {
       // Finish the reduction.
-      for (; i < NumReducedVals; ++i) {
-        auto *I = cast<Instruction>(ReducedVals[i]);
+      for (Value *RemainingV : RemainingVals) {
+        auto *I = cast<Instruction>(RemainingV);
         Builder.SetCurrentDebugLocation(I->getDebugLoc());
         OperationData VectReductionData(ReductionData.getOpcode(),
                                         VectorizedTree, I,
@@ -5732,12 +5789,71 @@ public:
   }
 
 private:
+  /// Checks if the reduced values \p V1 and \p V2 can be put into the same
+  /// vector bundle, i.e. they are not extended from different types.
+  static bool haveSameSourceType(Value *V1, Value *V2) {
+    auto *Cast1 = dyn_cast<CastInst>(V1);
+    auto *Cast2 = dyn_cast<CastInst>(V2);
+    return !Cast1 || !Cast2 || Cast1->getSrcTy() == Cast2->getSrcTy();
+  }
+
+  /// Checks if the add reduction of the values \p VL is cheaper to perform
+  /// on the narrow operands of their zero extensions, with the extension
+  /// folded into the reduction.
+  /// TODO: Handle sign extensions (e.g. PMADDWD against splat(1) on X86).
+  bool isProfitableWideningReduction(TargetTransformInfo *TTI,
+                                     ArrayRef<Value *> VL) const {
+    if (ReductionData.getKind() != RK_Arithmetic ||
+        ReductionData.getOpcode() != Instruction::Add)
+      return false;
+    auto *Ext = dyn_cast<CastInst>(VL[0]);
+    if (!Ext || !isa<ZExtInst>(Ext) || !isValidElementType(Ext->getSrcTy()))
+      return false;
+    if (llvm::any_of(VL, [Ext](Value *V) {
+          auto *Cast = dyn_cast<CastInst>(V);
+          return !Cast || Cast->getOpcode() != Ext->getOpcode() ||
+                 Cast->getSrcTy() != Ext->getSrcTy();
+        }))
+      return false;
+
+    Type *SrcVecTy = VectorType::get(Ext->getSrcTy(), VL.size());
+    Type *DstVecTy = VectorType::get(Ext->getDestTy(), VL.size());
+    int WideningCost = TTI->getExtendedAddReductionCost(
+        /*IsUnsigned=*/true, Ext->getDestTy(), SrcVecTy,
+        /*IsPairwiseForm=*/false);
+    int ExtCost = TTI->getCastInstrCost(Ext->getOpcode(), DstVecTy, SrcVecTy);
+    int RdxCost = std::min(
+        TTI->getArithmeticReductionCost(Instruction::Add, DstVecTy,
+                                        /*IsPairwiseForm=*/true),
+        TTI->getArithmeticReductionCost(Instruction::Add, DstVecTy,
+                                        /*IsPairwiseForm=*/false));
+    return WideningCost < ExtCost + RdxCost;
+  }
+
   /// Calculate the cost of a reduction.
   int getReductionCost(TargetTransformInfo *TTI, Value *FirstReducedVal,
                        unsigned ReduxWidth) {
     Type *ScalarTy = FirstReducedVal->getType();
     Type *VecTy = VectorType::get(ScalarTy, ReduxWidth);
 
+    if (IsWideningReduction) {
+      // The scalar extensions are replaced by the extended vector reduction.
+      auto *Ext = cast<CastInst>(FirstReducedVal);
+      Type *SrcVecTy = VectorType::get(Ext->getSrcTy(), ReduxWidth);
+      IsPairwiseReduction = false;
+      int VecReduxCost = TTI->getExtendedAddReductionCost(
+          /*IsUnsigned=*/true, ScalarTy, SrcVecTy, /*IsPairwiseForm=*/false);
+      int ScalarReduxCost =
+          TTI->getArithmeticInstrCost(Instruction::Add, ScalarTy) *
+              (ReduxWidth - 1) +
+          TTI->getCastInstrCost(Ext->getOpcode(), ScalarTy, Ext->getSrcTy()) *
+              ReduxWidth;
+      LLVM_DEBUG(dbgs() << "SLP: Adding cost " << VecReduxCost - ScalarReduxCost
+                        << " for widening reduction that starts with "
+                        << *FirstReducedVal << "\n");
+      return VecReduxCost - ScalarReduxCost;
+    }
+
     int PairwiseRdxCost;
     int SplittingRdxCost;
     switch (ReductionData.getKind()) {
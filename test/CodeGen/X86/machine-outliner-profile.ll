@@ -0,0 +1,82 @@
+; RUN: llc -enable-machine-outliner -mtriple=x86_64-apple-darwin < %s \
+; RUN:   | FileCheck %s
+; RUN: llc -enable-machine-outliner -outliner-skip-hot-blocks=false \
+; RUN:   -mtriple=x86_64-apple-darwin < %s | FileCheck %s --check-prefix=NOPROF
+
+; With a profile, only the sequences in the cold blocks are outlined. The
+; sequences in the hot blocks stay inline.
+
+define void @f(i1 %c1, i1 %c2) #0 !prof !20 {
+; CHECK-LABEL: _f:
+; CHECK-DAG: movl $5, -{{[0-9]+}}(%rbp)
+; CHECK-DAG: callq OUTLINED_FUNCTION_0
+; NOPROF-LABEL: _f:
+; NOPROF-NOT: movl $5
+entry:
+  %a = alloca i32, align 4
+  %b = alloca i32, align 4
+  %c = alloca i32, align 4
+  %d = alloca i32, align 4
+  br i1 %c1, label %cold1, label %hot1, !prof !21
+
+cold1:
+  store volatile i32 1, i32* %a, align 4
+  store volatile i32 2, i32* %b, align 4
+  store volatile i32 3, i32* %c, align 4
+  store volatile i32 4, i32* %d, align 4
+  br label %join
+
+hot1:
+  store volatile i32 5, i32* %a, align 4
+  store volatile i32 6, i32* %b, align 4
+  store volatile i32 7, i32* %c, align 4
+  store volatile i32 8, i32* %d, align 4
+  br label %join
+
+join:
+  br i1 %c2, label %cold2, label %hot2, !prof !21
+
+cold2:
+  store volatile i32 1, i32* %a, align 4
+  store volatile i32 2, i32* %b, align 4
+  store volatile i32 3, i32* %c, align 4
+  store volatile i32 4, i32* %d, align 4
+  br label %exit
+
+hot2:
+  store volatile i32 5, i32* %a, align 4
+  store volatile i32 6, i32* %b, align 4
+  store volatile i32 7, i32* %c, align 4
+  store volatile i32 8, i32* %d, align 4
+  br label %exit
+
+exit:
+  ret void
+}
+
+attributes #0 = { noredzone nounwind ssp uwtable "no-frame-pointer-elim"="true" }
+
+; CHECK: OUTLINED_FUNCTION_0:
+; CHECK: movl $1, -{{[0-9]+}}(%rbp)
+; CHECK-NOT: OUTLINED_FUNCTION_1:
+; NOPROF: OUTLINED_FUNCTION_0:
+; NOPROF: OUTLINED_FUNCTION_1:
+
+!llvm.module.flags = !{!0}
+
+!0 = !{i32 1, !"ProfileSummary", !1}
+!1 = !{!2, !3, !4, !5, !6, !7, !8, !9}
+!2 = !{!"ProfileFormat", !"InstrProf"}
+!3 = !{!"TotalCount", i64 10000}
+!4 = !{!"MaxCount", i64 1000}
+!5 = !{!"MaxInternalCount", i64 1}
+!6 = !{!"MaxFunctionCount", i64 1000}
+!7 = !{!"NumCounts", i64 6}
+!8 = !{!"NumFunctions", i64 1}
+!9 = !{!"DetailedSummary", !10}
+!10 = !{!11, !12, !13}
+!11 = !{i32 10000, i64 1000, i32 1}
+!12 = !{i32 990000, i64 900, i32 3}
+!13 = !{i32 999999, i64 1, i32 6}
+!20 = !{!"function_entry_count", i64 1000}
+!21 = !{!"branch_weights", i32 1, i32 100000}
@@ -0,0 +1,33 @@
+# RUN: rm -rf %t && mkdir -p %t
+# RUN: llvm-mc -triple=x86_64-pc-linux -filetype=obj -o %t/test_ELF_x86-64_parallel.o %s
+# RUN: llvm-rtdyld -triple=x86_64-pc-linux -verify %t/test_ELF_x86-64_parallel.o
+# RUN: llvm-rtdyld -triple=x86_64-pc-linux -verify -parallel-relocations %t/test_ELF_x86-64_parallel.o
+
+# Test that relocations resolved on multiple threads give the same results as
+# the serial path. The table has enough relocations to be split over threads.
+
+	.text
+	.globl	foo
+	.align	16, 0x90
+	.type	foo,@function
+foo:
+	retq
+.Ltmp0:
+	.size	foo, .Ltmp0-foo
+
+	.data
+	.globl	table
+	.align	8
+table:
+	.rept	5000
+	.quad	foo
+	.long	foo-.
+	.long	0
+	.endr
+
+# rtdyld-check: *{8}table = foo
+# rtdyld-check: *{4}(table + 8) = (foo - (table + 8))[31:0]
+# rtdyld-check: *{8}(table + 39984) = foo
+# rtdyld-check: *{4}(table + 39992) = (foo - (table + 39992))[31:0]
+# rtdyld-check: *{8}(table + 79984) = foo
+# rtdyld-check: *{4}(table + 79992) = (foo - (table + 79992))[31:0]
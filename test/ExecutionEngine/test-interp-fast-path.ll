@@ -0,0 +1,194 @@
+; RUN: %lli -force-interpreter=true %s
+; RUN: %lli -force-interpreter=true -interpreter-fast-path=false %s
+
+; main returns the number of the first check that fails, so both the bytecode
+; fast path and the generic interpreter have to compute the same results.
+
+%pair = type { i32, double }
+
+@counter = global i32 0
+
+define i32 @fib(i32 %n) {
+entry:
+  %small = icmp slt i32 %n, 2
+  br i1 %small, label %done, label %rec
+
+rec:
+  %n1 = sub i32 %n, 1
+  %f1 = call i32 @fib(i32 %n1)
+  %n2 = sub i32 %n, 2
+  %f2 = call i32 @fib(i32 %n2)
+  %sum = add i32 %f1, %f2
+  ret i32 %sum
+
+done:
+  ret i32 %n
+}
+
+; The PHIs swap their values on every iteration.
+define i64 @swap(i64 %a, i64 %b, i32 %n) {
+entry:
+  br label %loop
+
+loop:
+  %x = phi i64 [ %a, %entry ], [ %y, %loop ]
+  %y = phi i64 [ %b, %entry ], [ %x, %loop ]
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  %i.next = add i32 %i, 1
+  %cont = icmp ult i32 %i.next, %n
+  br i1 %cont, label %loop, label %exit
+
+exit:
+  %r = sub i64 %x, %y
+  ret i64 %r
+}
+
+define i8 @narrow(i8 %a, i8 %b) {
+  %d = sdiv i8 %a, %b
+  %r = srem i8 %a, %b
+  %s = ashr i8 %a, 2
+  %m = mul i8 %d, %r
+  %t = add i8 %m, %s
+  %w = add i8 %t, 127
+  ret i8 %w
+}
+
+define i64 @casts(i16 %x) {
+  %s = sext i16 %x to i64
+  %z = zext i16 %x to i64
+  %sum = add i64 %s, %z
+  %t = trunc i64 %sum to i8
+  %u = sext i8 %t to i64
+  %r = mul i64 %u, %sum
+  ret i64 %r
+}
+
+define double @fp(float %f, double %d) {
+  %e = fpext float %f to double
+  %p = fmul double %e, %d
+  %q = fdiv float %f, 3.0
+  %qe = fpext float %q to double
+  %s = fadd double %p, %qe
+  %i = fptosi double %s to i32
+  %back = sitofp i32 %i to float
+  %bits = bitcast float %back to i32
+  %bd = uitofp i32 %bits to double
+  %c = fcmp olt double %bd, %s
+  %res = select i1 %c, double 0.0, double %s
+  ret double %res
+}
+
+define i32 @memory(i32 %n) {
+entry:
+  %arr = alloca [8 x %pair]
+  br label %fill
+
+fill:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %fill ]
+  %f = getelementptr [8 x %pair], [8 x %pair]* %arr, i32 0, i32 %i, i32 0
+  store i32 %i, i32* %f
+  %g = getelementptr [8 x %pair], [8 x %pair]* %arr, i32 0, i32 %i, i32 1
+  %id = sitofp i32 %i to double
+  store double %id, double* %g
+  %i.next = add i32 %i, 1
+  %c = icmp slt i32 %i.next, %n
+  br i1 %c, label %fill, label %sum
+
+sum:
+  %j = phi i32 [ 0, %fill ], [ %j.next, %sum ]
+  %isum = phi i32 [ 0, %fill ], [ %isum.next, %sum ]
+  %dsum = phi double [ 0.0, %fill ], [ %dsum.next, %sum ]
+  %fj = getelementptr [8 x %pair], [8 x %pair]* %arr, i32 0, i32 %j, i32 0
+  %vi = load i32, i32* %fj
+  %isum.next = add i32 %isum, %vi
+  %gj = getelementptr [8 x %pair], [8 x %pair]* %arr, i32 0, i32 %j, i32 1
+  %vd = load double, double* %gj
+  %dsum.next = fadd double %dsum, %vd
+  %j.next = add i32 %j, 1
+  %c2 = icmp slt i32 %j.next, %n
+  br i1 %c2, label %sum, label %exit
+
+exit:
+  %di = fptosi double %dsum.next to i32
+  %r = add i32 %isum.next, %di
+  ret i32 %r
+}
+
+define i32 @classify(i32 %x) {
+entry:
+  switch i32 %x, label %other [ i32 1, label %one
+                                i32 -5, label %neg ]
+
+one:
+  ret i32 10
+
+neg:
+  ret i32 20
+
+other:
+  ret i32 30
+}
+
+define void @bump(i32 %by) {
+  %old = load i32, i32* @counter
+  %new = add i32 %old, %by
+  store i32 %new, i32* @counter
+  ret void
+}
+
+define i32 @main() {
+entry:
+  %fib = call i32 @fib(i32 20)
+  %fib.ok = icmp eq i32 %fib, 6765
+  br i1 %fib.ok, label %check.swap, label %fail
+
+check.swap:
+  %swap = call i64 @swap(i64 1, i64 2, i32 3)
+  %swap.ok = icmp eq i64 %swap, -1
+  br i1 %swap.ok, label %check.narrow, label %fail
+
+check.narrow:
+  %narrow = call i8 @narrow(i8 -100, i8 7)
+  %narrow.ok = icmp eq i8 %narrow, -126
+  br i1 %narrow.ok, label %check.casts, label %fail
+
+check.casts:
+  %casts = call i64 @casts(i16 -3)
+  %casts.ok = icmp eq i64 %casts, -393180
+  br i1 %casts.ok, label %check.fp, label %fail
+
+check.fp:
+  %fp = call double @fp(float 1.5, double 4.0)
+  %fp.ok = fcmp oeq double %fp, 6.5
+  br i1 %fp.ok, label %check.memory, label %fail
+
+check.memory:
+  %memory = call i32 @memory(i32 8)
+  %memory.ok = icmp eq i32 %memory, 56
+  br i1 %memory.ok, label %check.switch, label %fail
+
+check.switch:
+  %c1 = call i32 @classify(i32 1)
+  %c2 = call i32 @classify(i32 -5)
+  %c3 = call i32 @classify(i32 7)
+  %c12 = add i32 %c1, %c2
+  %c123 = add i32 %c12, %c3
+  %switch.ok = icmp eq i32 %c123, 60
+  br i1 %switch.ok, label %check.global, label %fail
+
+check.global:
+  call void @bump(i32 3)
+  call void @bump(i32 4)
+  %counter = load i32, i32* @counter
+  %global.ok = icmp eq i32 %counter, 7
+  br i1 %global.ok, label %pass, label %fail
+
+pass:
+  ret i32 0
+
+fail:
+  %code = phi i32 [ 1, %entry ], [ 2, %check.swap ], [ 3, %check.narrow ],
+                  [ 4, %check.casts ], [ 5, %check.fp ], [ 6, %check.memory ],
+                  [ 7, %check.switch ], [ 8, %check.global ]
+  ret i32 %code
+}
@@ -0,0 +1,52 @@
+; RUN: opt -function-specialization -S < %s | FileCheck %s
+
+; Integer arguments that are switched on are specialized, and the original
+; internal function is removed once all call sites are redirected.
+
+define internal i32 @dispatch(i32 %op, i32 %x) {
+entry:
+  switch i32 %op, label %default [
+    i32 0, label %inc
+    i32 1, label %dec
+  ]
+
+inc:
+  %a = add i32 %x, 1
+  ret i32 %a
+
+dec:
+  %b = sub i32 %x, 1
+  ret i32 %b
+
+default:
+  ret i32 %x
+}
+
+; CHECK-LABEL: define i32 @caller(
+; CHECK: call i32 @dispatch.specialized(i32 0, i32 %x)
+; CHECK: call i32 @dispatch.specialized.1(i32 1, i32 %x)
+define i32 @caller(i32 %x) {
+  %a = call i32 @dispatch(i32 0, i32 %x)
+  %b = call i32 @dispatch(i32 1, i32 %x)
+  %r = add i32 %a, %b
+  ret i32 %r
+}
+
+; Arguments that are only used as data are not worth a specialization.
+; CHECK-LABEL: define i32 @caller_data(
+; CHECK: call i32 @add_one(i32 42)
+define i32 @caller_data() {
+  %r = call i32 @add_one(i32 42)
+  ret i32 %r
+}
+
+define i32 @add_one(i32 %x) {
+  %r = add i32 %x, 1
+  ret i32 %r
+}
+
+; CHECK-NOT: define internal i32 @dispatch(
+; CHECK: define internal i32 @dispatch.specialized(
+; CHECK: switch i32 0, label %default
+; CHECK: define internal i32 @dispatch.specialized.1(
+; CHECK: switch i32 1, label %default
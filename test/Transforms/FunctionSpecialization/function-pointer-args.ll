@@ -0,0 +1,72 @@
+; RUN: opt -function-specialization -S < %s | FileCheck %s
+; RUN: opt -passes=function-specialization -S < %s | FileCheck %s
+; RUN: opt -function-specialization -func-spec-max-clones=0 -S < %s \
+; RUN:   | FileCheck %s --check-prefix=NOSPEC
+
+; Call sites passing the same comparator share a specialization, in which the
+; indirect call to the comparator becomes a direct call.
+
+define internal i32 @count_sorted(i32* %a, i64 %n, i1 (i32, i32)* %cmp) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 1, %entry ], [ %i.next, %loop ]
+  %count = phi i32 [ 0, %entry ], [ %count.next, %loop ]
+  %prev.ptr = getelementptr inbounds i32, i32* %a, i64 %i
+  %cur.ptr = getelementptr inbounds i32, i32* %prev.ptr, i64 -1
+  %prev = load i32, i32* %prev.ptr
+  %cur = load i32, i32* %cur.ptr
+  %ordered = call i1 %cmp(i32 %prev, i32 %cur)
+  %inc = zext i1 %ordered to i32
+  %count.next = add i32 %count, %inc
+  %i.next = add i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret i32 %count.next
+}
+
+define internal i1 @less(i32 %x, i32 %y) {
+  %r = icmp slt i32 %x, %y
+  ret i1 %r
+}
+
+define internal i1 @greater(i32 %x, i32 %y) {
+  %r = icmp sgt i32 %x, %y
+  ret i1 %r
+}
+
+; CHECK-LABEL: define i32 @count_asc(
+; CHECK: call i32 @count_sorted.specialized(i32* %a, i64 %n, i1 (i32, i32)* @less)
+; CHECK: call i32 @count_sorted.specialized(i32* %b, i64 %n, i1 (i32, i32)* @less)
+; NOSPEC-LABEL: define i32 @count_asc(
+; NOSPEC: call i32 @count_sorted(i32* %a, i64 %n, i1 (i32, i32)* @less)
+define i32 @count_asc(i32* %a, i32* %b, i64 %n) {
+  %x = call i32 @count_sorted(i32* %a, i64 %n, i1 (i32, i32)* @less)
+  %y = call i32 @count_sorted(i32* %b, i64 %n, i1 (i32, i32)* @less)
+  %r = add i32 %x, %y
+  ret i32 %r
+}
+
+; CHECK-LABEL: define i32 @count_desc(
+; CHECK: call i32 @count_sorted.specialized.1(i32* %a, i64 %n, i1 (i32, i32)* @greater)
+define i32 @count_desc(i32* %a, i64 %n) {
+  %r = call i32 @count_sorted(i32* %a, i64 %n, i1 (i32, i32)* @greater)
+  ret i32 %r
+}
+
+; Call sites passing an unknown comparator keep calling the original function.
+; CHECK-LABEL: define i32 @count_dynamic(
+; CHECK: call i32 @count_sorted(i32* %a, i64 %n, i1 (i32, i32)* %cmp)
+define i32 @count_dynamic(i32* %a, i64 %n, i1 (i32, i32)* %cmp) {
+  %r = call i32 @count_sorted(i32* %a, i64 %n, i1 (i32, i32)* %cmp)
+  ret i32 %r
+}
+
+; CHECK-LABEL: define internal i32 @count_sorted.specialized(
+; CHECK: call i1 @less(i32 %prev, i32 %cur)
+; CHECK-LABEL: define internal i32 @count_sorted.specialized.1(
+; CHECK: call i1 @greater(i32 %prev, i32 %cur)
+; NOSPEC-NOT: specialized
@@ -0,0 +1,95 @@
+; RUN: opt -hotcoldsplit -S < %s | FileCheck %s
+; RUN: opt -passes=hotcoldsplit -S < %s | FileCheck %s
+; RUN: opt -hotcoldsplit -hotcoldsplit-threshold=10 -S < %s \
+; RUN:   | FileCheck %s --check-prefix=THRESHOLD
+
+; The cold error path of @handler is outlined into a cold, noinline function
+; placed in the .text.unlikely section.
+
+; CHECK-LABEL: define void @handler(
+; CHECK: call void @handler_error() [[NOINLINE:#[0-9]+]]
+; CHECK-NOT: call void @log
+; CHECK: ret void
+; THRESHOLD-LABEL: define void @handler(
+; THRESHOLD: call void @log(i32 1)
+define void @handler(i32 %x) !prof !30 {
+entry:
+  %c = icmp eq i32 %x, 0
+  br i1 %c, label %error, label %exit, !prof !31
+
+error:
+  call void @log(i32 1)
+  call void @log(i32 2)
+  call void @log(i32 3)
+  br label %exit
+
+exit:
+  ret void
+}
+
+; Regions that return from the function can't be outlined.
+; CHECK-LABEL: define void @handler_return(
+; CHECK: call void @log(i32 1)
+define void @handler_return(i32 %x) !prof !30 {
+entry:
+  %c = icmp eq i32 %x, 0
+  br i1 %c, label %error, label %exit, !prof !31
+
+error:
+  call void @log(i32 1)
+  call void @log(i32 2)
+  call void @log(i32 3)
+  ret void
+
+exit:
+  call void @log(i32 0)
+  ret void
+}
+
+; Functions without profile data are not split.
+; CHECK-LABEL: define void @no_profile(
+; CHECK: call void @log(i32 1)
+define void @no_profile(i32 %x) {
+entry:
+  %c = icmp eq i32 %x, 0
+  br i1 %c, label %error, label %exit
+
+error:
+  call void @log(i32 1)
+  call void @log(i32 2)
+  call void @log(i32 3)
+  br label %exit
+
+exit:
+  ret void
+}
+
+declare void @log(i32)
+
+; CHECK: define internal void @handler_error() [[COLD:#[0-9]+]] !section_prefix [[UNLIKELY:![0-9]+]]
+; CHECK: call void @log(i32 1)
+; CHECK: call void @log(i32 2)
+; CHECK: call void @log(i32 3)
+
+; CHECK-DAG: attributes [[COLD]] = { cold minsize noinline }
+; CHECK-DAG: attributes [[NOINLINE]] = { noinline }
+; CHECK-DAG: [[UNLIKELY]] = !{!"function_section_prefix", !".unlikely"}
+
+!llvm.module.flags = !{!0}
+
+!0 = !{i32 1, !"ProfileSummary", !1}
+!1 = !{!2, !3, !4, !5, !6, !7, !8, !9}
+!2 = !{!"ProfileFormat", !"InstrProf"}
+!3 = !{!"TotalCount", i64 10000}
+!4 = !{!"MaxCount", i64 1000}
+!5 = !{!"MaxInternalCount", i64 1}
+!6 = !{!"MaxFunctionCount", i64 1000}
+!7 = !{!"NumCounts", i64 4}
+!8 = !{!"NumFunctions", i64 3}
+!9 = !{!"DetailedSummary", !10}
+!10 = !{!11, !12, !13}
+!11 = !{i32 10000, i64 1000, i32 1}
+!12 = !{i32 999000, i64 100, i32 3}
+!13 = !{i32 999999, i64 1, i32 4}
+!30 = !{!"function_entry_count", i64 1000}
+!31 = !{!"branch_weights", i32 1, i32 100000}
@@ -0,0 +1,27 @@
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=1 -output-format=csv < %s | FileCheck %s -check-prefix=CSV
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=1 -output-format=csv -jobs=2 < %s | FileCheck %s -check-prefix=CSV
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=1 -output-format=json -jobs=0 < %s | FileCheck %s -check-prefix=JSON
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=1 -all-views < %s > %t.serial
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=1 -all-views -jobs=2 < %s > %t.parallel
+# RUN: diff %t.serial %t.parallel
+# RUN: not llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -instruction-tables -output-format=json < %s 2>&1 | FileCheck %s -check-prefix=TABLES
+
+# LLVM-MCA-BEGIN first, "quoted"
+  add %edi, %esi
+# LLVM-MCA-END
+
+# LLVM-MCA-BEGIN second
+  add %esi, %eax
+# LLVM-MCA-END
+
+# CSV:      region,description,iterations,instructions,total_cycles,dispatch_width,uops,ipc,block_rthroughput
+# CSV-NEXT: 0,"first, ""quoted""",1,1,4,2,1,0.25,0.5
+# CSV-NEXT: 1,second,1,1,4,2,1,0.25,0.5
+# CSV-NOT:  {{.}}
+
+# JSON:      [
+# JSON-NEXT:   {"region": 0, "description": "first, \"quoted\"", "iterations": 1, "instructions": 1, "total_cycles": 4, "dispatch_width": 2, "uops": 1, "ipc": 0.25, "block_rthroughput": 0.5},
+# JSON-NEXT:   {"region": 1, "description": "second", "iterations": 1, "instructions": 1, "total_cycles": 4, "dispatch_width": 2, "uops": 1, "ipc": 0.25, "block_rthroughput": 0.5}
+# JSON-NEXT: ]
+
+# TABLES: error: instruction tables can only be printed as text.
@@ -0,0 +1,23 @@
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=100 -critical-path -resource-pressure=false -instruction-info=false < %s | FileCheck %s
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=1 -critical-path -resource-pressure=false -instruction-info=false < %s | FileCheck %s -check-prefix=ONE
+
+# The multiply and the add form a recurrence through %eax, which takes four
+# cycles per iteration on btver2.
+
+imull %eax, %eax
+addl  %ebx, %eax
+
+# CHECK:      Critical Path:
+# CHECK-NEXT: Loop-carried dependency:  4.00 cycles per iteration
+# CHECK-NEXT: Most used resource:       1.{{[0-9]+}} cycles per iteration (JALU1)
+# CHECK-NEXT: Dispatch width:           1.50 cycles per iteration
+# CHECK-NEXT: Bottleneck:               loop-carried dependency
+
+# CHECK:      Dependency chain:
+# CHECK-NEXT:  1    addl	%ebx, %eax
+# CHECK-NEXT:  3    imull	%eax, %eax
+
+# ONE:        Critical Path:
+# ONE-NEXT:   Loop-carried dependency:  unknown (at least two iterations are required)
+# ONE:        Bottleneck:
+# ONE-NOT:    Dependency chain:
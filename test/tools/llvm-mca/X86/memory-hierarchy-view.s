@@ -0,0 +1,28 @@
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=8 -resource-pressure=false -instruction-info=false -memory-view -l1-hit-rate=75 -l2-hit-rate=50 < %s | FileCheck %s -check-prefix=MISSES
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=8 -resource-pressure=false -instruction-info=false -memory-view < %s | FileCheck %s -check-prefix=HITS
+# RUN: not llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -l1-hit-rate=101 < %s 2>&1 | FileCheck %s -check-prefix=ERROR
+
+  movq     (%rdi), %rax
+  addq     %rax, %rbx
+
+# Every fourth load misses in the L1 cache, and every other L1 miss also
+# misses in the L2 cache.
+
+# MISSES:      Memory hierarchy:
+# MISSES-NEXT: [1]: #Loads
+# MISSES-NEXT: [2]: L1 cache hits
+# MISSES-NEXT: [3]: L2 cache hits
+# MISSES-NEXT: [4]: Memory accesses
+# MISSES-NEXT: [5]: Average extra latency
+
+# MISSES:      [1]    [2]    [3]    [4]    [5]    Instructions:
+# MISSES-NEXT:  8      6      1      1     26.50  movq	(%rdi), %rax
+# MISSES-NEXT:  -      -      -      -      -     addq	%rax, %rbx
+# MISSES-NEXT:  8      6      1      1     26.50  Total
+
+# HITS:      [1]    [2]    [3]    [4]    [5]    Instructions:
+# HITS-NEXT:  8      8      0      0     0.00   movq	(%rdi), %rax
+# HITS-NEXT:  -      -      -      -      -     addq	%rax, %rbx
+# HITS-NEXT:  8      8      0      0     0.00   Total
+
+# ERROR: error: cache hit rates must be between 0 and 100.
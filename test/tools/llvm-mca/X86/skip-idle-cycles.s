@@ -0,0 +1,22 @@
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=100 -all-views -timeline -timeline-max-iterations=3 -skip-idle-cycles=false < %s > %t.all
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=100 -all-views -timeline -timeline-max-iterations=3 < %s > %t.skip
+# RUN: diff %t.all %t.skip
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=100 -all-views -timeline -timeline-max-iterations=3 -skip-idle-cycles=false -lqueue=2 -squeue=2 -register-file-size=40 -noalias=false < %s > %t.all
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=100 -all-views -timeline -timeline-max-iterations=3 -lqueue=2 -squeue=2 -register-file-size=40 -noalias=false < %s > %t.skip
+# RUN: diff %t.all %t.skip
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=100 -all-views -skip-idle-cycles=false -dispatch=1 < %s > %t.all
+# RUN: llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2 -iterations=100 -all-views -dispatch=1 < %s > %t.skip
+# RUN: diff %t.all %t.skip
+
+# Skipping the cycles spent waiting on the divisions, the square roots and the
+# loads must not change any statistic.
+
+  divl     %ecx
+  addl     %eax, %ebx
+  vsqrtpd  %ymm0, %ymm1
+  vaddpd   %ymm1, %ymm2, %ymm2
+  movq     (%rdi), %rsi
+  imulq    (%rsi), %rdx
+  movq     %rdx, 8(%rdi)
+  idivq    %rdx
+  xorl     %ecx, %ecx
@@ -0,0 +1,47 @@
+// Check that disassembling on several threads prints the same output as on a
+// single one, including the relocations and source lines that are carried
+// over from one symbol to the next.
+
+// RUN: llvm-mc -filetype=obj -triple=x86_64-pc-linux %s -o %t.o
+// RUN: llvm-objdump -d -r %t.o > %t.serial
+// RUN: llvm-objdump -d -r -disassembly-threads=4 -disassembly-range-size=1 \
+// RUN:   %t.o > %t.parallel
+// RUN: cmp %t.serial %t.parallel
+// RUN: FileCheck %s < %t.parallel
+
+// RUN: llvm-objdump -d -l -S %p/../Inputs/embedded-source > %t.lines.serial
+// RUN: llvm-objdump -d -l -S -disassembly-threads=4 \
+// RUN:   -disassembly-range-size=1 %p/../Inputs/embedded-source \
+// RUN:   > %t.lines.parallel
+// RUN: cmp %t.lines.serial %t.lines.parallel
+
+// CHECK:      Disassembly of section .text:
+// CHECK:      foo:
+// CHECK-NEXT: callq
+// CHECK-NEXT: R_X86_64_PLT32 bar-4
+// CHECK-NEXT: retq
+// CHECK:      table:
+// CHECK:      bar:
+// CHECK-NEXT: callq
+// CHECK-NEXT: R_X86_64_64 bar
+// CHECK-NEXT: R_X86_64_PLT32 foo-4
+// CHECK-NEXT: retq
+// CHECK-NOT:  Disassembly of section
+
+        .text
+        .globl foo
+        .type foo, @function
+foo:
+        callq bar
+        retq
+
+// The relocation of this data is printed after the next instruction.
+        .type table, @object
+table:
+        .quad bar
+
+        .globl bar
+        .type bar, @function
+bar:
+        callq foo
+        retq
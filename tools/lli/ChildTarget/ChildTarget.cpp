@@ -1,5 +1,6 @@
 #include "llvm/ExecutionEngine/Orc/OrcABISupport.h"
 #include "llvm/ExecutionEngine/Orc/OrcRemoteTargetServer.h"
+#include "llvm/ExecutionEngine/Orc/SharedMemoryChannel.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/DynamicLibrary.h"
 #include "llvm/Support/Process.h"
@@ -22,18 +23,23 @@ ExitOnError ExitOnErr;
 int main(int argc, char *argv[]) {
 
   if (argc != 3) {
-    errs() << "Usage: " << argv[0] << " <input fd> <output fd>\n";
+    errs() << "Usage: " << argv[0] << " <input fd> <output fd>\n"
+           << "       " << argv[0] << " -shm <channel name>\n";
     return 1;
   }
 
   ExitOnErr.setBanner(std::string(argv[0]) + ":");
 
-  int InFD;
-  int OutFD;
-  {
+  int InFD = -1;
+  int OutFD = -1;
+  std::unique_ptr<rpc::RawByteChannel> Channel;
+  if (StringRef(argv[1]) == "-shm") {
+    Channel = ExitOnErr(rpc::SharedMemoryChannel::open(argv[2]));
+  } else {
     std::istringstream InFDStream(argv[1]), OutFDStream(argv[2]);
     InFDStream >> InFD;
     OutFDStream >> OutFD;
+    Channel = llvm::make_unique<FDRawChannel>(InFD, OutFD);
   }
 
   if (sys::DynamicLibrary::LoadLibraryPermanently(nullptr)) {
@@ -53,15 +59,19 @@ int main(int argc, char *argv[]) {
     RTDyldMemoryManager::deregisterEHFramesInProcess(Addr, Size);
   };
 
-  FDRawChannel Channel(InFD, OutFD);
-  typedef remote::OrcRemoteTargetServer<FDRawChannel, HostOrcArch> JITServer;
-  JITServer Server(Channel, SymbolLookup, RegisterEHFrames, DeregisterEHFrames);
+  typedef remote::OrcRemoteTargetServer<rpc::RawByteChannel, HostOrcArch>
+      JITServer;
+  JITServer Server(*Channel, SymbolLookup, RegisterEHFrames,
+                   DeregisterEHFrames);
 
   while (!Server.receivedTerminate())
     ExitOnErr(Server.handleOne());
 
-  close(InFD);
-  close(OutFD);
+  Channel.reset();
+  if (InFD != -1) {
+    close(InFD);
+    close(OutFD);
+  }
 
   return 0;
 }
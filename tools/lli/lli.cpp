@@ -28,6 +28,7 @@
 #include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
 #include "llvm/ExecutionEngine/Orc/OrcRemoteTargetClient.h"
+#include "llvm/ExecutionEngine/Orc/SharedMemoryChannel.h"
 #include "llvm/ExecutionEngine/OrcMCJITReplacement.h"
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
 #include "llvm/IR/IRBuilder.h"
@@ -114,6 +115,12 @@ namespace {
                          "\n\tremote execution will be simulated in-process."),
                 cl::value_desc("filename"), cl::init(""));
 
+  cl::opt<bool> RemoteSharedMemory(
+      "mcjit-remote-shm",
+      cl::desc("Communicate with the remote process through shared memory "
+               "instead of pipes."),
+      cl::init(false));
+
   // Determine optimization level.
   cl::opt<char>
   OptLevel("O",
@@ -521,6 +528,11 @@ int main(int argc, char **argv, char * const *envp) {
                 JITEventListener::createOProfileJITEventListener());
   EE->RegisterJITEventListener(
                 JITEventListener::createIntelJITEventListener());
+  // The perf listener copies the emitted code into the jitdump file, so it
+  // can only be used when the code is in this process.
+  if (!RemoteMCJIT)
+    EE->RegisterJITEventListener(
+                JITEventListener::createPerfJITEventListener());
 
   if (!NoLazyCompilation && RemoteMCJIT) {
     WithColor::warning(errs(), argv[0])
@@ -631,7 +643,7 @@ int main(int argc, char **argv, char * const *envp) {
     // MCJIT itself. FIXME.
 
     // Lanch the remote process and get a channel to it.
-    std::unique_ptr<FDRawChannel> C = launchRemote();
+    std::unique_ptr<orc::rpc::RawByteChannel> C = launchRemote();
     if (!C) {
       WithColor::error(errs(), argv[0]) << "failed to launch remote JIT.\n";
       exit(1);
@@ -797,13 +809,38 @@ int runOrcLazyJIT(LLVMContext &Ctx, std::vector<std::unique_ptr<Module>> Ms,
   return Result;
 }
 
-std::unique_ptr<FDRawChannel> launchRemote() {
+std::unique_ptr<orc::rpc::RawByteChannel> launchRemote() {
 #ifndef LLVM_ON_UNIX
   llvm_unreachable("launchRemote not supported on non-Unix platforms");
 #else
   int PipeFD[2][2];
   pid_t ChildPID;
 
+  if (RemoteSharedMemory) {
+    // Create the channel before forking, so that the child can connect to it
+    // right away.
+    std::string Name = "/lli-remote-" + utostr(getpid());
+    auto C = orc::rpc::SharedMemoryChannel::create(Name);
+    if (!C) {
+      logAllUnhandledErrors(C.takeError(), errs(), "Error creating channel: ");
+      return nullptr;
+    }
+
+    ChildPID = fork();
+    if (ChildPID == 0) {
+      // In the child...
+      std::string ChildPath = ChildExecPath, ShmFlag = "-shm";
+      char *const args[] = {&ChildPath[0], &ShmFlag[0], &Name[0], nullptr};
+      int rc = execv(ChildExecPath.c_str(), args);
+      if (rc != 0)
+        perror("Error executing child process: ");
+      llvm_unreachable("Error executing child process");
+    }
+    // else we're the parent...
+
+    return std::move(*C);
+  }
+
   // Create two pipes.
   if (pipe(PipeFD[0]) != 0 || pipe(PipeFD[1]) != 0)
     perror("Error creating pipe: ");
@@ -636,6 +636,107 @@ llvm::Error Analysis::run<Analysis::PrintSchedClassInconsistencies>(
   return llvm::Error::success();
 }
 
+// Returns the sched class of Inst, with variant classes resolved, or 0 if it
+// has none.
+static unsigned resolveSchedClassId(const llvm::MCSubtargetInfo &STI,
+                                    const llvm::MCInstrInfo &InstrInfo,
+                                    const llvm::MCInst &Inst) {
+  const auto &SM = STI.getSchedModel();
+  unsigned SchedClassId = InstrInfo.get(Inst.getOpcode()).getSchedClass();
+  while (SchedClassId && SM.getSchedClassDesc(SchedClassId)->isVariant())
+    SchedClassId =
+        STI.resolveVariantSchedClass(SchedClassId, &Inst, SM.getProcessorID());
+  return SchedClassId;
+}
+
+template <>
+llvm::Error Analysis::run<Analysis::PrintSchedModelValidation>(
+    llvm::raw_ostream &OS) const {
+  // For each sched class, the relative errors of the snippets that contain it.
+  // A snippet with several instructions counts against all of their classes,
+  // so the classes that show up in many mispredicted snippets come first.
+  struct SchedClassErrors {
+    std::vector<double> Errors;
+    double WorstError = 0.0;
+    size_t WorstPointId = 0;
+  };
+  std::unordered_map<unsigned, SchedClassErrors> ErrorsPerSchedClass;
+  const auto &Points = Clustering_.getPoints();
+  for (size_t PointId = 0, E = Points.size(); PointId < E; ++PointId) {
+    const InstructionBenchmark &Point = Points[PointId];
+    if (!Point.Error.empty() || Point.Mode != InstructionBenchmark::Latency ||
+        Point.Measurements.size() != 1)
+      continue;
+    const llvm::Optional<double> Predicted = predictCyclesPerIteration(
+        *SubtargetInfo_, *InstrInfo_, *RegInfo_, Point.Key.Instructions);
+    if (!Predicted || *Predicted <= 0.0)
+      continue;
+    // Measurements are per instruction.
+    const double Measured =
+        Point.Measurements[0].Value * Point.Key.Instructions.size();
+    const double Error = (Measured - *Predicted) / *Predicted;
+    std::set<unsigned> SchedClassIds;
+    for (const llvm::MCInst &Inst : Point.Key.Instructions)
+      SchedClassIds.insert(
+          resolveSchedClassId(*SubtargetInfo_, *InstrInfo_, Inst));
+    for (const unsigned SchedClassId : SchedClassIds) {
+      SchedClassErrors &Errors = ErrorsPerSchedClass[SchedClassId];
+      if (Errors.Errors.empty() ||
+          std::abs(Error) > std::abs(Errors.WorstError)) {
+        Errors.WorstError = Error;
+        Errors.WorstPointId = PointId;
+      }
+      Errors.Errors.push_back(Error);
+    }
+  }
+
+  std::vector<std::pair<unsigned, double>> SortedSchedClasses;
+  for (const auto &SchedClassAndErrors : ErrorsPerSchedClass) {
+    const std::vector<double> &Errors = SchedClassAndErrors.second.Errors;
+    double SumAbsErrors = 0.0;
+    for (const double Error : Errors)
+      SumAbsErrors += std::abs(Error);
+    SortedSchedClasses.emplace_back(SchedClassAndErrors.first,
+                                    SumAbsErrors / Errors.size());
+  }
+  llvm::sort(SortedSchedClasses.begin(), SortedSchedClasses.end(),
+             [](const std::pair<unsigned, double> &A,
+                const std::pair<unsigned, double> &B) {
+               if (A.second != B.second)
+                 return A.second > B.second;
+               return A.first < B.first;
+             });
+
+  // Write the header.
+  OS << "sched_class" << kCsvSep << "num_snippets" << kCsvSep
+     << "mean_abs_error" << kCsvSep << "worst_error" << kCsvSep
+     << "worst_snippet\n";
+  const auto &SchedModel = SubtargetInfo_->getSchedModel();
+  for (const auto &SchedClassAndError : SortedSchedClasses) {
+    const unsigned SchedClassId = SchedClassAndError.first;
+    const SchedClassErrors &Errors = ErrorsPerSchedClass[SchedClassId];
+#if !defined(NDEBUG) || defined(LLVM_ENABLE_DUMP)
+    if (SchedClassId)
+      writeEscaped<kEscapeCsv>(
+          OS, SchedModel.getSchedClassDesc(SchedClassId)->Name);
+    else
+      writeEscaped<kEscapeCsv>(OS, "[invalid]");
+#else
+    (void)SchedModel;
+    OS << SchedClassId;
+#endif
+    OS << kCsvSep << Errors.Errors.size() << kCsvSep;
+    writeMeasurementValue<kEscapeCsv>(OS, SchedClassAndError.second);
+    OS << kCsvSep;
+    writeMeasurementValue<kEscapeCsv>(OS, Errors.WorstError);
+    OS << kCsvSep;
+    writeSnippet<EscapeTag, kEscapeCsv>(
+        OS, Points[Errors.WorstPointId].AssembledSnippet, "; ");
+    OS << "\n";
+  }
+  return llvm::Error::success();
+}
+
 // Distributes a pressure budget as evenly as possible on the provided subunits
 // given the already existing port pressure distribution.
 //
@@ -750,4 +851,83 @@ std::vector<std::pair<uint16_t, float>> computeIdealizedProcResPressure(
   return Pressure;
 }
 
+llvm::Optional<double>
+predictCyclesPerIteration(const llvm::MCSubtargetInfo &STI,
+                          const llvm::MCInstrInfo &InstrInfo,
+                          const llvm::MCRegisterInfo &RegInfo,
+                          llvm::ArrayRef<llvm::MCInst> Snippet) {
+  const auto &SM = STI.getSchedModel();
+  llvm::SmallVector<llvm::MCWriteProcResEntry, 8> WPRS;
+  std::vector<unsigned> Latencies;
+  unsigned NumMicroOps = 0;
+  for (const llvm::MCInst &Inst : Snippet) {
+    const unsigned SchedClassId = resolveSchedClassId(STI, InstrInfo, Inst);
+    const llvm::MCSchedClassDesc *const SCDesc =
+        SchedClassId ? SM.getSchedClassDesc(SchedClassId) : nullptr;
+    if (!SCDesc || !SCDesc->isValid())
+      return llvm::None;
+    NumMicroOps += SCDesc->NumMicroOps;
+    const auto NonRedundantWPRS = getNonRedundantWriteProcRes(*SCDesc, STI);
+    WPRS.append(NonRedundantWPRS.begin(), NonRedundantWPRS.end());
+    // Like measurementsMatch, use the latency of the slowest def.
+    unsigned Latency = 0;
+    for (unsigned I = 0; I < SCDesc->NumWriteLatencyEntries; ++I)
+      Latency = std::max<unsigned>(
+          Latency, STI.getWriteLatencyEntry(SCDesc, I)->Cycles);
+    Latencies.push_back(Latency);
+  }
+
+  // Throughput bounds.
+  double Cycles = SM.IssueWidth ? double(NumMicroOps) / SM.IssueWidth : 0.0;
+  for (const auto &Pressure : computeIdealizedProcResPressure(SM, WPRS))
+    Cycles = std::max<double>(
+        Cycles, Pressure.second / SM.getProcResource(Pressure.first)->NumUnits);
+
+  // Latency bound: compute when each register unit becomes ready while
+  // running the snippet in a loop, and measure how fast the last ready time
+  // grows once the loop reached a steady state.
+  constexpr const unsigned NumIterations = 16;
+  std::vector<double> RegUnitReady(RegInfo.getNumRegUnits());
+  double LastReady = 0.0;
+  double HalfwayReady = 0.0;
+  for (unsigned Iteration = 0; Iteration < NumIterations; ++Iteration) {
+    for (size_t I = 0, E = Snippet.size(); I < E; ++I) {
+      const llvm::MCInst &Inst = Snippet[I];
+      const llvm::MCInstrDesc &InstrDesc = InstrInfo.get(Inst.getOpcode());
+      double Start = 0.0;
+      const auto ReadReg = [&](unsigned Reg) {
+        for (llvm::MCRegUnitIterator Unit(Reg, &RegInfo); Unit.isValid();
+             ++Unit)
+          Start = std::max(Start, RegUnitReady[*Unit]);
+      };
+      for (unsigned Op = InstrDesc.getNumDefs(), OpEnd = Inst.getNumOperands();
+           Op < OpEnd; ++Op) {
+        if (Inst.getOperand(Op).isReg() && Inst.getOperand(Op).getReg())
+          ReadReg(Inst.getOperand(Op).getReg());
+      }
+      for (const llvm::MCPhysReg *Reg = InstrDesc.getImplicitUses();
+           Reg && *Reg; ++Reg)
+        ReadReg(*Reg);
+
+      const double Ready = Start + Latencies[I];
+      LastReady = std::max(LastReady, Ready);
+      const auto WriteReg = [&](unsigned Reg) {
+        for (llvm::MCRegUnitIterator Unit(Reg, &RegInfo); Unit.isValid();
+             ++Unit)
+          RegUnitReady[*Unit] = Ready;
+      };
+      for (unsigned Op = 0, OpEnd = InstrDesc.getNumDefs(); Op < OpEnd; ++Op) {
+        if (Inst.getOperand(Op).isReg() && Inst.getOperand(Op).getReg())
+          WriteReg(Inst.getOperand(Op).getReg());
+      }
+      for (const llvm::MCPhysReg *Reg = InstrDesc.getImplicitDefs();
+           Reg && *Reg; ++Reg)
+        WriteReg(*Reg);
+    }
+    if (Iteration == NumIterations / 2 - 1)
+      HalfwayReady = LastReady;
+  }
+  return std::max(Cycles, (LastReady - HalfwayReady) / (NumIterations / 2));
+}
+
 } // namespace exegesis
@@ -16,6 +16,7 @@
 #define LLVM_TOOLS_LLVM_EXEGESIS_ANALYSIS_H
 
 #include "Clustering.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/MC/MCContext.h"
 #include "llvm/MC/MCDisassembler/MCDisassembler.h"
 #include "llvm/MC/MCInstPrinter.h"
@@ -42,6 +43,10 @@ public:
   struct PrintClusters {};
   // Find potential errors in the scheduling information given measurements.
   struct PrintSchedClassInconsistencies {};
+  // Compares the cycles measured for latency benchmarks, e.g. snippets read
+  // from a file, with the cycles predicted by the scheduling model, and prints
+  // a csv of the sched classes, the worst mispredicted first.
+  struct PrintSchedModelValidation {};
 
   template <typename Pass> llvm::Error run(llvm::raw_ostream &OS) const;
 
@@ -124,6 +129,17 @@ std::vector<std::pair<uint16_t, float>> computeIdealizedProcResPressure(
     const llvm::MCSchedModel &SM,
     llvm::SmallVector<llvm::MCWriteProcResEntry, 8> WPRS);
 
+// Predicts the number of cycles per iteration of Snippet when it is repeated
+// in a loop, from the scheduling model. This is the maximum of three bounds:
+// the latency of the dependency chains carried from one iteration to the next,
+// the idealized pressure on the busiest ProcRes unit, and the issue width.
+// Returns None if an instruction has no valid sched class.
+llvm::Optional<double>
+predictCyclesPerIteration(const llvm::MCSubtargetInfo &STI,
+                          const llvm::MCInstrInfo &InstrInfo,
+                          const llvm::MCRegisterInfo &RegInfo,
+                          llvm::ArrayRef<llvm::MCInst> Snippet);
+
 } // namespace exegesis
 
 #endif // LLVM_TOOLS_LLVM_EXEGESIS_CLUSTERING_H
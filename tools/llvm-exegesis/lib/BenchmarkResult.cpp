@@ -12,6 +12,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ObjectYAML/YAML.h"
 #include "llvm/Support/FileOutputBuffer.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/raw_ostream.h"
@@ -289,6 +290,252 @@ InstructionBenchmark::writeYaml(const BenchmarkResultContext &Context,
   return llvm::Error::success();
 }
 
+// Binary format.
+//
+// All integers are little-endian. A string is its size as a uint32_t followed
+// by its bytes. Each benchmark is its size as a uint32_t followed by:
+//   uint8_t    mode
+//   string     cpu name, triple, info, error, config
+//   uint32_t   number of repetitions
+//   uint32_t   number of instructions, each of which is:
+//     string   opcode name
+//     uint32_t number of operands, each of which is a uint8_t kind followed
+//              by a register name (string), an int64_t or a double.
+//   uint32_t   number of measurements, each of which is:
+//     string   key
+//     double   value
+//     string   debug string
+//   string     assembled snippet
+// Register and opcode names are used instead of numbers, as with Yaml, so that
+// results are preserved across different versions of LLVM.
+
+static constexpr const char kBinaryMagic[] = "EXEGBIN1";
+static constexpr const size_t kBinaryMagicSize = sizeof(kBinaryMagic) - 1;
+
+static bool isBinary(llvm::StringRef Data) {
+  return Data.startswith(llvm::StringRef(kBinaryMagic, kBinaryMagicSize));
+}
+
+namespace {
+
+enum OperandKind : uint8_t {
+  kInvalidOperand,
+  kRegOperand,
+  kImmOperand,
+  kFPImmOperand
+};
+
+class BinaryWriter {
+public:
+  explicit BinaryWriter(llvm::raw_ostream &OS)
+      : Writer(OS, llvm::support::little) {}
+
+  template <typename T> void write(T Value) { Writer.write<T>(Value); }
+  void writeDouble(double Value) { Writer.write<double>(Value); }
+  void writeString(llvm::StringRef String) {
+    write<uint32_t>(String.size());
+    Writer.OS << String;
+  }
+
+private:
+  llvm::support::endian::Writer Writer;
+};
+
+class BinaryReader {
+public:
+  explicit BinaryReader(llvm::StringRef Data) : Data(Data) {}
+
+  bool failed() const { return Failed; }
+  bool atEnd() const { return Offset == Data.size(); }
+
+  // Skips the header if the data at the current offset starts with one.
+  bool skipHeader() {
+    if (!isBinary(Data.substr(Offset)))
+      return false;
+    Offset += kBinaryMagicSize;
+    return true;
+  }
+
+  template <typename T> T read() {
+    if (Failed || Data.size() - Offset < sizeof(T)) {
+      Failed = true;
+      return T();
+    }
+    const T Value = llvm::support::endian::read<T, llvm::support::little,
+                                                llvm::support::unaligned>(
+        Data.data() + Offset);
+    Offset += sizeof(T);
+    return Value;
+  }
+  double readDouble() { return llvm::BitsToDouble(read<uint64_t>()); }
+  llvm::StringRef readString() {
+    const uint32_t Size = read<uint32_t>();
+    if (Failed || Data.size() - Offset < Size) {
+      Failed = true;
+      return {};
+    }
+    const llvm::StringRef String = Data.substr(Offset, Size);
+    Offset += Size;
+    return String;
+  }
+
+private:
+  const llvm::StringRef Data;
+  size_t Offset = 0;
+  bool Failed = false;
+};
+
+} // namespace
+
+void InstructionBenchmark::writeBinaryHeader(llvm::raw_ostream &OS) {
+  OS << llvm::StringRef(kBinaryMagic, kBinaryMagicSize);
+}
+
+void InstructionBenchmark::writeBinaryTo(const BenchmarkResultContext &Context,
+                                         llvm::raw_ostream &OS) const {
+  std::string Buffer;
+  llvm::raw_string_ostream BufferOS(Buffer);
+  BinaryWriter Writer(BufferOS);
+  Writer.write<uint8_t>(Mode);
+  Writer.writeString(CpuName);
+  Writer.writeString(LLVMTriple);
+  Writer.writeString(Info);
+  Writer.writeString(Error);
+  Writer.writeString(Key.Config);
+  Writer.write<uint32_t>(NumRepetitions);
+  Writer.write<uint32_t>(Key.Instructions.size());
+  for (const llvm::MCInst &Inst : Key.Instructions) {
+    Writer.writeString(Context.getInstrName(Inst.getOpcode()));
+    Writer.write<uint32_t>(Inst.getNumOperands());
+    for (const llvm::MCOperand &Op : Inst) {
+      if (Op.isReg()) {
+        Writer.write<uint8_t>(kRegOperand);
+        Writer.writeString(Context.getRegName(Op.getReg()));
+      } else if (Op.isImm()) {
+        Writer.write<uint8_t>(kImmOperand);
+        Writer.write<int64_t>(Op.getImm());
+      } else if (Op.isFPImm()) {
+        Writer.write<uint8_t>(kFPImmOperand);
+        Writer.writeDouble(Op.getFPImm());
+      } else {
+        Writer.write<uint8_t>(kInvalidOperand);
+      }
+    }
+  }
+  Writer.write<uint32_t>(Measurements.size());
+  for (const BenchmarkMeasure &Measure : Measurements) {
+    Writer.writeString(Measure.Key);
+    Writer.writeDouble(Measure.Value);
+    Writer.writeString(Measure.DebugString);
+  }
+  Writer.writeString(llvm::StringRef(
+      reinterpret_cast<const char *>(AssembledSnippet.data()),
+      AssembledSnippet.size()));
+  BufferOS.flush();
+
+  BinaryWriter(OS).writeString(Buffer);
+}
+
+// Reads one benchmark, returns false if the data is malformed.
+static bool readBinary(const BenchmarkResultContext &Context,
+                       BinaryReader &Reader, InstructionBenchmark &Benchmark) {
+  BinaryReader Record(Reader.readString());
+  if (Reader.failed())
+    return false;
+  const uint8_t Mode = Record.read<uint8_t>();
+  if (Mode > InstructionBenchmark::Uops)
+    return false;
+  Benchmark.Mode = static_cast<InstructionBenchmark::ModeE>(Mode);
+  Benchmark.CpuName = Record.readString();
+  Benchmark.LLVMTriple = Record.readString();
+  Benchmark.Info = Record.readString();
+  Benchmark.Error = Record.readString();
+  Benchmark.Key.Config = Record.readString();
+  Benchmark.NumRepetitions = Record.read<uint32_t>();
+  for (uint32_t I = 0, E = Record.read<uint32_t>(); I < E && !Record.failed();
+       ++I) {
+    llvm::MCInst Inst;
+    Inst.setOpcode(Context.getInstrOpcode(Record.readString()));
+    for (uint32_t J = 0, F = Record.read<uint32_t>();
+         J < F && !Record.failed(); ++J) {
+      switch (Record.read<uint8_t>()) {
+      case kRegOperand:
+        Inst.addOperand(
+            llvm::MCOperand::createReg(Context.getRegNo(Record.readString())));
+        break;
+      case kImmOperand:
+        Inst.addOperand(llvm::MCOperand::createImm(Record.read<int64_t>()));
+        break;
+      case kFPImmOperand:
+        Inst.addOperand(llvm::MCOperand::createFPImm(Record.readDouble()));
+        break;
+      default:
+        Inst.addOperand(llvm::MCOperand());
+        break;
+      }
+    }
+    Benchmark.Key.Instructions.push_back(Inst);
+  }
+  for (uint32_t I = 0, E = Record.read<uint32_t>(); I < E && !Record.failed();
+       ++I) {
+    BenchmarkMeasure Measure;
+    Measure.Key = Record.readString();
+    Measure.Value = Record.readDouble();
+    Measure.DebugString = Record.readString();
+    Benchmark.Measurements.push_back(std::move(Measure));
+  }
+  const llvm::StringRef Snippet = Record.readString();
+  Benchmark.AssembledSnippet.assign(Snippet.bytes_begin(), Snippet.bytes_end());
+  return !Record.failed() && Record.atEnd();
+}
+
+static llvm::Expected<std::vector<InstructionBenchmark>>
+readBinaryData(const BenchmarkResultContext &Context, llvm::StringRef Filename,
+               llvm::StringRef Data) {
+  if (!isBinary(Data))
+    return llvm::make_error<llvm::StringError>(
+        Filename + " is not a binary benchmark file",
+        llvm::inconvertibleErrorCode());
+  BinaryReader Reader(Data);
+  std::vector<InstructionBenchmark> Benchmarks;
+  while (!Reader.atEnd()) {
+    // Concatenated files have a header at the start of each of them.
+    if (Reader.skipHeader())
+      continue;
+    Benchmarks.emplace_back();
+    if (!readBinary(Context, Reader, Benchmarks.back()))
+      return llvm::make_error<llvm::StringError>(
+          "malformed binary benchmark file " + Filename,
+          llvm::inconvertibleErrorCode());
+  }
+  return std::move(Benchmarks);
+}
+
+llvm::Expected<std::vector<InstructionBenchmark>>
+InstructionBenchmark::readBinaries(const BenchmarkResultContext &Context,
+                                   llvm::StringRef Filename) {
+  // Large files are mapped rather than read.
+  auto ExpectedMemoryBuffer =
+      llvm::errorOrToExpected(llvm::MemoryBuffer::getFile(Filename));
+  if (!ExpectedMemoryBuffer)
+    return ExpectedMemoryBuffer.takeError();
+  return readBinaryData(Context, Filename,
+                        (*ExpectedMemoryBuffer)->getBuffer());
+}
+
+llvm::Expected<std::vector<InstructionBenchmark>>
+InstructionBenchmark::readFile(const BenchmarkResultContext &Context,
+                               llvm::StringRef Filename) {
+  auto ExpectedMemoryBuffer =
+      llvm::errorOrToExpected(llvm::MemoryBuffer::getFile(Filename));
+  if (!ExpectedMemoryBuffer)
+    return ExpectedMemoryBuffer.takeError();
+  const llvm::StringRef Data = (*ExpectedMemoryBuffer)->getBuffer();
+  if (isBinary(Data))
+    return readBinaryData(Context, Filename, Data);
+  return readYamls(Context, Filename);
+}
+
 void BenchmarkMeasureStats::push(const BenchmarkMeasure &BM) {
   if (Key.empty())
     Key = BM.Key;
@@ -75,6 +75,21 @@ struct InstructionBenchmark {
 
   llvm::Error writeYaml(const BenchmarkResultContext &Context,
                         const llvm::StringRef Filename);
+
+  // The binary format is a compact alternative to Yaml for large sweeps. A
+  // file is a header followed by any number of benchmarks, and files can be
+  // concatenated.
+  static void writeBinaryHeader(llvm::raw_ostream &S);
+
+  void writeBinaryTo(const BenchmarkResultContext &Context,
+                     llvm::raw_ostream &S) const;
+
+  static llvm::Expected<std::vector<InstructionBenchmark>>
+  readBinaries(const BenchmarkResultContext &Context, llvm::StringRef Filename);
+
+  // Reads a file in either format.
+  static llvm::Expected<std::vector<InstructionBenchmark>>
+  readFile(const BenchmarkResultContext &Context, llvm::StringRef Filename);
 };
 
 //------------------------------------------------------------------------------
@@ -59,6 +59,18 @@ BenchmarkRunner::run(unsigned Opcode, unsigned NumRepetitions) {
   return InstrBenchmarks;
 }
 
+InstructionBenchmark
+BenchmarkRunner::runSnippet(llvm::ArrayRef<llvm::MCInst> Snippet,
+                            llvm::StringRef Info,
+                            unsigned NumRepetitions) const {
+  BenchmarkConfiguration Configuration;
+  Configuration.Info = Info;
+  Configuration.Snippet = Snippet;
+  Configuration.SnippetSetup.RegsToDef = computeRegsToDef(Snippet);
+  const unsigned Opcode = Snippet.empty() ? 0 : Snippet[0].getOpcode();
+  return runOne(Configuration, Opcode, NumRepetitions);
+}
+
 InstructionBenchmark
 BenchmarkRunner::runOne(const BenchmarkConfiguration &Configuration,
                         unsigned Opcode, unsigned NumRepetitions) const {
@@ -182,6 +194,41 @@ std::vector<unsigned> BenchmarkRunner::computeRegsToDef(
   return RegsToDef;
 }
 
+std::vector<unsigned>
+BenchmarkRunner::computeRegsToDef(llvm::ArrayRef<llvm::MCInst> Snippet) const {
+  const llvm::MCInstrInfo &InstrInfo = State.getInstrInfo();
+  // Same invariant as above: DefinedRegs[i] is true iif it has been set at
+  // least once before the current instruction. Reserved registers (e.g. the
+  // stack pointer) are left alone.
+  llvm::BitVector DefinedRegs = RATC.reservedRegisters();
+  std::vector<unsigned> RegsToDef;
+  const auto UseReg = [&DefinedRegs, &RegsToDef](unsigned Reg) {
+    if (Reg > 0 && !DefinedRegs.test(Reg)) {
+      RegsToDef.push_back(Reg);
+      DefinedRegs.set(Reg);
+    }
+  };
+  for (const llvm::MCInst &Inst : Snippet) {
+    const llvm::MCInstrDesc &InstrDesc = InstrInfo.get(Inst.getOpcode());
+    for (unsigned I = InstrDesc.getNumDefs(), E = Inst.getNumOperands(); I < E;
+         ++I) {
+      if (Inst.getOperand(I).isReg())
+        UseReg(Inst.getOperand(I).getReg());
+    }
+    for (const llvm::MCPhysReg *Reg = InstrDesc.getImplicitUses();
+         Reg && *Reg; ++Reg)
+      UseReg(*Reg);
+    for (unsigned I = 0, E = InstrDesc.getNumDefs(); I < E; ++I) {
+      if (Inst.getOperand(I).isReg() && Inst.getOperand(I).getReg())
+        DefinedRegs.set(Inst.getOperand(I).getReg());
+    }
+    for (const llvm::MCPhysReg *Reg = InstrDesc.getImplicitDefs();
+         Reg && *Reg; ++Reg)
+      DefinedRegs.set(*Reg);
+  }
+  return RegsToDef;
+}
+
 llvm::Expected<std::string>
 BenchmarkRunner::writeObjectFile(const BenchmarkConfiguration::Setup &Setup,
                                  llvm::ArrayRef<llvm::MCInst> Code) const {
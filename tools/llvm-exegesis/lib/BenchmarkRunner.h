@@ -61,10 +61,21 @@ public:
   llvm::Expected<std::vector<InstructionBenchmark>>
   run(unsigned Opcode, unsigned NumRepetitions);
 
+  // Measures a snippet given by the user instead of generating one from an
+  // opcode, e.g. a basic block from a hot loop. `Info` describes where the
+  // snippet comes from.
+  InstructionBenchmark runSnippet(llvm::ArrayRef<llvm::MCInst> Snippet,
+                                  llvm::StringRef Info,
+                                  unsigned NumRepetitions) const;
+
   // Given a snippet, computes which registers the setup code needs to define.
   std::vector<unsigned>
   computeRegsToDef(const std::vector<InstructionInstance> &Snippet) const;
 
+  // Same as above, for a snippet that is already built.
+  std::vector<unsigned>
+  computeRegsToDef(llvm::ArrayRef<llvm::MCInst> Snippet) const;
+
 protected:
   const LLVMState &State;
   const RegisterAliasingTrackerCache RATC;
@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "Clustering.h"
+#include <algorithm>
 #include <string>
 #include <unordered_set>
 
@@ -24,28 +25,69 @@ namespace exegesis {
 // k-means and makes algorithms such as DBSCAN[1] or OPTICS[2] more applicable.
 //
 // We've used DBSCAN here because it's simple to implement. This is a pretty
-// straightforward and inefficient implementation of the pseudocode in [2].
+// straightforward implementation of the pseudocode in [2]. To scale to full
+// sweeps (~100k points), the neighbors of a point are found with a k-d tree[3]
+// rather than by looking at all the other points.
 //
 // [1] https://en.wikipedia.org/wiki/DBSCAN
 // [2] https://en.wikipedia.org/wiki/OPTICS_algorithm
+// [3] https://en.wikipedia.org/wiki/K-d_tree
+
+// Arranges PointTree_[Lo, Hi) so that the point in the middle splits the others
+// on dimension Depth % NumDimensions_, and recurses on both halves.
+void InstructionBenchmarkClustering::buildPointTree(const size_t Lo,
+                                                    const size_t Hi,
+                                                    const size_t Depth) {
+  if (Hi - Lo <= 1 || NumDimensions_ == 0)
+    return;
+  const size_t Dimension = Depth % NumDimensions_;
+  const size_t Mid = Lo + (Hi - Lo) / 2;
+  std::nth_element(PointTree_.begin() + Lo, PointTree_.begin() + Mid,
+                   PointTree_.begin() + Hi,
+                   [this, Dimension](const size_t A, const size_t B) {
+                     return Points_[A].Measurements[Dimension].Value <
+                            Points_[B].Measurements[Dimension].Value;
+                   });
+  buildPointTree(Lo, Mid, Depth + 1);
+  buildPointTree(Mid + 1, Hi, Depth + 1);
+}
 
 // Finds the points at distance less than sqrt(EpsilonSquared) of Q (not
-// including Q).
+// including Q), sorted by index.
 std::vector<size_t>
 InstructionBenchmarkClustering::rangeQuery(const size_t Q) const {
   std::vector<size_t> Neighbors;
+  rangeQuery(Q, 0, PointTree_.size(), 0, Neighbors);
+  std::sort(Neighbors.begin(), Neighbors.end());
+  return Neighbors;
+}
+
+void InstructionBenchmarkClustering::rangeQuery(
+    const size_t Q, const size_t Lo, const size_t Hi, const size_t Depth,
+    std::vector<size_t> &Neighbors) const {
+  if (Lo >= Hi)
+    return;
   const auto &QMeasurements = Points_[Q].Measurements;
-  for (size_t P = 0, NumPoints = Points_.size(); P < NumPoints; ++P) {
-    if (P == Q)
-      continue;
-    const auto &PMeasurements = Points_[P].Measurements;
-    if (PMeasurements.empty()) // Error point.
-      continue;
-    if (isNeighbour(PMeasurements, QMeasurements)) {
-      Neighbors.push_back(P);
-    }
+  if (NumDimensions_ == 0) {
+    // All the points are at the same place.
+    for (size_t I = Lo; I < Hi; ++I)
+      if (PointTree_[I] != Q)
+        Neighbors.push_back(PointTree_[I]);
+    return;
   }
-  return Neighbors;
+  const size_t Mid = Lo + (Hi - Lo) / 2;
+  const size_t P = PointTree_[Mid];
+  const auto &PMeasurements = Points_[P].Measurements;
+  if (P != Q && isNeighbour(PMeasurements, QMeasurements))
+    Neighbors.push_back(P);
+  // Only visit the halves that intersect the ball around Q.
+  const size_t Dimension = Depth % NumDimensions_;
+  const double Diff =
+      QMeasurements[Dimension].Value - PMeasurements[Dimension].Value;
+  if (Diff <= 0.0 || Diff * Diff <= EpsilonSquared_)
+    rangeQuery(Q, Lo, Mid, Depth + 1, Neighbors);
+  if (Diff >= 0.0 || Diff * Diff <= EpsilonSquared_)
+    rangeQuery(Q, Mid + 1, Hi, Depth + 1, Neighbors);
 }
 
 bool InstructionBenchmarkClustering::isNeighbour(
@@ -97,6 +139,10 @@ llvm::Error InstructionBenchmarkClustering::validateAndSetup() {
   if (LastMeasurement) {
     NumDimensions_ = LastMeasurement->size();
   }
+  for (size_t P = 0, NumPoints = Points_.size(); P < NumPoints; ++P)
+    if (!Points_[P].Measurements.empty()) // Not an error point.
+      PointTree_.push_back(P);
+  buildPointTree(0, PointTree_.size(), 0);
   return llvm::Error::success();
 }
 
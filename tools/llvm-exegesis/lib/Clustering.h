@@ -96,13 +96,20 @@ private:
       const std::vector<InstructionBenchmark> &Points, double EpsilonSquared);
   llvm::Error validateAndSetup();
   void dbScan(size_t MinPts);
+  void buildPointTree(size_t Lo, size_t Hi, size_t Depth);
   std::vector<size_t> rangeQuery(size_t Q) const;
+  void rangeQuery(size_t Q, size_t Lo, size_t Hi, size_t Depth,
+                  std::vector<size_t> &Neighbors) const;
 
   const std::vector<InstructionBenchmark> &Points_;
   const double EpsilonSquared_;
   int NumDimensions_ = 0;
   // ClusterForPoint_[P] is the cluster id for Points[P].
   std::vector<ClusterId> ClusterIdForPoint_;
+  // The indices of the points with measurements, as a k-d tree: the points in
+  // PointTree_[Lo, Hi) are split around the one in the middle, on dimension
+  // Depth % NumDimensions_, Depth being the depth of [Lo, Hi) in the tree.
+  std::vector<size_t> PointTree_;
   std::vector<Cluster> Clusters_;
   Cluster NoiseCluster_;
   Cluster ErrorCluster_;
@@ -0,0 +1,109 @@
+//===-- CpuTopology.cpp -----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "CpuTopology.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Threading.h"
+#include <algorithm>
+#include <cerrno>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace exegesis {
+
+llvm::Expected<std::vector<unsigned>> parseCpuList(llvm::StringRef List) {
+  std::vector<unsigned> Cpus;
+  llvm::SmallVector<llvm::StringRef, 8> Ranges;
+  List.trim().split(Ranges, ',', -1, /*KeepEmpty=*/false);
+  for (llvm::StringRef Range : Ranges) {
+    llvm::StringRef First, Last;
+    std::tie(First, Last) = Range.trim().split('-');
+    unsigned Begin = 0, End = 0;
+    bool Invalid = First.getAsInteger(10, Begin);
+    End = Begin;
+    if (Range.contains('-'))
+      Invalid |= Last.getAsInteger(10, End) || End < Begin;
+    if (Invalid)
+      return llvm::make_error<llvm::StringError>(
+          llvm::Twine("invalid cpu list '") + List + "'",
+          llvm::inconvertibleErrorCode());
+    for (unsigned Cpu = Begin; Cpu <= End; ++Cpu)
+      Cpus.push_back(Cpu);
+  }
+  std::sort(Cpus.begin(), Cpus.end());
+  Cpus.erase(std::unique(Cpus.begin(), Cpus.end()), Cpus.end());
+  return Cpus;
+}
+
+// Reads a cpu list from sysfs. Returns an empty list if the file doesn't
+// exist.
+static std::vector<unsigned> readCpuList(const llvm::Twine &Path) {
+  // sysfs files report a size that is unrelated to their content.
+  auto BufferOrErr = llvm::MemoryBuffer::getFileAsStream(Path);
+  if (!BufferOrErr)
+    return {};
+  auto CpusOrErr = parseCpuList((*BufferOrErr)->getBuffer());
+  if (!CpusOrErr) {
+    llvm::consumeError(CpusOrErr.takeError());
+    return {};
+  }
+  return std::move(*CpusOrErr);
+}
+
+std::vector<unsigned> getIsolatedCpus() {
+  return readCpuList("/sys/devices/system/cpu/isolated");
+}
+
+std::vector<unsigned> getCoreSiblings(unsigned Cpu) {
+  std::vector<unsigned> Siblings = readCpuList(
+      "/sys/devices/system/cpu/cpu" + llvm::Twine(Cpu) +
+      "/topology/thread_siblings_list");
+  if (Siblings.empty())
+    Siblings.push_back(Cpu);
+  return Siblings;
+}
+
+std::vector<unsigned> getPhysicalCores() {
+  std::vector<unsigned> Cpus = readCpuList("/sys/devices/system/cpu/online");
+  if (Cpus.empty()) {
+    // Without topology information, assume that there is no SMT.
+    for (unsigned Cpu = 0, E = llvm::hardware_concurrency(); Cpu < E; ++Cpu)
+      Cpus.push_back(Cpu);
+    return Cpus;
+  }
+  // Keep the first thread of each core.
+  std::vector<unsigned> Cores;
+  for (unsigned Cpu : Cpus)
+    if (getCoreSiblings(Cpu).front() == Cpu)
+      Cores.push_back(Cpu);
+  return Cores;
+}
+
+llvm::Error pinCurrentThreadToCpu(unsigned Cpu) {
+#ifdef __linux__
+  cpu_set_t CpuSet;
+  CPU_ZERO(&CpuSet);
+  CPU_SET(Cpu, &CpuSet);
+  if (sched_setaffinity(0, sizeof(CpuSet), &CpuSet) != 0)
+    return llvm::make_error<llvm::StringError>(
+        "cannot pin to cpu " + llvm::Twine(Cpu),
+        std::error_code(errno, std::generic_category()));
+  return llvm::Error::success();
+#else
+  return llvm::make_error<llvm::StringError>(
+      "pinning to a cpu is not supported on this host",
+      llvm::inconvertibleErrorCode());
+#endif
+}
+
+} // namespace exegesis
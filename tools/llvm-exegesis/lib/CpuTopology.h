@@ -0,0 +1,45 @@
+//===-- CpuTopology.h -------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Helpers to pick the host cpus that benchmarks run on, and to pin them there.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TOOLS_LLVM_EXEGESIS_CPUTOPOLOGY_H
+#define LLVM_TOOLS_LLVM_EXEGESIS_CPUTOPOLOGY_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+#include <vector>
+
+namespace exegesis {
+
+// Parses a list of cpus in the format used by Linux, e.g. "0-3,8,10-11".
+llvm::Expected<std::vector<unsigned>> parseCpuList(llvm::StringRef List);
+
+// Returns the cpus that the kernel keeps the other tasks away from (see the
+// isolcpus boot parameter). Returns an empty list if there are none, or if this
+// is not supported on the host.
+std::vector<unsigned> getIsolatedCpus();
+
+// Returns the logical cpus that share a physical core with Cpu, including Cpu
+// itself.
+std::vector<unsigned> getCoreSiblings(unsigned Cpu);
+
+// Returns one logical cpu per physical core of the host, in increasing order.
+std::vector<unsigned> getPhysicalCores();
+
+// Restricts the current thread to run on Cpu. The perf counters opened
+// afterwards then only count events from that cpu.
+llvm::Error pinCurrentThreadToCpu(unsigned Cpu);
+
+} // namespace exegesis
+
+#endif // LLVM_TOOLS_LLVM_EXEGESIS_CPUTOPOLOGY_H
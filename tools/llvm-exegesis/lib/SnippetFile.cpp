@@ -0,0 +1,98 @@
+//===-- SnippetFile.cpp -----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SnippetFile.h"
+#include "llvm/MC/MCContext.h"
+#include "llvm/MC/MCObjectFileInfo.h"
+#include "llvm/MC/MCParser/MCAsmParser.h"
+#include "llvm/MC/MCParser/MCTargetAsmParser.h"
+#include "llvm/MC/MCStreamer.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetRegistry.h"
+
+namespace exegesis {
+namespace {
+
+// An MCStreamer that keeps the instructions and drops everything else.
+class InstructionCollector : public llvm::MCStreamer {
+public:
+  explicit InstructionCollector(llvm::MCContext &Context)
+      : llvm::MCStreamer(Context) {}
+
+  void EmitInstruction(const llvm::MCInst &Instruction,
+                       const llvm::MCSubtargetInfo &STI,
+                       bool PrintSchedInfo) override {
+    Instructions.push_back(Instruction);
+  }
+
+  std::vector<llvm::MCInst> takeInstructions() {
+    return std::move(Instructions);
+  }
+
+private:
+  bool EmitSymbolAttribute(llvm::MCSymbol *Symbol,
+                           llvm::MCSymbolAttr Attribute) override {
+    return true;
+  }
+  void EmitCommonSymbol(llvm::MCSymbol *Symbol, uint64_t Size,
+                        unsigned ByteAlignment) override {}
+  void EmitZerofill(llvm::MCSection *Section, llvm::MCSymbol *Symbol,
+                    uint64_t Size, unsigned ByteAlignment) override {}
+
+  std::vector<llvm::MCInst> Instructions;
+};
+
+} // namespace
+
+llvm::Expected<std::vector<llvm::MCInst>>
+readSnippet(const LLVMState &State, llvm::StringRef Filename) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> BufferOrErr =
+      llvm::MemoryBuffer::getFileOrSTDIN(Filename);
+  if (std::error_code EC = BufferOrErr.getError())
+    return llvm::make_error<llvm::StringError>(
+        "cannot read snippet file '" + Filename + "'", EC);
+
+  const llvm::TargetMachine &TM = State.getTargetMachine();
+  llvm::SourceMgr SM;
+  SM.AddNewSourceBuffer(std::move(*BufferOrErr), llvm::SMLoc());
+
+  llvm::MCObjectFileInfo ObjectFileInfo;
+  llvm::MCContext Context(TM.getMCAsmInfo(), TM.getMCRegisterInfo(),
+                          &ObjectFileInfo, &SM);
+  ObjectFileInfo.InitMCObjectFileInfo(TM.getTargetTriple(), /*PIC=*/false,
+                                      Context);
+
+  InstructionCollector Streamer(Context);
+  std::unique_ptr<llvm::MCAsmParser> AsmParser(
+      llvm::createMCAsmParser(SM, Context, Streamer, *TM.getMCAsmInfo()));
+  std::unique_ptr<llvm::MCTargetAsmParser> TargetAsmParser(
+      TM.getTarget().createMCAsmParser(*TM.getMCSubtargetInfo(), *AsmParser,
+                                       *TM.getMCInstrInfo(),
+                                       llvm::MCTargetOptions()));
+  if (!TargetAsmParser)
+    return llvm::make_error<llvm::StringError>(
+        "cannot create target asm parser", llvm::inconvertibleErrorCode());
+  AsmParser->setTargetParser(*TargetAsmParser);
+
+  // The parser reports the errors to the SourceMgr, so they are already
+  // printed when it fails.
+  if (AsmParser->Run(/*NoInitialTextSection=*/false))
+    return llvm::make_error<llvm::StringError>(
+        "cannot parse snippet file '" + Filename + "'",
+        llvm::inconvertibleErrorCode());
+  std::vector<llvm::MCInst> Instructions = Streamer.takeInstructions();
+  if (Instructions.empty())
+    return llvm::make_error<llvm::StringError>(
+        "snippet file '" + Filename + "' has no instructions",
+        llvm::inconvertibleErrorCode());
+  return std::move(Instructions);
+}
+
+} // namespace exegesis
@@ -0,0 +1,33 @@
+//===-- SnippetFile.h -------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Reads the instructions of a snippet to benchmark from an assembly file.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TOOLS_LLVM_EXEGESIS_SNIPPETFILE_H
+#define LLVM_TOOLS_LLVM_EXEGESIS_SNIPPETFILE_H
+
+#include "LlvmState.h"
+#include "llvm/MC/MCInst.h"
+#include "llvm/Support/Error.h"
+#include <vector>
+
+namespace exegesis {
+
+// Parses the assembly in `Filename` and returns its instructions, in order.
+// Directives and labels are ignored, so the file should contain a single
+// straight-line sequence of instructions, e.g. a basic block from a hot loop.
+llvm::Expected<std::vector<llvm::MCInst>>
+readSnippet(const LLVMState &State, llvm::StringRef Filename);
+
+} // namespace exegesis
+
+#endif // LLVM_TOOLS_LLVM_EXEGESIS_SNIPPETFILE_H
@@ -16,8 +16,10 @@
 #include "lib/BenchmarkResult.h"
 #include "lib/BenchmarkRunner.h"
 #include "lib/Clustering.h"
+#include "lib/CpuTopology.h"
 #include "lib/LlvmState.h"
 #include "lib/PerfHelper.h"
+#include "lib/SnippetFile.h"
 #include "lib/Target.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/Twine.h"
@@ -26,7 +28,10 @@
 #include "llvm/MC/MCSubtargetInfo.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Program.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
 #include <algorithm>
@@ -42,9 +47,47 @@ static llvm::cl::opt<std::string>
     OpcodeName("opcode-name", llvm::cl::desc("opcode to measure, by name"),
                llvm::cl::init(""));
 
+static llvm::cl::opt<bool>
+    AllOpcodes("all-opcodes",
+               llvm::cl::desc("measure all the opcodes, one after the other"),
+               llvm::cl::init(false));
+
+static llvm::cl::opt<unsigned> NumWorkers(
+    "num-workers",
+    llvm::cl::desc("with -all-opcodes, number of processes to split the "
+                   "opcodes between, each pinned to its own physical core"),
+    llvm::cl::init(1));
+
+static llvm::cl::opt<std::string> WorkerCpus(
+    "worker-cpus",
+    llvm::cl::desc("cpus to pin the workers to, e.g. '2-5,8' (default: one "
+                   "per physical core, isolated cores first)"),
+    llvm::cl::init(""));
+
+// Used by a process started by -num-workers to find its share of the opcodes.
+static llvm::cl::opt<int> WorkerIndex("worker-index", llvm::cl::Hidden,
+                                      llvm::cl::init(-1));
+static llvm::cl::opt<unsigned> WorkerCpu("worker-cpu", llvm::cl::Hidden,
+                                         llvm::cl::init(0));
+
+static llvm::cl::opt<std::string>
+    SnippetsFile("snippets-file",
+                 llvm::cl::desc("code snippet to measure, in assembly, "
+                                "instead of an opcode"),
+                 llvm::cl::init(""));
+
 static llvm::cl::opt<std::string>
     BenchmarkFile("benchmarks-file", llvm::cl::desc(""), llvm::cl::init(""));
 
+enum class BenchmarksFormat { Yaml, Binary };
+
+static llvm::cl::opt<BenchmarksFormat> BenchmarkFormat(
+    "benchmarks-format", llvm::cl::desc("the format of the benchmarks file"),
+    llvm::cl::values(clEnumValN(BenchmarksFormat::Yaml, "yaml", "Yaml"),
+                     clEnumValN(BenchmarksFormat::Binary, "binary",
+                                "Compact binary format, faster to analyze")),
+    llvm::cl::init(BenchmarksFormat::Yaml));
+
 static llvm::cl::opt<exegesis::InstructionBenchmark::ModeE> BenchmarkMode(
     "mode", llvm::cl::desc("the mode to run"),
     llvm::cl::values(clEnumValN(exegesis::InstructionBenchmark::Latency,
@@ -82,6 +125,11 @@ static llvm::cl::opt<std::string>
 static llvm::cl::opt<std::string>
     AnalysisInconsistenciesOutputFile("analysis-inconsistencies-output-file",
                                       llvm::cl::desc(""), llvm::cl::init("-"));
+static llvm::cl::opt<std::string> AnalysisValidationOutputFile(
+    "analysis-validation-output-file",
+    llvm::cl::desc("where to print the sched classes whose predicted cycles "
+                   "differ the most from the latency measurements"),
+    llvm::cl::init(""));
 
 namespace exegesis {
 
@@ -119,7 +167,144 @@ getBenchmarkResultContext(const LLVMState &State) {
   return Ctx;
 }
 
-void benchmarkMain() {
+// Returns the cpus to run the workers on, and warns about the ones that other
+// tasks may disturb.
+static std::vector<unsigned> selectWorkerCpus() {
+  const std::vector<unsigned> IsolatedCpus = getIsolatedCpus();
+  const auto IsIsolated = [&IsolatedCpus](unsigned Cpu) {
+    return std::binary_search(IsolatedCpus.begin(), IsolatedCpus.end(), Cpu);
+  };
+
+  std::vector<unsigned> Cpus;
+  if (WorkerCpus.empty()) {
+    Cpus = getPhysicalCores();
+    std::stable_partition(Cpus.begin(), Cpus.end(), IsIsolated);
+  } else {
+    auto CpusOrErr = parseCpuList(WorkerCpus);
+    if (!CpusOrErr)
+      llvm::report_fatal_error(CpusOrErr.takeError());
+    Cpus = std::move(*CpusOrErr);
+  }
+  if (Cpus.size() < NumWorkers)
+    llvm::report_fatal_error(llvm::Twine("cannot run ") +
+                             llvm::Twine(NumWorkers) + " workers on " +
+                             llvm::Twine(Cpus.size()) + " cpus");
+  Cpus.resize(NumWorkers);
+
+  for (const unsigned Cpu : Cpus) {
+    if (!IsIsolated(Cpu))
+      llvm::errs() << "warning: cpu " << Cpu
+                   << " is not isolated, other tasks may disturb the "
+                      "measurements\n";
+    // Workers on the same physical core compete for its execution ports.
+    for (const unsigned Sibling : getCoreSiblings(Cpu))
+      if (Sibling > Cpu &&
+          std::find(Cpus.begin(), Cpus.end(), Sibling) != Cpus.end())
+        llvm::errs() << "warning: cpus " << Cpu << " and " << Sibling
+                     << " share a physical core\n";
+  }
+  return Cpus;
+}
+
+static llvm::sys::fs::OpenFlags getBenchmarkFileFlags() {
+  return BenchmarkFormat == BenchmarksFormat::Binary ? llvm::sys::fs::F_None
+                                                     : llvm::sys::fs::F_Text;
+}
+
+static void writeBenchmark(const BenchmarkResultContext &Context,
+                           InstructionBenchmark &Benchmark,
+                           llvm::raw_ostream &OS) {
+  if (BenchmarkFormat == BenchmarksFormat::Binary)
+    Benchmark.writeBinaryTo(Context, OS);
+  else
+    Benchmark.writeYamlTo(Context, OS);
+}
+
+// Splits the opcodes between NumWorkers processes pinned to distinct cpus, and
+// merges their results into BenchmarkFile.
+static void runWorkers(const char *Argv0) {
+  const std::vector<unsigned> Cpus = selectWorkerCpus();
+  const std::string Executable = llvm::sys::fs::getMainExecutable(
+      Argv0, reinterpret_cast<void *>(&runWorkers));
+
+  std::vector<std::string> OutputFiles(NumWorkers);
+  std::vector<llvm::sys::ProcessInfo> Workers(NumWorkers);
+  for (unsigned I = 0; I < NumWorkers; ++I) {
+    llvm::SmallString<256> OutputFile;
+    if (std::error_code EC = llvm::sys::fs::createTemporaryFile(
+            "exegesis-worker",
+            BenchmarkFormat == BenchmarksFormat::Binary ? "bin" : "yaml",
+            OutputFile))
+      llvm::report_fatal_error("cannot create worker output file: " +
+                               EC.message());
+    OutputFiles[I] = OutputFile.str();
+
+    const std::vector<std::string> ArgStrings = {
+        Executable,
+        BenchmarkMode == InstructionBenchmark::Latency ? "-mode=latency"
+                                                       : "-mode=uops",
+        "-all-opcodes",
+        "-num-repetitions=" + llvm::utostr(NumRepetitions),
+        std::string("-ignore-invalid-sched-class=") +
+            (IgnoreInvalidSchedClass ? "true" : "false"),
+        "-num-workers=" + llvm::utostr(NumWorkers),
+        "-worker-index=" + llvm::utostr(I),
+        "-worker-cpu=" + llvm::utostr(Cpus[I]),
+        BenchmarkFormat == BenchmarksFormat::Binary
+            ? "-benchmarks-format=binary"
+            : "-benchmarks-format=yaml",
+        "-benchmarks-file=" + OutputFiles[I]};
+    const std::vector<llvm::StringRef> Args(ArgStrings.begin(),
+                                            ArgStrings.end());
+    // The workers report what they assemble on stdout: silence them.
+    const llvm::Optional<llvm::StringRef> Redirects[] = {
+        llvm::None, llvm::StringRef(""), llvm::None};
+    std::string ErrMsg;
+    Workers[I] = llvm::sys::ExecuteNoWait(Executable, Args, llvm::None,
+                                          Redirects, 0, &ErrMsg);
+    if (!Workers[I].Pid)
+      llvm::report_fatal_error("cannot start worker: " + ErrMsg);
+  }
+
+  // Both formats can be concatenated: the binary reader skips the headers of
+  // the worker files.
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(BenchmarkFile, EC, getBenchmarkFileFlags());
+  if (EC)
+    llvm::report_fatal_error("cannot open out file: " + BenchmarkFile);
+  bool Failed = false;
+  for (unsigned I = 0; I < NumWorkers; ++I) {
+    std::string ErrMsg;
+    const llvm::sys::ProcessInfo Result = llvm::sys::Wait(
+        Workers[I], 0, /*WaitUntilTerminates=*/true, &ErrMsg);
+    if (Result.ReturnCode != 0) {
+      llvm::errs() << "worker " << I << " on cpu " << Cpus[I]
+                   << " failed, its results are incomplete";
+      if (!ErrMsg.empty())
+        llvm::errs() << ": " << ErrMsg;
+      llvm::errs() << "\n";
+      Failed = true;
+    }
+    if (auto Buffer = llvm::MemoryBuffer::getFile(OutputFiles[I]))
+      OS << (*Buffer)->getBuffer();
+    llvm::sys::fs::remove(OutputFiles[I]);
+  }
+  OS.flush();
+  if (Failed)
+    exit(EXIT_FAILURE);
+}
+
+void benchmarkMain(const char *Argv0) {
+  if (AllOpcodes && NumWorkers > 1 && WorkerIndex < 0)
+    return runWorkers(Argv0);
+
+  if (WorkerIndex >= 0) {
+    // Pin before opening the perf counters, so that they count events from
+    // this cpu only.
+    if (llvm::Error Err = pinCurrentThreadToCpu(WorkerCpu))
+      llvm::report_fatal_error(std::move(Err));
+  }
+
   if (exegesis::pfm::pfmInitialize())
     llvm::report_fatal_error("cannot initialize libpfm");
 
@@ -130,14 +315,24 @@ void benchmarkMain() {
 #endif
 
   const LLVMState State;
-  const auto Opcode = GetOpcodeOrDie(State.getInstrInfo());
-
-  // Ignore instructions without a sched class if -ignore-invalid-sched-class is
-  // passed.
-  if (IgnoreInvalidSchedClass &&
-      State.getInstrInfo().get(Opcode).getSchedClass() == 0) {
-    llvm::errs() << "ignoring instruction without sched class\n";
-    return;
+  std::vector<unsigned> Opcodes;
+  std::vector<llvm::MCInst> Snippet;
+  if (AllOpcodes) {
+    // Interleave the opcodes between the workers, so that each gets a similar
+    // mix of instructions.
+    const unsigned Shard = WorkerIndex < 0 ? 0 : WorkerIndex;
+    const unsigned NumShards = WorkerIndex < 0 ? 1 : NumWorkers;
+    for (unsigned I = 1, E = State.getInstrInfo().getNumOpcodes(); I < E; ++I)
+      if (I % NumShards == Shard)
+        Opcodes.push_back(I);
+  } else if (SnippetsFile.empty()) {
+    Opcodes.push_back(GetOpcodeOrDie(State.getInstrInfo()));
+  } else {
+    llvm::InitializeNativeTargetAsmParser();
+    auto SnippetOrErr = readSnippet(State, SnippetsFile);
+    if (!SnippetOrErr)
+      llvm::report_fatal_error(SnippetOrErr.takeError());
+    Snippet = std::move(*SnippetOrErr);
   }
 
   // FIXME: Do not require SchedModel for latency.
@@ -157,11 +352,41 @@ void benchmarkMain() {
   if (BenchmarkFile.empty())
     BenchmarkFile = "-";
 
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(BenchmarkFile, EC, getBenchmarkFileFlags());
+  if (EC)
+    llvm::report_fatal_error("cannot open out file: " + BenchmarkFile);
+
   const BenchmarkResultContext Context = getBenchmarkResultContext(State);
-  std::vector<InstructionBenchmark> Results =
-      ExitOnErr(Runner->run(Opcode, NumRepetitions));
-  for (InstructionBenchmark &Result : Results)
-    ExitOnErr(Result.writeYaml(Context, BenchmarkFile));
+  if (BenchmarkFormat == BenchmarksFormat::Binary)
+    InstructionBenchmark::writeBinaryHeader(OS);
+  if (!Snippet.empty()) {
+    InstructionBenchmark Result = Runner->runSnippet(
+        Snippet, "snippet from " + SnippetsFile, NumRepetitions);
+    writeBenchmark(Context, Result, OS);
+  }
+  for (const unsigned Opcode : Opcodes) {
+    // Ignore instructions without a sched class if
+    // -ignore-invalid-sched-class is passed.
+    if (IgnoreInvalidSchedClass &&
+        State.getInstrInfo().get(Opcode).getSchedClass() == 0) {
+      if (!AllOpcodes)
+        llvm::errs() << "ignoring instruction without sched class\n";
+      continue;
+    }
+
+    auto ResultsOrErr = Runner->run(Opcode, NumRepetitions);
+    if (!ResultsOrErr) {
+      // When sweeping, report the opcodes we cannot measure and move on.
+      if (!AllOpcodes)
+        ExitOnErr(ResultsOrErr.takeError());
+      llvm::errs() << State.getInstrInfo().getName(Opcode) << ": "
+                   << llvm::toString(ResultsOrErr.takeError()) << "\n";
+      continue;
+    }
+    for (InstructionBenchmark &Result : *ResultsOrErr)
+      writeBenchmark(Context, Result, OS);
+  }
 
   exegesis::pfm::pfmTerminate();
 }
@@ -197,7 +422,7 @@ static void analysisMain() {
   // Read benchmarks.
   const LLVMState State;
   const std::vector<InstructionBenchmark> Points =
-      ExitOnErr(InstructionBenchmark::readYamls(
+      ExitOnErr(InstructionBenchmark::readFile(
           getBenchmarkResultContext(State), BenchmarkFile));
   llvm::outs() << "Parsed " << Points.size() << " benchmark points\n";
   if (Points.empty()) {
@@ -224,6 +449,8 @@ static void analysisMain() {
   maybeRunAnalysis<Analysis::PrintSchedClassInconsistencies>(
       Analyzer, "sched class consistency analysis",
       AnalysisInconsistenciesOutputFile);
+  maybeRunAnalysis<Analysis::PrintSchedModelValidation>(
+      Analyzer, "sched model validation", AnalysisValidationOutputFile);
 }
 
 } // namespace exegesis
@@ -240,7 +467,7 @@ int main(int Argc, char **Argv) {
   if (BenchmarkMode == exegesis::InstructionBenchmark::Unknown) {
     exegesis::analysisMain();
   } else {
-    exegesis::benchmarkMain();
+    exegesis::benchmarkMain(Argv[0]);
   }
   return EXIT_SUCCESS;
 }
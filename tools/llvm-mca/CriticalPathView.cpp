@@ -0,0 +1,167 @@
+//===--------------------- CriticalPathView.cpp -----------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file implements the CriticalPathView interface.
+///
+//===----------------------------------------------------------------------===//
+
+#include "CriticalPathView.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/FormattedStream.h"
+
+namespace mca {
+
+using namespace llvm;
+
+void CriticalPathView::onInstructionEvent(const HWInstructionEvent &Event) {
+  const unsigned Index = Event.IR.getSourceIndex();
+
+  if (Event.Type == HWInstructionEvent::Issued) {
+    const auto &IssueEvent =
+        static_cast<const HWInstructionIssuedEvent &>(Event);
+    for (const std::pair<ResourceRef, double> &Use : IssueEvent.UsedResources)
+      ResourceCycles[Use.first.first] += Use.second;
+    return;
+  }
+
+  if (Event.Type != HWInstructionEvent::Dispatched)
+    return;
+
+  // Instructions are dispatched in order, so every producer has already been
+  // seen.
+  const auto &DispatchEvent =
+      static_cast<const HWInstructionDispatchedEvent &>(Event);
+  NumMicroOps += Event.IR.getInstruction()->getDesc().NumMicroOps;
+  if (Nodes.size() <= Index)
+    Nodes.resize(Index + 1);
+  NodeInfo &Node = Nodes[Index];
+  Node.Predecessor = Index;
+  for (const RegisterDependency &Dep : DispatchEvent.Dependencies) {
+    assert(Dep.ProducerIndex < Index && "Invalid producer!");
+    unsigned long long Start = Nodes[Dep.ProducerIndex].Start + Dep.Latency;
+    if (Node.Predecessor == Index || Start > Node.Start) {
+      Node.Start = Start;
+      Node.Predecessor = Dep.ProducerIndex;
+      Node.Latency = Dep.Latency;
+    }
+  }
+}
+
+void CriticalPathView::printInstruction(raw_ostream &OS,
+                                        unsigned Index) const {
+  std::string Instruction;
+  raw_string_ostream InstrStream(Instruction);
+  MCIP.printInst(&Source.getMCInstFromIndex(Index), InstrStream, "", STI);
+  InstrStream.flush();
+
+  // Consume any tabs or spaces at the beginning of the string.
+  StringRef Str(Instruction);
+  OS << Str.ltrim() << '\n';
+}
+
+void CriticalPathView::printView(raw_ostream &OS) const {
+  std::string Buffer;
+  raw_string_ostream TempStream(Buffer);
+  formatted_raw_ostream FOS(TempStream);
+
+  const unsigned Size = Source.size();
+  const unsigned Iterations = Source.getNumIterations();
+  const MCSchedModel &SM = STI.getSchedModel();
+
+  // The chain carried from one iteration to the next is the one that grows
+  // the most between the last two iterations.
+  bool HasChain = Iterations > 1 && Nodes.size() == Size * Iterations;
+  unsigned long long ChainLength = 0;
+  unsigned ChainEnd = 0;
+  if (HasChain) {
+    unsigned LastIteration = Size * (Iterations - 1);
+    for (unsigned I = 0; I < Size; ++I) {
+      unsigned long long Length = Nodes[LastIteration + I].Start -
+                                  Nodes[LastIteration - Size + I].Start;
+      if (Length > ChainLength) {
+        ChainLength = Length;
+        ChainEnd = LastIteration + I;
+      }
+    }
+  }
+
+  // The throughput limit of a resource is the cycles consumed per iteration
+  // divided by the number of units.
+  double ResourceLimit = 0.0;
+  unsigned BusiestResource = 0;
+  for (unsigned I = 1, E = SM.getNumProcResourceKinds(); I < E; ++I) {
+    const MCProcResourceDesc &ProcResource = *SM.getProcResource(I);
+    if (!ProcResource.NumUnits)
+      continue;
+    double Limit = ResourceCycles[I] / ProcResource.NumUnits / Iterations;
+    if (Limit > ResourceLimit) {
+      ResourceLimit = Limit;
+      BusiestResource = I;
+    }
+  }
+  double DispatchLimit = (double)NumMicroOps / DispatchWidth / Iterations;
+
+  FOS << "\n\nCritical Path:\n";
+  FOS << "Loop-carried dependency:";
+  FOS.PadToColumn(26);
+  if (HasChain)
+    FOS << format("%.2f", (double)ChainLength) << " cycles per iteration\n";
+  else
+    FOS << "unknown (at least two iterations are required)\n";
+
+  FOS << "Most used resource:";
+  FOS.PadToColumn(26);
+  FOS << format("%.2f", ResourceLimit) << " cycles per iteration";
+  if (BusiestResource)
+    FOS << " (" << SM.getProcResource(BusiestResource)->Name << ')';
+  FOS << '\n';
+
+  FOS << "Dispatch width:";
+  FOS.PadToColumn(26);
+  FOS << format("%.2f", DispatchLimit) << " cycles per iteration\n";
+
+  FOS << "Bottleneck:";
+  FOS.PadToColumn(26);
+  if (HasChain && ChainLength >= ResourceLimit &&
+      ChainLength >= DispatchLimit)
+    FOS << "loop-carried dependency\n";
+  else if (ResourceLimit >= DispatchLimit && BusiestResource)
+    FOS << "resource " << SM.getProcResource(BusiestResource)->Name << '\n';
+  else
+    FOS << "dispatch width\n";
+
+  if (!HasChain || !ChainLength) {
+    FOS.flush();
+    OS << Buffer;
+    return;
+  }
+
+  // Walk the chain back by one iteration, and print it in program order.
+  std::vector<unsigned> Chain;
+  unsigned Index = ChainEnd;
+  do {
+    Chain.push_back(Index);
+    Index = Nodes[Index].Predecessor;
+  } while (Index + Size > ChainEnd && Index != Chain.back());
+
+  FOS << "\nDependency chain:\n";
+  for (unsigned I = Chain.size(); I--;) {
+    // Print the latency to the next instruction in the chain. The successor
+    // of the last instruction is the first one of the next iteration.
+    unsigned Latency = Nodes[I ? Chain[I - 1] : Chain.back()].Latency;
+    FOS << ' ' << Latency;
+    FOS.PadToColumn(6);
+    printInstruction(FOS, Chain[I] % Size);
+  }
+
+  FOS.flush();
+  OS << Buffer;
+}
+} // namespace mca
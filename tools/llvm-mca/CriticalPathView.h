@@ -0,0 +1,88 @@
+//===--------------------- CriticalPathView.h -------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file defines class CriticalPathView.
+/// Class CriticalPathView observes the register dependencies of the
+/// instructions dispatched by the Pipeline object, and computes the length of
+/// the longest chain of dependencies carried from one iteration of the code
+/// to the next. It compares that length with the throughput limits of the
+/// processor resources and of the dispatch width, to tell whether the code is
+/// bound by latency or by throughput. For example:
+///
+/// Critical Path:
+/// Loop-carried dependency:  4.00 cycles per iteration
+/// Most used resource:       1.00 cycles per iteration (JALU0)
+/// Dispatch width:           1.00 cycles per iteration
+/// Bottleneck:               loop-carried dependency
+///
+/// Dependency chain:
+///  3    imulq	%rax, %rax
+///  1    addq	%rbx, %rax
+///
+/// The chain lists the instructions of the last iteration on the path that
+/// bounds the dependency, with the latency from each one to the next.
+/// Latencies come from the scheduling model, and don't account for the delays
+/// caused by a lack of processor resources.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TOOLS_LLVM_MCA_CRITICALPATHVIEW_H
+#define LLVM_TOOLS_LLVM_MCA_CRITICALPATHVIEW_H
+
+#include "SourceMgr.h"
+#include "View.h"
+#include "llvm/MC/MCInstPrinter.h"
+#include "llvm/MC/MCSubtargetInfo.h"
+#include <vector>
+
+namespace mca {
+
+/// This class computes the loop-carried dependency chain of the simulated
+/// code, and prints it along with the throughput limits.
+class CriticalPathView : public View {
+  const llvm::MCSubtargetInfo &STI;
+  llvm::MCInstPrinter &MCIP;
+  const SourceMgr &Source;
+  unsigned DispatchWidth;
+
+  struct NodeInfo {
+    // The earliest cycle in which the instruction can be issued, if it only
+    // had to wait on its register operands.
+    unsigned long long Start = 0;
+    // The source index of the producer that determines Start, and the latency
+    // from that producer. Predecessor is equal to the index of the instruction
+    // itself if it doesn't depend on any instruction.
+    unsigned Predecessor = 0;
+    unsigned Latency = 0;
+  };
+
+  // One entry per dispatched instruction, indexed by source index.
+  std::vector<NodeInfo> Nodes;
+  // Resource cycles consumed, indexed by processor resource ID.
+  std::vector<double> ResourceCycles;
+  unsigned long long NumMicroOps;
+
+  void printInstruction(llvm::raw_ostream &OS, unsigned Index) const;
+
+public:
+  CriticalPathView(const llvm::MCSubtargetInfo &sti,
+                   llvm::MCInstPrinter &Printer, const SourceMgr &S,
+                   unsigned Width)
+      : STI(sti), MCIP(Printer), Source(S), DispatchWidth(Width),
+        ResourceCycles(sti.getSchedModel().getNumProcResourceKinds()),
+        NumMicroOps(0) {}
+
+  void onInstructionEvent(const HWInstructionEvent &Event) override;
+
+  void printView(llvm::raw_ostream &OS) const override;
+};
+} // namespace mca
+
+#endif
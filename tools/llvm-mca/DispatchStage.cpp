@@ -27,13 +27,16 @@ using namespace llvm;
 
 namespace mca {
 
-void DispatchStage::notifyInstructionDispatched(const InstRef &IR,
-                                                ArrayRef<unsigned> UsedRegs) {
+void DispatchStage::notifyInstructionDispatched(
+    const InstRef &IR, ArrayRef<unsigned> UsedRegs,
+    ArrayRef<RegisterDependency> Deps) {
   LLVM_DEBUG(dbgs() << "[E] Instruction Dispatched: " << IR << '\n');
-  notifyInstructionEvent(HWInstructionDispatchedEvent(IR, UsedRegs));
+  notifyInstructionEvent(HWInstructionDispatchedEvent(IR, UsedRegs, Deps));
 }
 
 void DispatchStage::notifyStallEvent(const HWStallEvent &Event) {
+  StallType = Event.Type;
+  StalledIR = Event.IR;
   for (HWEventListener *Listener : getListeners())
     Listener->onStallEvent(Event);
 }
@@ -70,8 +73,9 @@ bool DispatchStage::checkScheduler(const InstRef &IR) {
   return Ready;
 }
 
-void DispatchStage::updateRAWDependencies(ReadState &RS,
-                                          const MCSubtargetInfo &STI) {
+void DispatchStage::updateRAWDependencies(
+    ReadState &RS, const MCSubtargetInfo &STI,
+    SmallVectorImpl<RegisterDependency> &Deps) {
   SmallVector<WriteRef, 4> DependentWrites;
 
   collectWrites(DependentWrites, RS.getRegisterID());
@@ -89,6 +93,8 @@ void DispatchStage::updateRAWDependencies(ReadState &RS,
     unsigned WriteResID = WS.getWriteResourceID();
     int ReadAdvance = STI.getReadAdvanceCycles(SC, RD.UseIndex, WriteResID);
     WS.addUser(&RS, ReadAdvance);
+    unsigned Latency = std::max(0, WS.getLatency() - ReadAdvance);
+    Deps.push_back({WR.getSourceIndex(), Latency});
   }
 }
 
@@ -112,9 +118,10 @@ void DispatchStage::dispatch(InstRef IR) {
   // instruction. A dependency-breaking instruction is a zero-latency
   // instruction that doesn't consume hardware resources.
   // An example of dependency-breaking instruction on X86 is a zero-idiom XOR.
+  SmallVector<RegisterDependency, 4> Dependencies;
   if (!Desc.isZeroLatency())
     for (std::unique_ptr<ReadState> &RS : IS.getUses())
-      updateRAWDependencies(*RS, STI);
+      updateRAWDependencies(*RS, STI, Dependencies);
 
   // By default, a dependency-breaking zero-latency instruction is expected to
   // be optimized at register renaming stage. That means, no physical register
@@ -129,22 +136,48 @@ void DispatchStage::dispatch(InstRef IR) {
   IS.dispatch(RCU.reserveSlot(IR, NumMicroOps));
 
   // Notify listeners of the "instruction dispatched" event.
-  notifyInstructionDispatched(IR, RegisterFiles);
+  notifyInstructionDispatched(IR, RegisterFiles, Dependencies);
 }
 
 void DispatchStage::preExecute(const InstRef &IR) {
   AvailableEntries = CarryOver >= DispatchWidth ? 0 : DispatchWidth - CarryOver;
   CarryOver = CarryOver >= DispatchWidth ? CarryOver - DispatchWidth : 0U;
+  IsIdle = true;
+  StallType = HWStallEvent::Invalid;
 }
 
 bool DispatchStage::execute(InstRef &IR) {
   const InstrDesc &Desc = IR.getInstruction()->getDesc();
-  if (!isAvailable(Desc.NumMicroOps) || !canDispatch(IR))
+  if (!isAvailable(Desc.NumMicroOps)) {
+    IsIdle = false;
     return false;
+  }
+  if (!canDispatch(IR))
+    return false;
+  IsIdle = false;
   dispatch(IR);
   return true;
 }
 
+unsigned DispatchStage::getNumIdleCycles() const {
+  // A stalled instruction stays stalled until another stage releases the
+  // resources it needs. Instructions with more micro opcodes than the dispatch
+  // width are dispatched over several cycles, which are not skipped.
+  if (!IsIdle || CarryOver)
+    return 0;
+  return std::numeric_limits<unsigned>::max();
+}
+
+void DispatchStage::skipIdleCycles(unsigned NumCycles) {
+  // The stalled instruction would have tried, and failed, to dispatch in each
+  // of the skipped cycles.
+  if (StallType == HWStallEvent::Invalid)
+    return;
+  InstRef IR = StalledIR;
+  for (unsigned I = 0; I < NumCycles; ++I)
+    notifyStallEvent(HWStallEvent(StallType, IR));
+}
+
 #ifndef NDEBUG
 void DispatchStage::dump() const {
   PRF.dump();
@@ -58,15 +58,25 @@ class DispatchStage : public Stage {
   RegisterFile &PRF;
   Scheduler &SC;
 
+  // True if no instruction was dispatched in this cycle, either because there
+  // was nothing to dispatch or because the next instruction was stalled.
+  bool IsIdle;
+  // The stall event of the last instruction that could not be dispatched in
+  // this cycle, or HWStallEvent::Invalid.
+  unsigned StallType;
+  InstRef StalledIR;
+
   bool checkRCU(const InstRef &IR);
   bool checkPRF(const InstRef &IR);
   bool checkScheduler(const InstRef &IR);
   void dispatch(InstRef IR);
-  void updateRAWDependencies(ReadState &RS, const llvm::MCSubtargetInfo &STI);
+  void updateRAWDependencies(ReadState &RS, const llvm::MCSubtargetInfo &STI,
+                             llvm::SmallVectorImpl<RegisterDependency> &Deps);
 
   void notifyStallEvent(const HWStallEvent &Event);
   void notifyInstructionDispatched(const InstRef &IR,
-                                   llvm::ArrayRef<unsigned> UsedPhysRegs);
+                                   llvm::ArrayRef<unsigned> UsedPhysRegs,
+                                   llvm::ArrayRef<RegisterDependency> Deps);
 
   bool isAvailable(unsigned NumEntries) const {
     return NumEntries <= AvailableEntries || AvailableEntries == DispatchWidth;
@@ -88,7 +98,8 @@ public:
                 unsigned MaxDispatchWidth, RetireControlUnit &R,
                 RegisterFile &F, Scheduler &Sched)
       : DispatchWidth(MaxDispatchWidth), AvailableEntries(MaxDispatchWidth),
-        CarryOver(0U), STI(Subtarget), RCU(R), PRF(F), SC(Sched) {}
+        CarryOver(0U), STI(Subtarget), RCU(R), PRF(F), SC(Sched), IsIdle(true),
+        StallType(HWStallEvent::Invalid) {}
 
   // We can always try to dispatch, so returning false is okay in this case.
   // The retire stage, which controls the RCU, might have items to complete but
@@ -96,6 +107,8 @@ public:
   virtual bool hasWorkToComplete() const override final { return false; }
   virtual void preExecute(const InstRef &IR) override final;
   virtual bool execute(InstRef &IR) override final;
+  virtual unsigned getNumIdleCycles() const override final;
+  virtual void skipIdleCycles(unsigned NumCycles) override final;
   void notifyDispatchStall(const InstRef &IR, unsigned EventType);
 
 #ifndef NDEBUG
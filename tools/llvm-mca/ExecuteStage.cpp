@@ -53,12 +53,13 @@ void ExecuteStage::issueReadyInstructions() {
   InstRef IR = HWS.select();
   while (IR.isValid()) {
     SmallVector<std::pair<ResourceRef, double>, 4> Used;
-    HWS.issueInstruction(IR, Used);
+    Optional<MemoryAccess> Access;
+    HWS.issueInstruction(IR, Used, Access);
 
     // Reclaim instruction resources and perform notifications.
     const InstrDesc &Desc = IR.getInstruction()->getDesc();
     notifyReleasedBuffers(Desc.Buffers);
-    notifyInstructionIssued(IR, Used);
+    notifyInstructionIssued(IR, Used, Access);
     if (IR.getInstruction()->isExecuted())
       notifyInstructionExecuted(IR);
 
@@ -140,11 +141,12 @@ bool ExecuteStage::execute(InstRef &IR) {
 
   // Issue IR.  The resources for this issuance will be placed in 'Used.'
   SmallVector<std::pair<ResourceRef, double>, 4> Used;
-  HWS.issueInstruction(IR, Used);
+  Optional<MemoryAccess> Access;
+  HWS.issueInstruction(IR, Used, Access);
 
   // Perform notifications.
   notifyReleasedBuffers(Desc.Buffers);
-  notifyInstructionIssued(IR, Used);
+  notifyInstructionIssued(IR, Used, Access);
   if (IR.getInstruction()->isExecuted())
     notifyInstructionExecuted(IR);
 
@@ -171,7 +173,8 @@ void ExecuteStage::notifyResourceAvailable(const ResourceRef &RR) {
 }
 
 void ExecuteStage::notifyInstructionIssued(
-    const InstRef &IR, ArrayRef<std::pair<ResourceRef, double>> Used) {
+    const InstRef &IR, ArrayRef<std::pair<ResourceRef, double>> Used,
+    Optional<MemoryAccess> Access) {
   LLVM_DEBUG({
     dbgs() << "[E] Instruction Issued: " << IR << '\n';
     for (const std::pair<ResourceRef, unsigned> &Resource : Used) {
@@ -180,7 +183,7 @@ void ExecuteStage::notifyInstructionIssued(
       dbgs() << "           cycles: " << Resource.second << '\n';
     }
   });
-  notifyInstructionEvent(HWInstructionIssuedEvent(IR, Used));
+  notifyInstructionEvent(HWInstructionIssuedEvent(IR, Used, Access));
 }
 
 void ExecuteStage::notifyReservedBuffers(ArrayRef<uint64_t> Buffers) {
@@ -47,10 +47,17 @@ public:
 
   virtual void preExecute(const InstRef &IR) override final;
   virtual bool execute(InstRef &IR) override final;
+  virtual unsigned getNumIdleCycles() const override final {
+    return HWS.getNumIdleCycles();
+  }
+  virtual void skipIdleCycles(unsigned NumCycles) override final {
+    HWS.skipIdleCycles(NumCycles);
+  }
 
   void
   notifyInstructionIssued(const InstRef &IR,
-                          llvm::ArrayRef<std::pair<ResourceRef, double>> Used);
+                          llvm::ArrayRef<std::pair<ResourceRef, double>> Used,
+                          llvm::Optional<MemoryAccess> Access);
   void notifyInstructionExecuted(const InstRef &IR);
   void notifyInstructionReady(const InstRef &IR);
   void notifyResourceAvailable(const ResourceRef &RR);
@@ -37,6 +37,12 @@ public:
   bool hasWorkToComplete() const override final;
   bool execute(InstRef &IR) override final;
   void postExecute(const InstRef &IR) override final;
+
+  // An instruction that is fetched but not dispatched is fetched again in the
+  // next cycle.
+  unsigned getNumIdleCycles() const override final {
+    return std::numeric_limits<unsigned>::max();
+  }
 };
 
 } // namespace mca
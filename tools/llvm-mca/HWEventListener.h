@@ -16,7 +16,9 @@
 #define LLVM_TOOLS_LLVM_MCA_HWEVENTLISTENER_H
 
 #include "Instruction.h"
+#include "MemoryModel.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Optional.h"
 #include <utility>
 
 namespace mca {
@@ -62,20 +64,37 @@ class HWInstructionIssuedEvent : public HWInstructionEvent {
 public:
   using ResourceRef = std::pair<uint64_t, uint64_t>;
   HWInstructionIssuedEvent(const InstRef &IR,
-                           llvm::ArrayRef<std::pair<ResourceRef, double>> UR)
-      : HWInstructionEvent(HWInstructionEvent::Issued, IR), UsedResources(UR) {}
+                           llvm::ArrayRef<std::pair<ResourceRef, double>> UR,
+                           llvm::Optional<MemoryAccess> Access = llvm::None)
+      : HWInstructionEvent(HWInstructionEvent::Issued, IR), UsedResources(UR),
+        Access(Access) {}
 
   llvm::ArrayRef<std::pair<ResourceRef, double>> UsedResources;
+  // The access to the memory hierarchy of a load, if the pipeline models it.
+  llvm::Optional<MemoryAccess> Access;
+};
+
+// A register dependency of an instruction on an older instruction.
+struct RegisterDependency {
+  // The source index of the instruction that writes the register.
+  unsigned ProducerIndex;
+  // The number of cycles after the producer is issued in which the register
+  // becomes available to the consumer.
+  unsigned Latency;
 };
 
 class HWInstructionDispatchedEvent : public HWInstructionEvent {
 public:
-  HWInstructionDispatchedEvent(const InstRef &IR, llvm::ArrayRef<unsigned> Regs)
+  HWInstructionDispatchedEvent(
+      const InstRef &IR, llvm::ArrayRef<unsigned> Regs,
+      llvm::ArrayRef<RegisterDependency> Deps = llvm::None)
       : HWInstructionEvent(HWInstructionEvent::Dispatched, IR),
-        UsedPhysRegs(Regs) {}
+        UsedPhysRegs(Regs), Dependencies(Deps) {}
   // Number of physical register allocated for this instruction. There is one
   // entry per register file.
   llvm::ArrayRef<unsigned> UsedPhysRegs;
+  // The register dependencies of this instruction on instructions in flight.
+  llvm::ArrayRef<RegisterDependency> Dependencies;
 };
 
 class HWInstructionRetiredEvent : public HWInstructionEvent {
@@ -373,11 +373,15 @@ const InstrDesc &InstrBuilder::createInstrDescImpl(const MCInst &MCI) {
 }
 
 const InstrDesc &InstrBuilder::getOrCreateInstrDesc(const MCInst &MCI) {
-  if (Descriptors.find_as(MCI.getOpcode()) != Descriptors.end())
-    return *Descriptors[MCI.getOpcode()];
-
-  if (VariantDescriptors.find(&MCI) != VariantDescriptors.end())
-    return *VariantDescriptors[&MCI];
+  // Once a descriptor exists, it is only looked up: this lets concurrent
+  // simulations share the builder once all their descriptors are created.
+  auto DI = Descriptors.find(MCI.getOpcode());
+  if (DI != Descriptors.end())
+    return *DI->second;
+
+  auto VDI = VariantDescriptors.find(&MCI);
+  if (VDI != VariantDescriptors.end())
+    return *VDI->second;
 
   return createInstrDescImpl(MCI);
 }
@@ -36,6 +36,9 @@ class DispatchUnit;
 /// descriptors (i.e. InstrDesc objects).
 /// Information from the machine scheduling model is used to identify processor
 /// resources that are consumed by an instruction.
+///
+/// Descriptors are created on demand. Once the descriptors of a sequence of
+/// MCInsts have been created, Instructions for it can be created concurrently.
 class InstrBuilder {
   const llvm::MCSubtargetInfo &STI;
   const llvm::MCInstrInfo &MCII;
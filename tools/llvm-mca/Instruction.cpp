@@ -38,10 +38,10 @@ void ReadState::writeStartEvent(unsigned Cycles) {
   }
 }
 
-void WriteState::onInstructionIssued() {
+void WriteState::onInstructionIssued(unsigned ExtraLatency) {
   assert(CyclesLeft == UNKNOWN_CYCLES);
   // Update the number of cycles left based on the WriteDescriptor info.
-  CyclesLeft = WD.Latency;
+  CyclesLeft = WD.Latency + ExtraLatency;
 
   // Now that the time left before write-back is known, notify
   // all the users.
@@ -91,6 +91,24 @@ void ReadState::cycleEvent() {
   }
 }
 
+void WriteState::skipCycles(unsigned NumCycles) {
+  if (CyclesLeft != UNKNOWN_CYCLES)
+    CyclesLeft -= NumCycles;
+}
+
+void ReadState::skipCycles(unsigned NumCycles) {
+  if (DependentWrites) {
+    TotalCycles -= std::min(TotalCycles, NumCycles);
+    return;
+  }
+
+  if (CyclesLeft == UNKNOWN_CYCLES || !CyclesLeft)
+    return;
+
+  CyclesLeft -= std::min<unsigned>(CyclesLeft, NumCycles);
+  IsReady = !CyclesLeft;
+}
+
 #ifndef NDEBUG
 void WriteState::dump() const {
   dbgs() << "{ OpIdx=" << WD.OpIndex << ", Lat=" << WD.Latency << ", RegID "
@@ -114,15 +132,15 @@ void Instruction::dispatch(unsigned RCUToken) {
   update();
 }
 
-void Instruction::execute() {
+void Instruction::execute(unsigned ExtraLatency) {
   assert(Stage == IS_READY);
   Stage = IS_EXECUTING;
 
   // Set the cycles left before the write-back stage.
-  CyclesLeft = Desc.MaxLatency;
+  CyclesLeft = Desc.MaxLatency + ExtraLatency;
 
   for (UniqueDef &Def : Defs)
-    Def->onInstructionIssued();
+    Def->onInstructionIssued(ExtraLatency);
 
   // Transition to the "executed" stage if this is a zero-latency instruction.
   if (!CyclesLeft)
@@ -160,6 +178,41 @@ void Instruction::cycleEvent() {
     Stage = IS_EXECUTED;
 }
 
+unsigned Instruction::getCyclesToNextStage() const {
+  const unsigned Never = std::numeric_limits<unsigned>::max();
+  if (isExecuting())
+    return CyclesLeft;
+  if (!isDispatched())
+    return Never;
+
+  // The instruction becomes ready on the first cycle in which all the reads
+  // are ready.
+  unsigned Cycles = 1;
+  for (const UniqueUse &Use : Uses) {
+    int UseCycles = Use->getCyclesLeft();
+    if (UseCycles == UNKNOWN_CYCLES)
+      return Never;
+    Cycles = std::max<unsigned>(Cycles, UseCycles);
+  }
+  return Cycles;
+}
+
+void Instruction::skipCycles(unsigned NumCycles) {
+  assert(NumCycles < getCyclesToNextStage() && "Cannot skip a stage change!");
+  if (isDispatched()) {
+    for (UniqueUse &Use : Uses)
+      Use->skipCycles(NumCycles);
+    return;
+  }
+
+  if (!isExecuting())
+    return;
+
+  for (UniqueDef &Def : Defs)
+    Def->skipCycles(NumCycles);
+  CyclesLeft -= NumCycles;
+}
+
 const unsigned WriteRef::INVALID_IID = std::numeric_limits<unsigned>::max();
 
 } // namespace mca
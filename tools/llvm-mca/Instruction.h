@@ -121,6 +121,7 @@ public:
   WriteState &operator=(const WriteState &Other) = delete;
 
   int getCyclesLeft() const { return CyclesLeft; }
+  int getLatency() const { return WD.Latency; }
   unsigned getWriteResourceID() const { return WD.SClassOrWriteResourceID; }
   unsigned getRegisterID() const { return RegisterID; }
 
@@ -129,7 +130,11 @@ public:
 
   // On every cycle, update CyclesLeft and notify dependent users.
   void cycleEvent();
-  void onInstructionIssued();
+  // Equivalent to NumCycles calls to cycleEvent().
+  void skipCycles(unsigned NumCycles);
+  // ExtraLatency is added to the latency of the write, for example when the
+  // instruction loads from a slow level of the memory hierarchy.
+  void onInstructionIssued(unsigned ExtraLatency = 0);
 
 #ifndef NDEBUG
   void dump() const;
@@ -175,7 +180,19 @@ public:
   unsigned getRegisterID() const { return RegisterID; }
 
   void cycleEvent();
+  // Equivalent to NumCycles calls to cycleEvent().
+  void skipCycles(unsigned NumCycles);
   void writeStartEvent(unsigned Cycles);
+
+  // Returns the number of calls to cycleEvent() before this read becomes
+  // ready, or UNKNOWN_CYCLES if that depends on writes that have not been
+  // issued yet.
+  int getCyclesLeft() const {
+    if (IsReady)
+      return 0;
+    return DependentWrites ? UNKNOWN_CYCLES : CyclesLeft;
+  }
+
   void setDependentWrites(unsigned Writes) {
     DependentWrites = Writes;
     IsReady = !Writes;
@@ -323,8 +340,9 @@ public:
   void dispatch(unsigned RCUTokenID);
 
   // Instruction issued. Transition to the IS_EXECUTING state, and update
-  // all the definitions.
-  void execute();
+  // all the definitions. ExtraLatency is added to the latency of the
+  // instruction and of its definitions.
+  void execute(unsigned ExtraLatency = 0);
 
   // Force a transition from the IS_AVAILABLE state to the IS_READY state if
   // input operands are all ready. State transitions normally occur at the
@@ -346,6 +364,16 @@ public:
   }
 
   void cycleEvent();
+
+  // Returns the number of calls to cycleEvent() before this instruction
+  // changes stage on its own, that is, before it becomes ready or executed.
+  // Returns the maximum unsigned value if the next stage change depends on
+  // other instructions.
+  unsigned getCyclesToNextStage() const;
+
+  // Equivalent to NumCycles calls to cycleEvent(). NumCycles must be smaller
+  // than getCyclesToNextStage().
+  void skipCycles(unsigned NumCycles);
 };
 
 /// An InstRef contains both a SourceMgr index and Instruction pair.  The index
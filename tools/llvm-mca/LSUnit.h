@@ -16,6 +16,9 @@
 #ifndef LLVM_TOOLS_LLVM_MCA_LSUNIT_H
 #define LLVM_TOOLS_LLVM_MCA_LSUNIT_H
 
+#include "MemoryModel.h"
+#include <cassert>
+#include <memory>
 #include <set>
 
 namespace mca {
@@ -115,9 +118,15 @@ class LSUnit {
   // before newer loads are issued.
   std::set<unsigned> LoadBarriers;
 
+  // Decides which level of the memory hierarchy serves each load. Without a
+  // model, every load hits in the L1 cache.
+  std::unique_ptr<MemoryModel> Memory;
+
 public:
-  LSUnit(unsigned LQ = 0, unsigned SQ = 0, bool AssumeNoAlias = false)
-      : LQ_Size(LQ), SQ_Size(SQ), NoAlias(AssumeNoAlias) {}
+  LSUnit(unsigned LQ = 0, unsigned SQ = 0, bool AssumeNoAlias = false,
+         std::unique_ptr<MemoryModel> MM = nullptr)
+      : LQ_Size(LQ), SQ_Size(SQ), NoAlias(AssumeNoAlias),
+        Memory(std::move(MM)) {}
 
 #ifndef NDEBUG
   void dump() const;
@@ -140,6 +149,15 @@ public:
   // 6. A store has to wait until an older store barrier is fully executed.
   bool isReady(const InstRef &IR) const;
   void onInstructionExecuted(const InstRef &IR);
+
+  bool hasMemoryModel() const { return Memory != nullptr; }
+
+  // Simulates the access to the memory hierarchy of the load IR, which is
+  // being issued. Requires a memory model.
+  MemoryAccess access(const InstRef &IR) {
+    assert(Memory && "No memory model!");
+    return Memory->access(IR);
+  }
 };
 
 } // namespace mca
@@ -0,0 +1,100 @@
+//===--------------------- MemoryHierarchyView.cpp --------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file implements the MemoryHierarchyView interface.
+///
+//===----------------------------------------------------------------------===//
+
+#include "MemoryHierarchyView.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/FormattedStream.h"
+
+namespace mca {
+
+using namespace llvm;
+
+unsigned MemoryHierarchyView::LoadStats::getNumLoads() const {
+  unsigned NumLoads = 0;
+  for (unsigned Accesses : NumAccesses)
+    NumLoads += Accesses;
+  return NumLoads;
+}
+
+void MemoryHierarchyView::onInstructionEvent(const HWInstructionEvent &Event) {
+  // We're only interested in loads that are issued.
+  if (Event.Type != HWInstructionEvent::Issued)
+    return;
+  const auto &IssueEvent = static_cast<const HWInstructionIssuedEvent &>(Event);
+  if (!IssueEvent.Access)
+    return;
+
+  const MemoryAccess &Access = *IssueEvent.Access;
+  const unsigned SourceIdx = Event.IR.getSourceIndex() % Source.size();
+  for (LoadStats *LS : {&Stats[SourceIdx], &Stats.back()}) {
+    ++LS->NumAccesses[Access.Level];
+    LS->TotalExtraLatency += Access.ExtraLatency;
+  }
+}
+
+void MemoryHierarchyView::printStats(raw_ostream &OS,
+                                     const LoadStats &LS) const {
+  formatted_raw_ostream FOS(OS);
+  unsigned NumLoads = LS.getNumLoads();
+  if (!NumLoads) {
+    for (unsigned Column = 1; Column <= 5; ++Column) {
+      FOS.PadToColumn(Column * 7 - 6);
+      FOS << '-';
+    }
+    FOS.PadToColumn(35);
+    return;
+  }
+
+  FOS << ' ' << NumLoads;
+  for (unsigned Level = 0; Level < ML_NumLevels; ++Level) {
+    FOS.PadToColumn((Level + 1) * 7 + 1);
+    FOS << LS.NumAccesses[Level];
+  }
+  FOS.PadToColumn(29);
+  FOS << format("%.2f", (double)LS.TotalExtraLatency / NumLoads);
+  FOS.PadToColumn(35);
+}
+
+void MemoryHierarchyView::printView(raw_ostream &OS) const {
+  std::string Buffer;
+  raw_string_ostream TempStream(Buffer);
+
+  std::string Instruction;
+  raw_string_ostream InstrStream(Instruction);
+
+  TempStream << "\n\nMemory hierarchy:\n";
+  TempStream << "[1]: #Loads\n[2]: L1 cache hits\n[3]: L2 cache hits\n"
+             << "[4]: Memory accesses\n[5]: Average extra latency\n\n";
+
+  TempStream << "[1]    [2]    [3]    [4]    [5]    Instructions:\n";
+  for (unsigned I = 0, E = Source.size(); I < E; ++I) {
+    printStats(TempStream, Stats[I]);
+
+    MCIP.printInst(&Source.getMCInstFromIndex(I), InstrStream, "", STI);
+    InstrStream.flush();
+
+    // Consume any tabs or spaces at the beginning of the string.
+    StringRef Str(Instruction);
+    Str = Str.ltrim();
+    TempStream << Str << '\n';
+    Instruction = "";
+  }
+
+  printStats(TempStream, Stats.back());
+  TempStream << "Total\n";
+
+  TempStream.flush();
+  OS << Buffer;
+}
+} // namespace mca
@@ -0,0 +1,75 @@
+//===--------------------- MemoryHierarchyView.h ----------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file defines class MemoryHierarchyView.
+/// Class MemoryHierarchyView observes the loads issued by the Pipeline object,
+/// and reports which level of the memory hierarchy served them according to
+/// the memory model of the LSUnit. For example:
+///
+/// Memory hierarchy:
+/// [1]: #Loads
+/// [2]: L1 cache hits
+/// [3]: L2 cache hits
+/// [4]: Memory accesses
+/// [5]: Average extra latency
+///
+/// [1]    [2]    [3]    [4]    [5]    Instructions:
+///  100    90     8      2     3.60   movq	(%rdi), %rsi
+///  -      -      -      -      -     addq	%rsi, %rax
+///  100    90     8      2     3.60   Total
+///
+/// The extra latency is the number of cycles that a load spends waiting on
+/// the L2 cache or on the memory, on top of its latency from the scheduling
+/// model.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TOOLS_LLVM_MCA_MEMORYHIERARCHYVIEW_H
+#define LLVM_TOOLS_LLVM_MCA_MEMORYHIERARCHYVIEW_H
+
+#include "MemoryModel.h"
+#include "SourceMgr.h"
+#include "View.h"
+#include "llvm/MC/MCInstPrinter.h"
+#include "llvm/MC/MCSubtargetInfo.h"
+#include <vector>
+
+namespace mca {
+
+/// A view that reports the accesses of loads to the memory hierarchy.
+class MemoryHierarchyView : public View {
+  const llvm::MCSubtargetInfo &STI;
+  llvm::MCInstPrinter &MCIP;
+  const SourceMgr &Source;
+
+  struct LoadStats {
+    unsigned NumAccesses[ML_NumLevels] = {0, 0, 0};
+    unsigned long long TotalExtraLatency = 0;
+
+    unsigned getNumLoads() const;
+  };
+
+  // One entry per instruction in the source, plus one for the totals.
+  std::vector<LoadStats> Stats;
+
+  void printStats(llvm::raw_ostream &OS, const LoadStats &LS) const;
+
+public:
+  MemoryHierarchyView(const llvm::MCSubtargetInfo &sti,
+                      llvm::MCInstPrinter &Printer, const SourceMgr &SM)
+      : STI(sti), MCIP(Printer), Source(SM), Stats(SM.size() + 1) {}
+
+  void onInstructionEvent(const HWInstructionEvent &Event) override;
+
+  void printView(llvm::raw_ostream &OS) const override;
+};
+} // namespace mca
+
+#endif
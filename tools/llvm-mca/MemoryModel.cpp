@@ -0,0 +1,50 @@
+//===--------------------- MemoryModel.cpp ----------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file implements the memory hierarchy models.
+///
+//===----------------------------------------------------------------------===//
+
+#include "MemoryModel.h"
+#include <cassert>
+#include <cmath>
+
+namespace mca {
+
+static const unsigned RateScale = 10000;
+
+MemoryModel::~MemoryModel() {}
+
+static unsigned getMissRate(double HitRate) {
+  assert(HitRate >= 0.0 && HitRate <= 100.0 && "Invalid hit rate!");
+  return RateScale - std::lround(HitRate * (RateScale / 100));
+}
+
+HitRateMemoryModel::HitRateMemoryModel(double L1HitRate, double L2HitRate,
+                                       unsigned L2Latency,
+                                       unsigned MemoryLatency)
+    : MemoryModel(L2Latency, MemoryLatency), L1MissRate(getMissRate(L1HitRate)),
+      L2MissRate(getMissRate(L2HitRate)), L1Misses(0), L2Misses(0) {}
+
+MemoryLevel HitRateMemoryModel::selectLevel(const InstRef &IR) {
+  // A load misses when the accumulated misses add up to a whole one.
+  L1Misses += L1MissRate;
+  if (L1Misses < RateScale)
+    return ML_L1Cache;
+  L1Misses -= RateScale;
+
+  L2Misses += L2MissRate;
+  if (L2Misses < RateScale)
+    return ML_L2Cache;
+  L2Misses -= RateScale;
+  return ML_Memory;
+}
+
+} // namespace mca
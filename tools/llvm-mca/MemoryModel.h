@@ -0,0 +1,83 @@
+//===--------------------- MemoryModel.h ------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file defines the interface of the memory hierarchy models used by the
+/// LSUnit to compute the latency of loads.
+///
+/// The latency of a load from the scheduling model is the latency of a hit in
+/// the L1 cache. A memory model decides which level of the memory hierarchy
+/// serves each load, and each level adds a fixed number of cycles to that
+/// latency.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TOOLS_LLVM_MCA_MEMORYMODEL_H
+#define LLVM_TOOLS_LLVM_MCA_MEMORYMODEL_H
+
+namespace mca {
+
+class InstRef;
+
+/// The levels of the memory hierarchy that can serve a load.
+enum MemoryLevel { ML_L1Cache, ML_L2Cache, ML_Memory, ML_NumLevels };
+
+/// The level of the memory hierarchy that served a load, and the number of
+/// cycles it added to the latency of the load.
+struct MemoryAccess {
+  MemoryLevel Level;
+  unsigned ExtraLatency;
+};
+
+/// Abstract memory hierarchy model.
+class MemoryModel {
+  unsigned Latencies[ML_NumLevels];
+
+public:
+  /// \p L2Latency and \p MemoryLatency are the cycles added to the latency of
+  /// a load that misses in the L1 cache and hits in the L2 cache, and of a
+  /// load that misses in both caches respectively.
+  MemoryModel(unsigned L2Latency, unsigned MemoryLatency)
+      : Latencies{0, L2Latency, MemoryLatency} {}
+  virtual ~MemoryModel();
+
+  /// Returns the level of the memory hierarchy that serves the load \p IR.
+  virtual MemoryLevel selectLevel(const InstRef &IR) = 0;
+
+  /// Simulates the load \p IR.
+  MemoryAccess access(const InstRef &IR) {
+    MemoryLevel Level = selectLevel(IR);
+    return {Level, Latencies[Level]};
+  }
+};
+
+/// A memory model where fixed fractions of the loads hit in the caches.
+///
+/// The misses are spread evenly over the sequence of loads, so the results are
+/// deterministic. For example, with a hit rate of 75% in the L1 cache, every
+/// fourth load misses it.
+class HitRateMemoryModel final : public MemoryModel {
+  // Miss rates in hundredths of a percent.
+  unsigned L1MissRate;
+  unsigned L2MissRate;
+  unsigned L1Misses;
+  unsigned L2Misses;
+
+public:
+  /// \p L1HitRate is the percentage of loads that hit in the L1 cache, and
+  /// \p L2HitRate is the percentage of L1 misses that hit in the L2 cache.
+  HitRateMemoryModel(double L1HitRate, double L2HitRate, unsigned L2Latency,
+                     unsigned MemoryLatency);
+
+  MemoryLevel selectLevel(const InstRef &IR) override;
+};
+
+} // namespace mca
+
+#endif
@@ -53,8 +53,17 @@ void Pipeline::postExecuteStages(const InstRef &IR) {
 }
 
 void Pipeline::run() {
-  while (hasWorkToProcess())
+  while (hasWorkToProcess()) {
     runCycle(Cycles++);
+    if (!SkipIdleCycles)
+      continue;
+
+    // If no stage makes progress on its own, the simulation would never end.
+    // Let it run cycle by cycle like it does without skipping.
+    unsigned NumIdleCycles = getNumIdleCycles();
+    if (NumIdleCycles && NumIdleCycles != std::numeric_limits<unsigned>::max())
+      skipIdleCycles(NumIdleCycles);
+  }
 }
 
 void Pipeline::runCycle(unsigned Cycle) {
@@ -73,6 +82,28 @@ void Pipeline::runCycle(unsigned Cycle) {
   notifyCycleEnd(Cycle);
 }
 
+unsigned Pipeline::getNumIdleCycles() const {
+  unsigned NumIdleCycles = std::numeric_limits<unsigned>::max();
+  for (const std::unique_ptr<Stage> &S : Stages) {
+    NumIdleCycles = std::min(NumIdleCycles, S->getNumIdleCycles());
+    if (!NumIdleCycles)
+      break;
+  }
+  return NumIdleCycles;
+}
+
+void Pipeline::skipIdleCycles(unsigned NumCycles) {
+  LLVM_DEBUG(dbgs() << "[E] Skipping " << NumCycles << " idle cycles\n");
+  for (auto &S : Stages)
+    S->skipIdleCycles(NumCycles);
+
+  // Listeners that count cycles still see every cycle.
+  for (unsigned I = 0; I < NumCycles; ++I) {
+    notifyCycleBegin(Cycles);
+    notifyCycleEnd(Cycles++);
+  }
+}
+
 void Pipeline::notifyCycleBegin(unsigned Cycle) {
   LLVM_DEBUG(dbgs() << "[E] Cycle begin: " << Cycle << '\n');
   for (HWEventListener *Listener : Listeners)
@@ -50,6 +50,12 @@ class HWStallEvent;
 /// Internally, the Pipeline collects statistical information in the form of
 /// histograms. For example, it tracks how the dispatch group size changes
 /// over time.
+///
+/// If SkipIdleCycles is set, then after every cycle the stages are asked for
+/// how many of the next cycles they are known to be idle, for example because
+/// every instruction in flight waits on a long latency operation. Those
+/// cycles are skipped: listeners are still notified of their beginning and
+/// end, but the stages are advanced in one step. The reports do not change.
 class Pipeline {
   Pipeline(const Pipeline &P) = delete;
   Pipeline &operator=(const Pipeline &P) = delete;
@@ -58,17 +64,20 @@ class Pipeline {
   llvm::SmallVector<std::unique_ptr<Stage>, 8> Stages;
   std::set<HWEventListener *> Listeners;
   unsigned Cycles;
+  bool SkipIdleCycles;
 
   bool executeStages(InstRef &IR);
   void postExecuteStages(const InstRef &IR);
   bool hasWorkToProcess();
   void runCycle(unsigned Cycle);
+  unsigned getNumIdleCycles() const;
+  void skipIdleCycles(unsigned NumCycles);
 
 public:
   Pipeline(unsigned DispatchWidth = 0, unsigned RegisterFileSize = 0,
            unsigned LoadQueueSize = 0, unsigned StoreQueueSize = 0,
-           bool AssumeNoAlias = false)
-      : Cycles(0) {}
+           bool AssumeNoAlias = false, bool SkipIdleCycles = false)
+      : Cycles(0), SkipIdleCycles(SkipIdleCycles) {}
   void appendStage(std::unique_ptr<Stage> S) { Stages.push_back(std::move(S)); }
   void run();
   void addEventListener(HWEventListener *Listener);
@@ -42,6 +42,13 @@ void RetireStage::preExecute(const InstRef &IR) {
   }
 }
 
+unsigned RetireStage::getNumIdleCycles() const {
+  // Nothing retires until the oldest instruction executes.
+  if (RCU.isEmpty() || !RCU.peekCurrentToken().Executed)
+    return std::numeric_limits<unsigned>::max();
+  return 0;
+}
+
 void RetireStage::notifyInstructionRetired(const InstRef &IR) {
   LLVM_DEBUG(dbgs() << "[E] Instruction Retired: " << IR << '\n');
   SmallVector<unsigned, 4> FreedRegs(PRF.getNumRegisterFiles());
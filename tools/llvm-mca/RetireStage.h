@@ -39,6 +39,7 @@ public:
   }
   virtual void preExecute(const InstRef &IR) override final;
   virtual bool execute(InstRef &IR) override final { return true; }
+  virtual unsigned getNumIdleCycles() const override final;
   void notifyInstructionRetired(const InstRef &IR);
   void onInstructionExecuted(unsigned TokenID);
 };
@@ -15,6 +15,7 @@
 #include "Support.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
+#include <limits>
 
 namespace mca {
 
@@ -224,6 +225,20 @@ void ResourceManager::cycleEvent(SmallVectorImpl<ResourceRef> &ResourcesFreed) {
     BusyResources.erase(RF);
 }
 
+unsigned ResourceManager::getCyclesToNextRelease() const {
+  unsigned Cycles = std::numeric_limits<unsigned>::max();
+  for (const std::pair<ResourceRef, unsigned> &BR : BusyResources)
+    Cycles = std::min(Cycles, BR.second);
+  return Cycles;
+}
+
+void ResourceManager::skipCycles(unsigned NumCycles) {
+  for (std::pair<ResourceRef, unsigned> &BR : BusyResources) {
+    assert(BR.second > NumCycles && "Cannot skip a resource release!");
+    BR.second -= NumCycles;
+  }
+}
+
 #ifndef NDEBUG
 void Scheduler::dump() const {
   dbgs() << "[SCHEDULER]: WaitQueue size is: " << WaitQueue.size() << '\n';
@@ -259,7 +274,8 @@ bool Scheduler::canBeDispatched(const InstRef &IR,
 
 void Scheduler::issueInstructionImpl(
     InstRef &IR,
-    SmallVectorImpl<std::pair<ResourceRef, double>> &UsedResources) {
+    SmallVectorImpl<std::pair<ResourceRef, double>> &UsedResources,
+    Optional<MemoryAccess> &Access) {
   Instruction *IS = IR.getInstruction();
   const InstrDesc &D = IS->getDesc();
 
@@ -267,9 +283,14 @@ void Scheduler::issueInstructionImpl(
   // into a vector. That vector is then used to notify the listener.
   Resources->issueInstruction(D, UsedResources);
 
+  // Loads that miss in the L1 cache take longer.
+  Access = None;
+  if (D.MayLoad && LSU->hasMemoryModel())
+    Access = LSU->access(IR);
+
   // Notify the instruction that it started executing.
   // This updates the internal state of each write.
-  IS->execute();
+  IS->execute(Access ? Access->ExtraLatency : 0);
 
   if (IS->isExecuting())
     IssuedQueue[IR.getSourceIndex()] = IS;
@@ -278,10 +299,11 @@ void Scheduler::issueInstructionImpl(
 // Release the buffered resources and issue the instruction.
 void Scheduler::issueInstruction(
     InstRef &IR,
-    SmallVectorImpl<std::pair<ResourceRef, double>> &UsedResources) {
+    SmallVectorImpl<std::pair<ResourceRef, double>> &UsedResources,
+    Optional<MemoryAccess> &Access) {
   const InstrDesc &Desc = IR.getInstruction()->getDesc();
   releaseBuffers(Desc.Buffers);
-  issueInstructionImpl(IR, UsedResources);
+  issueInstructionImpl(IR, UsedResources, Access);
 }
 
 void Scheduler::promoteToReadyQueue(SmallVectorImpl<InstRef> &Ready) {
@@ -329,6 +351,44 @@ InstRef Scheduler::select() {
   return IR;
 }
 
+unsigned Scheduler::getNumIdleCycles() const {
+  // Instructions that can be issued are issued in the next cycle.
+  if (llvm::any_of(ReadyQueue, [&](const QueueEntryTy &Entry) {
+        return Resources->canBeIssued(Entry.second->getDesc());
+      }))
+    return 0;
+
+  unsigned Cycles = Resources->getCyclesToNextRelease();
+  for (QueueEntryTy Entry : IssuedQueue)
+    Cycles = std::min(Cycles, Entry.second->getCyclesToNextStage());
+
+  for (QueueEntryTy Entry : WaitQueue) {
+    const Instruction &IS = *Entry.second;
+    if (!IS.isReady()) {
+      Cycles = std::min(Cycles, IS.getCyclesToNextStage());
+      continue;
+    }
+
+    // A ready instruction waits in this queue until the LSU accepts it, which
+    // only happens after another memory operation executes.
+    const InstrDesc &Desc = IS.getDesc();
+    bool IsMemOp = Desc.MayLoad || Desc.MayStore;
+    if (!IsMemOp || LSU->isReady({Entry.first, Entry.second}))
+      return 0;
+  }
+
+  // Something happens in the cycle in which Cycles reaches zero.
+  return Cycles == std::numeric_limits<unsigned>::max() ? Cycles : Cycles - 1;
+}
+
+void Scheduler::skipIdleCycles(unsigned NumCycles) {
+  Resources->skipCycles(NumCycles);
+  for (QueueEntryTy Entry : IssuedQueue)
+    Entry.second->skipCycles(NumCycles);
+  for (QueueEntryTy Entry : WaitQueue)
+    Entry.second->skipCycles(NumCycles);
+}
+
 void Scheduler::updatePendingQueue(SmallVectorImpl<InstRef> &Ready) {
   // Notify to instructions in the pending queue that a new cycle just
   // started.
@@ -21,6 +21,7 @@
 #include "RetireControlUnit.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/MC/MCSubtargetInfo.h"
 #include <map>
@@ -368,6 +369,14 @@ public:
 
   void cycleEvent(llvm::SmallVectorImpl<ResourceRef> &ResourcesFreed);
 
+  // Returns the number of calls to cycleEvent() before the next resource is
+  // released, or the maximum unsigned value if no resource is in use.
+  unsigned getCyclesToNextRelease() const;
+
+  // Equivalent to NumCycles calls to cycleEvent() in which no resource is
+  // released.
+  void skipCycles(unsigned NumCycles);
+
 #ifndef NDEBUG
   void dump() const {
     for (const std::pair<uint64_t, UniqueResourceState> &Resource : Resources)
@@ -416,14 +425,16 @@ class Scheduler {
   /// Issue an instruction without updating the ready queue.
   void issueInstructionImpl(
       InstRef &IR,
-      llvm::SmallVectorImpl<std::pair<ResourceRef, double>> &Pipes);
+      llvm::SmallVectorImpl<std::pair<ResourceRef, double>> &Pipes,
+      llvm::Optional<MemoryAccess> &Access);
 
 public:
   Scheduler(const llvm::MCSchedModel &Model, unsigned LoadQueueSize,
-            unsigned StoreQueueSize, bool AssumeNoAlias)
+            unsigned StoreQueueSize, bool AssumeNoAlias,
+            std::unique_ptr<MemoryModel> MM = nullptr)
       : SM(Model), Resources(llvm::make_unique<ResourceManager>(SM)),
         LSU(llvm::make_unique<LSUnit>(LoadQueueSize, StoreQueueSize,
-                                      AssumeNoAlias)) {}
+                                      AssumeNoAlias, std::move(MM))) {}
 
   /// Check if the instruction in 'IR' can be dispatched.
   ///
@@ -439,9 +450,12 @@ public:
 
   /// Issue an instruction.  The Used container is populated with
   /// the resource objects consumed on behalf of issuing this instruction.
+  /// If the instruction is a load and the LSU has a memory model, then Access
+  /// is set to the access to the memory hierarchy that serves the load.
   void
   issueInstruction(InstRef &IR,
-                   llvm::SmallVectorImpl<std::pair<ResourceRef, double>> &Used);
+                   llvm::SmallVectorImpl<std::pair<ResourceRef, double>> &Used,
+                   llvm::Optional<MemoryAccess> &Access);
 
   /// This routine will attempt to issue an instruction immediately (for
   /// zero-latency instructions).
@@ -495,6 +509,15 @@ public:
   /// This method gives priority to older instructions.
   InstRef select();
 
+  /// Returns the number of cycles, starting from the next one, in which no
+  /// instruction is issued, becomes ready or finishes executing, and no
+  /// resource is released. The only thing that happens in these cycles is
+  /// that latencies count down.
+  unsigned getNumIdleCycles() const;
+
+  /// Advance the scheduler by NumCycles idle cycles.
+  void skipIdleCycles(unsigned NumCycles);
+
 #ifndef NDEBUG
   // Update the ready queues.
   void dump() const;
@@ -17,6 +17,7 @@
 #define LLVM_TOOLS_LLVM_MCA_STAGE_H
 
 #include "HWEventListener.h"
+#include <limits>
 #include <set>
 
 namespace mca {
@@ -52,6 +53,20 @@ public:
   /// routine called.
   virtual bool execute(InstRef &IR) = 0;
 
+  /// Called at the end of a cycle. Returns the number of cycles, starting
+  /// from the next one, in which this stage is known to neither change the
+  /// state of an instruction nor generate events, other than repeating the
+  /// stall events of the current cycle. The maximum unsigned value means
+  /// that the stage stays idle until another stage does something.
+  ///
+  /// The default implementation conservatively returns zero, which prevents
+  /// the pipeline from skipping cycles.
+  virtual unsigned getNumIdleCycles() const { return 0; }
+
+  /// Advance this stage by NumCycles idle cycles, as if preExecute(),
+  /// execute() and postExecute() were called for each of them.
+  virtual void skipIdleCycles(unsigned NumCycles) {}
+
   /// Add a listener to receive callbacks during the execution of this stage.
   void addListener(HWEventListener *Listener);
 
@@ -59,13 +59,22 @@ void SummaryView::onInstructionEvent(const HWInstructionEvent &Event) {
   }
 }
 
+double SummaryView::getIPC() const {
+  unsigned TotalInstructions = Source.size() * Source.getNumIterations();
+  return (double)TotalInstructions / TotalCycles;
+}
+
+double SummaryView::getBlockRThroughput() const {
+  return computeBlockRThroughput(SM, DispatchWidth, NumMicroOps,
+                                 ProcResourceUsage);
+}
+
 void SummaryView::printView(raw_ostream &OS) const {
   unsigned Iterations = Source.getNumIterations();
   unsigned Instructions = Source.size();
   unsigned TotalInstructions = Instructions * Iterations;
-  double IPC = (double)TotalInstructions / TotalCycles;
-  double BlockRThroughput = computeBlockRThroughput(
-      SM, DispatchWidth, NumMicroOps, ProcResourceUsage);
+  double IPC = getIPC();
+  double BlockRThroughput = getBlockRThroughput();
 
   std::string Buffer;
   raw_string_ostream TempStream(Buffer);
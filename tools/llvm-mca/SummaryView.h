@@ -55,16 +55,21 @@ class SummaryView : public View {
   // declared by the scheduling model.
   llvm::SmallVector<uint64_t, 8> ProcResourceMasks;
 
+public:
+  SummaryView(const llvm::MCSchedModel &Model, const SourceMgr &S,
+              unsigned Width);
+
+  unsigned getTotalCycles() const { return TotalCycles; }
+  unsigned getNumMicroOps() const { return NumMicroOps; }
+  unsigned getDispatchWidth() const { return DispatchWidth; }
+  double getIPC() const;
+
   // Compute the reciprocal throughput for the analyzed code block.
   // The reciprocal block throughput is computed as the MAX between:
   //   - NumMicroOps / DispatchWidth
   //   - Total Resource Cycles / #Units   (for every resource consumed).
   double getBlockRThroughput() const;
 
-public:
-  SummaryView(const llvm::MCSchedModel &Model, const SourceMgr &S,
-              unsigned Width);
-
   void onCycleEnd() override { ++TotalCycles; }
 
   void onInstructionEvent(const HWInstructionEvent &Event) override;
@@ -22,12 +22,14 @@
 //===----------------------------------------------------------------------===//
 
 #include "CodeRegion.h"
+#include "CriticalPathView.h"
 #include "DispatchStage.h"
 #include "DispatchStatistics.h"
 #include "ExecuteStage.h"
 #include "FetchStage.h"
 #include "InstructionInfoView.h"
 #include "InstructionTables.h"
+#include "MemoryHierarchyView.h"
 #include "Pipeline.h"
 #include "PipelinePrinter.h"
 #include "RegisterFile.h"
@@ -40,6 +42,7 @@
 #include "SchedulerStatistics.h"
 #include "SummaryView.h"
 #include "TimelineView.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/MC/MCAsmInfo.h"
 #include "llvm/MC/MCContext.h"
 #include "llvm/MC/MCObjectFileInfo.h"
@@ -49,12 +52,15 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/Host.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/WithColor.h"
 
@@ -133,6 +139,17 @@ static cl::opt<bool> PrintResourcePressureView(
     cl::desc("Print the resource pressure view (enabled by default)"),
     cl::cat(ViewOptions), cl::init(true));
 
+static cl::opt<bool>
+    PrintMemoryHierarchyView("memory-view",
+                             cl::desc("Print the memory hierarchy view"),
+                             cl::cat(ViewOptions), cl::init(false));
+
+static cl::opt<bool> PrintCriticalPathView(
+    "critical-path",
+    cl::desc("Print the loop-carried dependency chain and the throughput "
+             "limits of the code"),
+    cl::cat(ViewOptions), cl::init(false));
+
 static cl::opt<bool> PrintTimelineView("timeline",
                                        cl::desc("Print the timeline view"),
                                        cl::cat(ViewOptions), cl::init(false));
@@ -163,6 +180,36 @@ static cl::opt<unsigned>
                    cl::desc("Size of the store queue (unbound by default)"),
                    cl::cat(ToolOptions), cl::init(0));
 
+static cl::opt<double>
+    L1HitRate("l1-hit-rate",
+              cl::desc("Percentage of the loads that hit in the L1 cache "
+                       "(100 by default)"),
+              cl::cat(ToolOptions), cl::init(100.0));
+
+static cl::opt<double>
+    L2HitRate("l2-hit-rate",
+              cl::desc("Percentage of the L1 cache misses that hit in the L2 "
+                       "cache (100 by default)"),
+              cl::cat(ToolOptions), cl::init(100.0));
+
+static cl::opt<unsigned>
+    L2Latency("l2-latency",
+              cl::desc("Cycles added to the latency of a load that hits in "
+                       "the L2 cache (12 by default)"),
+              cl::cat(ToolOptions), cl::init(12));
+
+static cl::opt<unsigned>
+    MemoryLatency("memory-latency",
+                  cl::desc("Cycles added to the latency of a load that misses "
+                           "in the L2 cache (200 by default)"),
+                  cl::cat(ToolOptions), cl::init(200));
+
+static cl::opt<bool> SkipIdleCycles(
+    "skip-idle-cycles",
+    cl::desc("Skip the simulation of cycles in which nothing happens other "
+             "than waiting on latencies (enabled by default)"),
+    cl::cat(ToolOptions), cl::init(true));
+
 static cl::opt<bool>
     PrintInstructionTables("instruction-tables",
                            cl::desc("Print instruction tables"),
@@ -182,6 +229,23 @@ static cl::opt<bool>
                    cl::desc("Print all views including hardware statistics"),
                    cl::cat(ViewOptions), cl::init(false));
 
+enum class OutputFormatTy { Text, CSV, JSON };
+
+static cl::opt<OutputFormatTy> OutputFormat(
+    "output-format", cl::desc("Format of the analysis report"),
+    cl::values(clEnumValN(OutputFormatTy::Text, "text", "Full report (default)"),
+               clEnumValN(OutputFormatTy::CSV, "csv",
+                          "One line of summary statistics per code region"),
+               clEnumValN(OutputFormatTy::JSON, "json",
+                          "Summary statistics of every code region")),
+    cl::cat(ToolOptions), cl::init(OutputFormatTy::Text));
+
+static cl::opt<unsigned>
+    NumJobs("jobs",
+            cl::desc("Number of code regions to simulate in parallel "
+                     "(0 = all hardware threads, the default is 1)"),
+            cl::cat(ToolOptions), cl::init(1));
+
 namespace {
 
 const Target *getTarget(const char *ProgName) {
@@ -267,6 +331,113 @@ ErrorOr<std::unique_ptr<ToolOutputFile>> getOutputStream() {
   return EC;
 }
 
+// Returns the memory model selected on the command line, or nullptr if every
+// load hits in the L1 cache.
+std::unique_ptr<mca::MemoryModel> createMemoryModel() {
+  if (L1HitRate == 100.0 && !PrintMemoryHierarchyView)
+    return nullptr;
+  return llvm::make_unique<mca::HitRateMemoryModel>(L1HitRate, L2HitRate,
+                                                    L2Latency, MemoryLatency);
+}
+
+// The simulation of a code region. Every region gets its own pipeline, so
+// regions can be simulated concurrently; the reports are printed afterwards,
+// in the order of the regions in the input.
+struct RegionSimulation {
+  const mca::CodeRegion &Region;
+  // The index printed in the header of the region, if any.
+  unsigned Index;
+  bool PrintHeader;
+
+  mca::SourceMgr S;
+  mca::RetireControlUnit RCU;
+  mca::RegisterFile PRF;
+  mca::Scheduler HWS;
+  mca::Pipeline P;
+  mca::PipelinePrinter Printer;
+  const mca::SummaryView *Summary = nullptr;
+
+  RegionSimulation(const mca::CodeRegion &R, unsigned Index, bool PrintHeader,
+                   const MCSchedModel &SM, const MCRegisterInfo &MRI,
+                   unsigned Width)
+      : Region(R), Index(Index), PrintHeader(PrintHeader),
+        S(R.getInstructions(), Iterations), RCU(SM),
+        PRF(SM, MRI, RegisterFileSize),
+        HWS(SM, LoadQueueSize, StoreQueueSize, AssumeNoAlias,
+            createMemoryModel()),
+        P(Width, RegisterFileSize, LoadQueueSize, StoreQueueSize,
+          AssumeNoAlias, SkipIdleCycles),
+        Printer(P) {}
+};
+
+void printCSVField(raw_ostream &OS, StringRef Field) {
+  if (Field.find_first_of(",\"\r\n") == StringRef::npos) {
+    OS << Field;
+    return;
+  }
+  OS << '"';
+  for (char C : Field) {
+    if (C == '"')
+      OS << '"';
+    OS << C;
+  }
+  OS << '"';
+}
+
+void printJSONString(raw_ostream &OS, StringRef Str) {
+  OS << '"';
+  for (unsigned char C : Str) {
+    if (C == '"' || C == '\\')
+      OS << '\\' << C;
+    else if (C < 0x20)
+      OS << "\\u00" << hexdigit(C >> 4, true) << hexdigit(C & 0xF, true);
+    else
+      OS << C;
+  }
+  OS << '"';
+}
+
+// Prints the summary statistics of the simulated regions as CSV or JSON.
+void printSummaries(raw_ostream &OS,
+                    ArrayRef<std::unique_ptr<RegionSimulation>> Simulations) {
+  if (OutputFormat == OutputFormatTy::CSV)
+    OS << "region,description,iterations,instructions,total_cycles,"
+          "dispatch_width,uops,ipc,block_rthroughput\n";
+  else
+    OS << "[";
+
+  bool First = true;
+  for (const std::unique_ptr<RegionSimulation> &Sim : Simulations) {
+    const mca::SummaryView &SV = *Sim->Summary;
+    unsigned Instructions = Sim->S.size() * Sim->S.getNumIterations();
+    if (OutputFormat == OutputFormatTy::CSV) {
+      OS << Sim->Index << ',';
+      printCSVField(OS, Sim->Region.getDescription());
+      OS << ',' << Sim->S.getNumIterations() << ',' << Instructions << ','
+         << SV.getTotalCycles() << ',' << SV.getDispatchWidth() << ','
+         << SV.getNumMicroOps() << ',' << format("%.2f", SV.getIPC()) << ','
+         << format("%.1f", SV.getBlockRThroughput()) << '\n';
+      continue;
+    }
+
+    OS << (First ? "\n" : ",\n") << "  {\"region\": " << Sim->Index
+       << ", \"description\": ";
+    printJSONString(OS, Sim->Region.getDescription());
+    OS << ", \"iterations\": " << Sim->S.getNumIterations()
+       << ", \"instructions\": " << Instructions
+       << ", \"total_cycles\": " << SV.getTotalCycles()
+       << ", \"dispatch_width\": " << SV.getDispatchWidth()
+       << ", \"uops\": " << SV.getNumMicroOps()
+       << ", \"ipc\": " << format("%.2f", SV.getIPC())
+       << ", \"block_rthroughput\": "
+       << format("%.1f", SV.getBlockRThroughput()) << "}";
+    First = false;
+  }
+
+  if (OutputFormat == OutputFormatTy::JSON)
+    OS << "\n]\n";
+}
+
 class MCStreamerWrapper final : public MCStreamer {
   mca::CodeRegions &Regions;
 
@@ -371,6 +542,12 @@ int main(int argc, char **argv) {
   // Apply overrides to llvm-mca specific options.
   processViewOptions();
 
+  if (L1HitRate < 0.0 || L1HitRate > 100.0 || L2HitRate < 0.0 ||
+      L2HitRate > 100.0) {
+    WithColor::error() << "cache hit rates must be between 0 and 100.\n";
+    return 1;
+  }
+
   SourceMgr SrcMgr;
 
   // Tell SrcMgr about this buffer, which is what the parser will pick up.
@@ -467,8 +644,14 @@ int main(int argc, char **argv) {
   // Create an instruction builder.
   mca::InstrBuilder IB(*STI, *MCII, *MRI, *MCIA);
 
+  if (PrintInstructionTables && OutputFormat != OutputFormatTy::Text) {
+    WithColor::error() << "instruction tables can only be printed as text.\n";
+    return 1;
+  }
+
   // Number each region in the sequence.
   unsigned RegionIdx = 0;
+  std::vector<std::unique_ptr<RegionSimulation>> Simulations;
   for (const std::unique_ptr<mca::CodeRegion> &Region : Regions) {
     // Skip empty code regions.
     if (Region->empty())
@@ -476,18 +659,18 @@ int main(int argc, char **argv) {
 
     // Don't print the header of this region if it is the default region, and
     // it doesn't have an end location.
-    if (Region->startLoc().isValid() || Region->endLoc().isValid()) {
-      TOF->os() << "\n[" << RegionIdx++ << "] Code Region";
+    bool PrintHeader =
+        Region->startLoc().isValid() || Region->endLoc().isValid();
+    unsigned Index = PrintHeader ? RegionIdx++ : 0;
+
+    if (PrintInstructionTables) {
+      TOF->os() << "\n[" << Index << "] Code Region";
       StringRef Desc = Region->getDescription();
       if (!Desc.empty())
         TOF->os() << " - " << Desc;
       TOF->os() << "\n\n";
-    }
-
-    mca::SourceMgr S(Region->getInstructions(),
-                     PrintInstructionTables ? 1 : Iterations);
 
-    if (PrintInstructionTables) {
+      mca::SourceMgr S(Region->getInstructions(), 1);
       mca::InstructionTables IT(SM, IB, S);
 
       if (PrintInstructionInfoView) {
@@ -501,23 +684,35 @@ int main(int argc, char **argv) {
       continue;
     }
 
-    // Create the hardware components required for the pipeline.
-    mca::RetireControlUnit RCU(SM);
-    mca::RegisterFile PRF(SM, *MRI, RegisterFileSize);
-    mca::Scheduler HWS(SM, LoadQueueSize, StoreQueueSize, AssumeNoAlias);
+    // Create the instruction descriptors upfront: simulations only look them
+    // up, so they can share the instruction builder.
+    for (const std::unique_ptr<const MCInst> &MCI : Region->getInstructions())
+      IB.getOrCreateInstrDesc(*MCI);
+
+    auto Sim = llvm::make_unique<RegionSimulation>(*Region, Index, PrintHeader,
+                                                   SM, *MRI, Width);
+    const mca::SourceMgr &S = Sim->S;
+
+    // Add stages to the pipeline.
+    mca::Pipeline &P = Sim->P;
+    P.appendStage(llvm::make_unique<mca::FetchStage>(IB, Sim->S));
+    P.appendStage(llvm::make_unique<mca::DispatchStage>(
+        *STI, *MRI, RegisterFileSize, Width, Sim->RCU, Sim->PRF, Sim->HWS));
+    P.appendStage(llvm::make_unique<mca::RetireStage>(Sim->RCU, Sim->PRF));
+    P.appendStage(llvm::make_unique<mca::ExecuteStage>(Sim->RCU, Sim->HWS));
+    mca::PipelinePrinter &Printer = Sim->Printer;
+
+    if (PrintSummaryView || OutputFormat != OutputFormatTy::Text) {
+      auto Summary = llvm::make_unique<mca::SummaryView>(SM, S, Width);
+      Sim->Summary = Summary.get();
+      Printer.addView(std::move(Summary));
+    }
 
-    // Create the pipeline and add stages to it.
-    auto P = llvm::make_unique<mca::Pipeline>(
-        Width, RegisterFileSize, LoadQueueSize, StoreQueueSize, AssumeNoAlias);
-    P->appendStage(llvm::make_unique<mca::FetchStage>(IB, S));
-    P->appendStage(llvm::make_unique<mca::DispatchStage>(
-        *STI, *MRI, RegisterFileSize, Width, RCU, PRF, HWS));
-    P->appendStage(llvm::make_unique<mca::RetireStage>(RCU, PRF));
-    P->appendStage(llvm::make_unique<mca::ExecuteStage>(RCU, HWS));
-    mca::PipelinePrinter Printer(*P);
+    Simulations.emplace_back(std::move(Sim));
 
-    if (PrintSummaryView)
-      Printer.addView(llvm::make_unique<mca::SummaryView>(SM, S, Width));
+    // The machine-readable formats only report the summary.
+    if (OutputFormat != OutputFormatTy::Text)
+      continue;
 
     if (PrintInstructionInfoView)
       Printer.addView(
@@ -539,13 +734,46 @@ int main(int argc, char **argv) {
       Printer.addView(
           llvm::make_unique<mca::ResourcePressureView>(*STI, *IP, S));
 
+    if (PrintMemoryHierarchyView)
+      Printer.addView(
+          llvm::make_unique<mca::MemoryHierarchyView>(*STI, *IP, S));
+
+    if (PrintCriticalPathView)
+      Printer.addView(
+          llvm::make_unique<mca::CriticalPathView>(*STI, *IP, S, Width));
+
     if (PrintTimelineView) {
       Printer.addView(llvm::make_unique<mca::TimelineView>(
           *STI, *IP, S, TimelineMaxIterations, TimelineMaxCycles));
     }
+  }
 
-    P->run();
-    Printer.printReport(TOF->os());
+  unsigned Jobs = NumJobs ? NumJobs : llvm::heavyweight_hardware_concurrency();
+  if (Jobs > 1 && Simulations.size() > 1) {
+    ThreadPool Pool(std::min<size_t>(Jobs, Simulations.size()));
+    for (std::unique_ptr<RegionSimulation> &Sim : Simulations)
+      Pool.async([&Sim]() { Sim->P.run(); });
+    Pool.wait();
+  } else {
+    for (std::unique_ptr<RegionSimulation> &Sim : Simulations)
+      Sim->P.run();
+  }
+
+  if (OutputFormat != OutputFormatTy::Text) {
+    printSummaries(TOF->os(), Simulations);
+    TOF->keep();
+    return 0;
+  }
+
+  for (const std::unique_ptr<RegionSimulation> &Sim : Simulations) {
+    if (Sim->PrintHeader) {
+      TOF->os() << "\n[" << Sim->Index << "] Code Region";
+      StringRef Desc = Sim->Region.getDescription();
+      if (!Desc.empty())
+        TOF->os() << " - " << Desc;
+      TOF->os() << "\n\n";
+    }
+    Sim->Printer.printReport(TOF->os());
   }
 
   TOF->keep();
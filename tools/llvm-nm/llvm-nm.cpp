@@ -38,7 +38,10 @@
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
+#include <atomic>
 #include <vector>
 
 using namespace llvm;
@@ -129,7 +132,7 @@ cl::opt<bool> PrintSize("print-size",
                         cl::desc("Show symbol size instead of address"));
 cl::alias PrintSizeS("S", cl::desc("Alias for --print-size"),
                      cl::aliasopt(PrintSize), cl::Grouping);
-bool MachOPrintSizeWarning = false;
+std::atomic<bool> MachOPrintSizeWarning(false);
 
 cl::opt<bool> SizeSort("size-sort", cl::desc("Sort symbols by size"));
 
@@ -178,18 +181,26 @@ cl::opt<bool> DyldInfoOnly("dyldinfo-only",
 cl::opt<bool> NoLLVMBitcode("no-llvm-bc",
                             cl::desc("Disable LLVM bitcode reader"));
 
+cl::opt<unsigned>
+    NumThreads("num-threads",
+               cl::desc("Number of threads used to dump the members of "
+                        "archives (0 = number of hardware threads)"),
+               cl::init(1));
+
 bool PrintAddress = true;
 
 bool MultipleFiles = false;
 
-bool HadError = false;
+std::atomic<bool> HadError(false);
 
 std::string ToolName;
 } // anonymous namespace
 
+// The error() functions format the whole message before writing it so that
+// the messages of archive members dumped in parallel are not interleaved.
 static void error(Twine Message, Twine Path = Twine()) {
   HadError = true;
-  errs() << ToolName << ": " << Path << ": " << Message << ".\n";
+  errs() << (ToolName + ": " + Path + ": " + Message + ".\n").str();
 }
 
 static bool error(std::error_code EC, Twine Path = Twine()) {
@@ -206,7 +217,9 @@ static bool error(std::error_code EC, Twine Path = Twine()) {
 static void error(llvm::Error E, StringRef FileName, const Archive::Child &C,
                   StringRef ArchitectureName = StringRef()) {
   HadError = true;
-  errs() << ToolName << ": " << FileName;
+  std::string Buf;
+  raw_string_ostream OS(Buf);
+  OS << ToolName << ": " << FileName;
 
   Expected<StringRef> NameOrErr = C.getName();
   // TODO: if we have a error getting the name then it would be nice to print
@@ -214,18 +227,17 @@ static void error(llvm::Error E, StringRef FileName, const Archive::Child &C,
   // archive instead of "???" as the name.
   if (!NameOrErr) {
     consumeError(NameOrErr.takeError());
-    errs() << "(" << "???" << ")";
+    OS << "(" << "???" << ")";
   } else
-    errs() << "(" << NameOrErr.get() << ")";
+    OS << "(" << NameOrErr.get() << ")";
 
   if (!ArchitectureName.empty())
-    errs() << " (for architecture " << ArchitectureName << ") ";
+    OS << " (for architecture " << ArchitectureName << ") ";
 
-  std::string Buf;
-  raw_string_ostream OS(Buf);
+  OS << " ";
   logAllUnhandledErrors(std::move(E), OS, "");
-  OS.flush();
-  errs() << " " << Buf << "\n";
+  OS << "\n";
+  errs() << OS.str();
 }
 
 // This version of error() prints the file name and which architecture slice it
@@ -235,16 +247,17 @@ static void error(llvm::Error E, StringRef FileName, const Archive::Child &C,
 static void error(llvm::Error E, StringRef FileName,
                   StringRef ArchitectureName = StringRef()) {
   HadError = true;
-  errs() << ToolName << ": " << FileName;
+  std::string Buf;
+  raw_string_ostream OS(Buf);
+  OS << ToolName << ": " << FileName;
 
   if (!ArchitectureName.empty())
-    errs() << " (for architecture " << ArchitectureName << ") ";
+    OS << " (for architecture " << ArchitectureName << ") ";
 
-  std::string Buf;
-  raw_string_ostream OS(Buf);
+  OS << " ";
   logAllUnhandledErrors(std::move(E), OS, "");
-  OS.flush();
-  errs() << " " << Buf << "\n";
+  OS << "\n";
+  errs() << OS.str();
 }
 
 namespace {
@@ -305,9 +318,7 @@ static char isSymbolList64Bit(SymbolicFile &Obj) {
   return cast<ELFObjectFileBase>(Obj).getBytesInAddress() == 8;
 }
 
-static StringRef CurrentFilename;
 typedef std::vector<NMSymbol> SymbolListT;
-static SymbolListT SymbolList;
 
 static char getSymbolNMTypeChar(IRObjectFile &Obj, basic_symbol_iterator I);
 
@@ -316,9 +327,10 @@ static char getSymbolNMTypeChar(IRObjectFile &Obj, basic_symbol_iterator I);
 // the darwin format it produces the same output as darwin's nm(1) -m output
 // and when printing Mach-O symbols in hex it produces the same output as
 // darwin's nm(1) -x format.
-static void darwinPrintSymbol(SymbolicFile &Obj, SymbolListT::iterator I,
-                              char *SymbolAddrStr, const char *printBlanks,
-                              const char *printDashes, const char *printFormat) {
+static void darwinPrintSymbol(raw_ostream &OS, SymbolicFile &Obj,
+                              SymbolListT::iterator I, char *SymbolAddrStr,
+                              const char *printBlanks, const char *printDashes,
+                              const char *printFormat) {
   MachO::mach_header H;
   MachO::mach_header_64 H_64;
   uint32_t Filetype = MachO::MH_OBJECT;
@@ -396,31 +408,31 @@ static void darwinPrintSymbol(SymbolicFile &Obj, SymbolListT::iterator I,
   if (FormatMachOasHex) {
     char Str[18] = "";
     format(printFormat, NValue).print(Str, sizeof(Str));
-    outs() << Str << ' ';
+    OS << Str << ' ';
     format("%02x", NType).print(Str, sizeof(Str));
-    outs() << Str << ' ';
+    OS << Str << ' ';
     format("%02x", NSect).print(Str, sizeof(Str));
-    outs() << Str << ' ';
+    OS << Str << ' ';
     format("%04x", NDesc).print(Str, sizeof(Str));
-    outs() << Str << ' ';
+    OS << Str << ' ';
     format("%08x", NStrx).print(Str, sizeof(Str));
-    outs() << Str << ' ';
-    outs() << I->Name;
+    OS << Str << ' ';
+    OS << I->Name;
     if ((NType & MachO::N_TYPE) == MachO::N_INDR) {
-      outs() << " (indirect for ";
+      OS << " (indirect for ";
       format(printFormat, NValue).print(Str, sizeof(Str));
-      outs() << Str << ' ';
+      OS << Str << ' ';
       StringRef IndirectName;
       if (I->Sym.getRawDataRefImpl().p) {
         if (MachO->getIndirectName(I->Sym.getRawDataRefImpl(), IndirectName))
-          outs() << "?)";
+          OS << "?)";
         else
-          outs() << IndirectName << ")";
+          OS << IndirectName << ")";
       }
       else
-        outs() << I->IndirectName << ")";
+        OS << I->IndirectName << ")";
     }
-    outs() << "\n";
+    OS << "\n";
     return;
   }
 
@@ -429,51 +441,51 @@ static void darwinPrintSymbol(SymbolicFile &Obj, SymbolListT::iterator I,
       strcpy(SymbolAddrStr, printBlanks);
     if (Obj.isIR() && (NType & MachO::N_TYPE) == MachO::N_TYPE)
       strcpy(SymbolAddrStr, printDashes);
-    outs() << SymbolAddrStr << ' ';
+    OS << SymbolAddrStr << ' ';
   }
 
   switch (NType & MachO::N_TYPE) {
   case MachO::N_UNDF:
     if (NValue != 0) {
-      outs() << "(common) ";
+      OS << "(common) ";
       if (MachO::GET_COMM_ALIGN(NDesc) != 0)
-        outs() << "(alignment 2^" << (int)MachO::GET_COMM_ALIGN(NDesc) << ") ";
+        OS << "(alignment 2^" << (int)MachO::GET_COMM_ALIGN(NDesc) << ") ";
     } else {
       if ((NType & MachO::N_TYPE) == MachO::N_PBUD)
-        outs() << "(prebound ";
+        OS << "(prebound ";
       else
-        outs() << "(";
+        OS << "(";
       if ((NDesc & MachO::REFERENCE_TYPE) ==
           MachO::REFERENCE_FLAG_UNDEFINED_LAZY)
-        outs() << "undefined [lazy bound]) ";
+        OS << "undefined [lazy bound]) ";
       else if ((NDesc & MachO::REFERENCE_TYPE) ==
                MachO::REFERENCE_FLAG_PRIVATE_UNDEFINED_LAZY)
-        outs() << "undefined [private lazy bound]) ";
+        OS << "undefined [private lazy bound]) ";
       else if ((NDesc & MachO::REFERENCE_TYPE) ==
                MachO::REFERENCE_FLAG_PRIVATE_UNDEFINED_NON_LAZY)
-        outs() << "undefined [private]) ";
+        OS << "undefined [private]) ";
       else
-        outs() << "undefined) ";
+        OS << "undefined) ";
     }
     break;
   case MachO::N_ABS:
-    outs() << "(absolute) ";
+    OS << "(absolute) ";
     break;
   case MachO::N_INDR:
-    outs() << "(indirect) ";
+    OS << "(indirect) ";
     break;
   case MachO::N_SECT: {
     if (Obj.isIR()) {
       // For llvm bitcode files print out a fake section name using the values
       // use 1, 2 and 3 for section numbers as set above.
       if (NSect == 1)
-        outs() << "(LTO,CODE) ";
+        OS << "(LTO,CODE) ";
       else if (NSect == 2)
-        outs() << "(LTO,DATA) ";
+        OS << "(LTO,DATA) ";
       else if (NSect == 3)
-        outs() << "(LTO,RODATA) ";
+        OS << "(LTO,RODATA) ";
       else
-        outs() << "(?,?) ";
+        OS << "(?,?) ";
       break;
     }
     section_iterator Sec = SectionRef();
@@ -482,12 +494,12 @@ static void darwinPrintSymbol(SymbolicFile &Obj, SymbolListT::iterator I,
         MachO->getSymbolSection(I->Sym.getRawDataRefImpl());
       if (!SecOrErr) {
         consumeError(SecOrErr.takeError());
-        outs() << "(?,?) ";
+        OS << "(?,?) ";
         break;
       }
       Sec = *SecOrErr;
       if (Sec == MachO->section_end()) {
-        outs() << "(?,?) ";
+        OS << "(?,?) ";
         break;
       }
     } else {
@@ -497,73 +509,73 @@ static void darwinPrintSymbol(SymbolicFile &Obj, SymbolListT::iterator I,
     StringRef SectionName;
     MachO->getSectionName(Ref, SectionName);
     StringRef SegmentName = MachO->getSectionFinalSegmentName(Ref);
-    outs() << "(" << SegmentName << "," << SectionName << ") ";
+    OS << "(" << SegmentName << "," << SectionName << ") ";
     break;
   }
   default:
-    outs() << "(?) ";
+    OS << "(?) ";
     break;
   }
 
   if (NType & MachO::N_EXT) {
     if (NDesc & MachO::REFERENCED_DYNAMICALLY)
-      outs() << "[referenced dynamically] ";
+      OS << "[referenced dynamically] ";
     if (NType & MachO::N_PEXT) {
       if ((NDesc & MachO::N_WEAK_DEF) == MachO::N_WEAK_DEF)
-        outs() << "weak private external ";
+        OS << "weak private external ";
       else
-        outs() << "private external ";
+        OS << "private external ";
     } else {
       if ((NDesc & MachO::N_WEAK_REF) == MachO::N_WEAK_REF ||
           (NDesc & MachO::N_WEAK_DEF) == MachO::N_WEAK_DEF) {
         if ((NDesc & (MachO::N_WEAK_REF | MachO::N_WEAK_DEF)) ==
             (MachO::N_WEAK_REF | MachO::N_WEAK_DEF))
-          outs() << "weak external automatically hidden ";
+          OS << "weak external automatically hidden ";
         else
-          outs() << "weak external ";
+          OS << "weak external ";
       } else
-        outs() << "external ";
+        OS << "external ";
     }
   } else {
     if (NType & MachO::N_PEXT)
-      outs() << "non-external (was a private external) ";
+      OS << "non-external (was a private external) ";
     else
-      outs() << "non-external ";
+      OS << "non-external ";
   }
 
   if (Filetype == MachO::MH_OBJECT &&
       (NDesc & MachO::N_NO_DEAD_STRIP) == MachO::N_NO_DEAD_STRIP)
-    outs() << "[no dead strip] ";
+    OS << "[no dead strip] ";
 
   if (Filetype == MachO::MH_OBJECT &&
       ((NType & MachO::N_TYPE) != MachO::N_UNDF) &&
       (NDesc & MachO::N_SYMBOL_RESOLVER) == MachO::N_SYMBOL_RESOLVER)
-    outs() << "[symbol resolver] ";
+    OS << "[symbol resolver] ";
 
   if (Filetype == MachO::MH_OBJECT &&
       ((NType & MachO::N_TYPE) != MachO::N_UNDF) &&
       (NDesc & MachO::N_ALT_ENTRY) == MachO::N_ALT_ENTRY)
-    outs() << "[alt entry] ";
+    OS << "[alt entry] ";
 
   if ((NDesc & MachO::N_ARM_THUMB_DEF) == MachO::N_ARM_THUMB_DEF)
-    outs() << "[Thumb] ";
+    OS << "[Thumb] ";
 
   if ((NType & MachO::N_TYPE) == MachO::N_INDR) {
-    outs() << I->Name << " (for ";
+    OS << I->Name << " (for ";
     StringRef IndirectName;
     if (MachO) {
       if (I->Sym.getRawDataRefImpl().p) {
         if (MachO->getIndirectName(I->Sym.getRawDataRefImpl(), IndirectName))
-          outs() << "?)";
+          OS << "?)";
         else
-          outs() << IndirectName << ")";
+          OS << IndirectName << ")";
       }
       else
-        outs() << I->IndirectName << ")";
+        OS << I->IndirectName << ")";
     } else
-      outs() << "?)";
+      OS << "?)";
   } else
-    outs() << I->Name;
+    OS << I->Name;
 
   if ((Flags & MachO::MH_TWOLEVEL) == MachO::MH_TWOLEVEL &&
       (((NType & MachO::N_TYPE) == MachO::N_UNDF && NValue == 0) ||
@@ -571,21 +583,21 @@ static void darwinPrintSymbol(SymbolicFile &Obj, SymbolListT::iterator I,
     uint32_t LibraryOrdinal = MachO::GET_LIBRARY_ORDINAL(NDesc);
     if (LibraryOrdinal != 0) {
       if (LibraryOrdinal == MachO::EXECUTABLE_ORDINAL)
-        outs() << " (from executable)";
+        OS << " (from executable)";
       else if (LibraryOrdinal == MachO::DYNAMIC_LOOKUP_ORDINAL)
-        outs() << " (dynamically looked up)";
+        OS << " (dynamically looked up)";
       else {
         StringRef LibraryName;
         if (!MachO ||
             MachO->getLibraryShortNameByIndex(LibraryOrdinal - 1, LibraryName))
-          outs() << " (from bad library ordinal " << LibraryOrdinal << ")";
+          OS << " (from bad library ordinal " << LibraryOrdinal << ")";
         else
-          outs() << " (from " << LibraryName << ")";
+          OS << " (from " << LibraryName << ")";
       }
     }
   }
 
-  outs() << "\n";
+  OS << "\n";
 }
 
 // Table that maps Darwin's Mach-O stab constants to strings to allow printing.
@@ -637,7 +649,8 @@ static const char *getDarwinStabString(uint8_t NType) {
 
 // darwinPrintStab() prints the n_sect, n_desc along with a symbolic name of
 // a stab n_type value in a Mach-O file.
-static void darwinPrintStab(MachOObjectFile *MachO, SymbolListT::iterator I) {
+static void darwinPrintStab(raw_ostream &OS, MachOObjectFile *MachO,
+                            SymbolListT::iterator I) {
   MachO::nlist_64 STE_64;
   MachO::nlist STE;
   uint8_t NType;
@@ -658,14 +671,14 @@ static void darwinPrintStab(MachOObjectFile *MachO, SymbolListT::iterator I) {
 
   char Str[18] = "";
   format("%02x", NSect).print(Str, sizeof(Str));
-  outs() << ' ' << Str << ' ';
+  OS << ' ' << Str << ' ';
   format("%04x", NDesc).print(Str, sizeof(Str));
-  outs() << Str << ' ';
+  OS << Str << ' ';
   if (const char *stabString = getDarwinStabString(NType))
     format("%5.5s", stabString).print(Str, sizeof(Str));
   else
     format("   %02x", NType).print(Str, sizeof(Str));
-  outs() << Str;
+  OS << Str;
 }
 
 static Optional<std::string> demangle(StringRef Name, bool StripUnderscore) {
@@ -690,9 +703,11 @@ static bool symbolIsDefined(const NMSymbol &Sym) {
   return Sym.TypeChar != 'U' && Sym.TypeChar != 'w' && Sym.TypeChar != 'v';
 }
 
-static void sortAndPrintSymbolList(SymbolicFile &Obj, bool printName,
+static void sortAndPrintSymbolList(raw_ostream &OS, SymbolicFile &Obj,
+                                   SymbolListT &SymbolList, bool printName,
                                    const std::string &ArchiveName,
                                    const std::string &ArchitectureName) {
+  StringRef CurrentFilename = Obj.getFileName();
   if (!NoSort) {
     std::function<bool(const NMSymbol &, const NMSymbol &)> Cmp;
     if (NumericSort)
@@ -709,16 +724,16 @@ static void sortAndPrintSymbolList(SymbolicFile &Obj, bool printName,
 
   if (!PrintFileName) {
     if (OutputFormat == posix && MultipleFiles && printName) {
-      outs() << '\n' << CurrentFilename << ":\n";
+      OS << '\n' << CurrentFilename << ":\n";
     } else if (OutputFormat == bsd && MultipleFiles && printName) {
-      outs() << "\n" << CurrentFilename << ":\n";
+      OS << "\n" << CurrentFilename << ":\n";
     } else if (OutputFormat == sysv) {
-      outs() << "\n\nSymbols from " << CurrentFilename << ":\n\n";
+      OS << "\n\nSymbols from " << CurrentFilename << ":\n\n";
       if (isSymbolList64Bit(Obj))
-        outs() << "Name                  Value           Class        Type"
+        OS << "Name                  Value           Class        Type"
                << "         Size             Line  Section\n";
       else
-        outs() << "Name                  Value   Class        Type"
+        OS << "Name                  Value   Class        Type"
                << "         Size     Line  Section\n";
     }
   }
@@ -773,19 +788,19 @@ static void sortAndPrintSymbolList(SymbolicFile &Obj, bool printName,
       continue;
     if (PrintFileName) {
       if (!ArchitectureName.empty())
-        outs() << "(for architecture " << ArchitectureName << "):";
+        OS << "(for architecture " << ArchitectureName << "):";
       if (OutputFormat == posix && !ArchiveName.empty())
-        outs() << ArchiveName << "[" << CurrentFilename << "]: ";
+        OS << ArchiveName << "[" << CurrentFilename << "]: ";
       else {
         if (!ArchiveName.empty())
-          outs() << ArchiveName << ":";
-        outs() << CurrentFilename << ": ";
+          OS << ArchiveName << ":";
+        OS << CurrentFilename << ": ";
       }
     }
     if ((JustSymbolName ||
          (UndefinedOnly && MachO && OutputFormat != darwin)) &&
         OutputFormat != posix) {
-      outs() << Name << "\n";
+      OS << Name << "\n";
       continue;
     }
 
@@ -823,47 +838,45 @@ static void sortAndPrintSymbolList(SymbolicFile &Obj, bool printName,
     // printing Mach-O symbols in hex and not a Mach-O object fall back to
     // OutputFormat bsd (see below).
     if ((OutputFormat == darwin || FormatMachOasHex) && (MachO || Obj.isIR())) {
-      darwinPrintSymbol(Obj, I, SymbolAddrStr, printBlanks, printDashes,
+      darwinPrintSymbol(OS, Obj, I, SymbolAddrStr, printBlanks, printDashes,
                         printFormat);
     } else if (OutputFormat == posix) {
-      outs() << Name << " " << I->TypeChar << " ";
+      OS << Name << " " << I->TypeChar << " ";
       if (MachO)
-        outs() << SymbolAddrStr << " " << "0" /* SymbolSizeStr */ << "\n";
+        OS << SymbolAddrStr << " " << "0" /* SymbolSizeStr */ << "\n";
       else
-        outs() << SymbolAddrStr << " " << SymbolSizeStr << "\n";
+        OS << SymbolAddrStr << " " << SymbolSizeStr << "\n";
     } else if (OutputFormat == bsd || (OutputFormat == darwin && !MachO)) {
       if (PrintAddress)
-        outs() << SymbolAddrStr << ' ';
+        OS << SymbolAddrStr << ' ';
       if (PrintSize) {
-        outs() << SymbolSizeStr;
-        outs() << ' ';
+        OS << SymbolSizeStr;
+        OS << ' ';
       }
-      outs() << I->TypeChar;
+      OS << I->TypeChar;
       if (I->TypeChar == '-' && MachO)
-        darwinPrintStab(MachO, I);
-      outs() << " " << Name;
+        darwinPrintStab(OS, MachO, I);
+      OS << " " << Name;
       if (I->TypeChar == 'I' && MachO) {
-        outs() << " (indirect for ";
+        OS << " (indirect for ";
         if (I->Sym.getRawDataRefImpl().p) {
           StringRef IndirectName;
           if (MachO->getIndirectName(I->Sym.getRawDataRefImpl(), IndirectName))
-            outs() << "?)";
+            OS << "?)";
           else
-            outs() << IndirectName << ")";
+            OS << IndirectName << ")";
         } else
-          outs() << I->IndirectName << ")";
+          OS << I->IndirectName << ")";
       }
-      outs() << "\n";
+      OS << "\n";
     } else if (OutputFormat == sysv) {
       std::string PaddedName(Name);
       while (PaddedName.length() < 20)
         PaddedName += " ";
-      outs() << PaddedName << "|" << SymbolAddrStr << "|   " << I->TypeChar
+      OS << PaddedName << "|" << SymbolAddrStr << "|   " << I->TypeChar
              << "  |                  |" << SymbolSizeStr << "|     |\n";
     }
   }
-
-  SymbolList.clear();
 }
 
 static char getSymbolNMTypeChar(ELFObjectFileBase &Obj,
@@ -1127,7 +1140,9 @@ static unsigned getNsectInMachO(MachOObjectFile &Obj, BasicSymbolRef Sym) {
 static void
 dumpSymbolNamesFromObject(SymbolicFile &Obj, bool printName,
                           const std::string &ArchiveName = std::string(),
-                          const std::string &ArchitectureName = std::string()) {
+                          const std::string &ArchitectureName = std::string(),
+                          raw_ostream &Out = outs()) {
+  SymbolListT SymbolList;
   auto Symbols = Obj.symbols();
   if (DynamicSyms) {
     const auto *E = dyn_cast<ELFObjectFileBase>(&Obj);
@@ -1676,8 +1691,8 @@ dumpSymbolNamesFromObject(SymbolicFile &Obj, bool printName,
     }
   }
 
-  CurrentFilename = Obj.getFileName();
-  sortAndPrintSymbolList(Obj, printName, ArchiveName, ArchitectureName);
+  sortAndPrintSymbolList(Out, Obj, SymbolList, printName, ArchiveName,
+                         ArchitectureName);
 }
 
 // checkMachOAndArchFlags() checks to see if the SymbolicFile is a Mach-O file
@@ -1714,6 +1729,67 @@ static bool checkMachOAndArchFlags(SymbolicFile *O, std::string &Filename) {
   return true;
 }
 
+// Dumps the symbols of the member \p C of the archive \p Filename to \p OS.
+// Returns false if the remaining members must not be dumped.
+static bool dumpArchiveMember(const Archive::Child &C, std::string &Filename,
+                              LLVMContext &Context, raw_ostream &OS) {
+  Expected<std::unique_ptr<Binary>> ChildOrErr = C.getAsBinary(&Context);
+  if (!ChildOrErr) {
+    if (auto E = isNotObjectErrorInvalidFileType(ChildOrErr.takeError()))
+      error(std::move(E), Filename, C);
+    return true;
+  }
+  if (SymbolicFile *O = dyn_cast<SymbolicFile>(&*ChildOrErr.get())) {
+    if (PrintSize && isa<MachOObjectFile>(O) &&
+        !MachOPrintSizeWarning.exchange(true))
+      errs() << ToolName << ": warning sizes with -print-size for Mach-O "
+                "files are always zero.\n";
+    if (!checkMachOAndArchFlags(O, Filename))
+      return false;
+    if (!PrintFileName) {
+      OS << "\n";
+      if (isa<MachOObjectFile>(O)) {
+        OS << Filename << "(" << O->getFileName() << ")";
+      } else
+        OS << O->getFileName();
+      OS << ":\n";
+    }
+    dumpSymbolNamesFromObject(*O, false, Filename, std::string(), OS);
+  }
+  return true;
+}
+
+// Dumps the members of the archive \p A on a thread pool. The members are
+// mapped from the archive buffer without being copied, each one is parsed in
+// its own LLVMContext and printed into its own buffer, and the buffers are
+// written out in member order as soon as they are complete, so the output is
+// the same as the one of the serial dump.
+static void dumpArchiveMembersInParallel(Archive &A, std::string &Filename) {
+  Error Err = Error::success();
+  std::vector<Archive::Child> Children;
+  for (auto &C : A.children(Err))
+    Children.push_back(C);
+
+  std::vector<std::string> Outputs(Children.size());
+  std::vector<std::shared_future<void>> Done;
+  Done.reserve(Children.size());
+  ThreadPool Pool(NumThreads ? NumThreads : hardware_concurrency());
+  for (size_t I = 0, E = Children.size(); I != E; ++I)
+    Done.push_back(Pool.async([&, I]() {
+      LLVMContext Context;
+      raw_string_ostream OS(Outputs[I]);
+      dumpArchiveMember(Children[I], Filename, Context, OS);
+    }));
+  for (size_t I = 0, E = Children.size(); I != E; ++I) {
+    Done[I].wait();
+    outs() << Outputs[I];
+    std::string().swap(Outputs[I]);
+  }
+
+  if (Err)
+    error(std::move(Err), A.getFileName());
+}
+
 static void dumpSymbolNamesFromFile(std::string &Filename) {
   ErrorOr<std::unique_ptr<MemoryBuffer>> BufferOrErr =
       MemoryBuffer::getFileOrSTDIN(Filename);
@@ -1751,34 +1827,18 @@ static void dumpSymbolNamesFromFile(std::string &Filename) {
       }
     }
 
+    // With -arch the first member of the wrong architecture stops the dump,
+    // which needs the members to be dumped in order.
+    if (NumThreads != 1 && ArchFlags.empty()) {
+      dumpArchiveMembersInParallel(*A, Filename);
+      return;
+    }
+
     {
       Error Err = Error::success();
-      for (auto &C : A->children(Err)) {
-        Expected<std::unique_ptr<Binary>> ChildOrErr = C.getAsBinary(&Context);
-        if (!ChildOrErr) {
-          if (auto E = isNotObjectErrorInvalidFileType(ChildOrErr.takeError()))
-            error(std::move(E), Filename, C);
-          continue;
-        }
-        if (SymbolicFile *O = dyn_cast<SymbolicFile>(&*ChildOrErr.get())) {
-          if (!MachOPrintSizeWarning && PrintSize &&  isa<MachOObjectFile>(O)) {
-            errs() << ToolName << ": warning sizes with -print-size for Mach-O "
-                      "files are always zero.\n";
-            MachOPrintSizeWarning = true;
-          }
-          if (!checkMachOAndArchFlags(O, Filename))
-            return;
-          if (!PrintFileName) {
-            outs() << "\n";
-            if (isa<MachOObjectFile>(O)) {
-              outs() << Filename << "(" << O->getFileName() << ")";
-            } else
-              outs() << O->getFileName();
-            outs() << ":\n";
-          }
-          dumpSymbolNamesFromObject(*O, false, Filename);
-        }
-      }
+      for (auto &C : A->children(Err))
+        if (!dumpArchiveMember(C, Filename, Context, outs()))
+          return;
       if (Err)
         error(std::move(Err), A->getFileName());
     }
@@ -2003,11 +2063,10 @@ static void dumpSymbolNamesFromFile(std::string &Filename) {
     return;
   }
   if (SymbolicFile *O = dyn_cast<SymbolicFile>(&Bin)) {
-    if (!MachOPrintSizeWarning && PrintSize &&  isa<MachOObjectFile>(O)) {
+    if (PrintSize && isa<MachOObjectFile>(O) &&
+        !MachOPrintSizeWarning.exchange(true))
       errs() << ToolName << ": warning sizes with -print-size for Mach-O files "
                 "are always zero.\n";
-      MachOPrintSizeWarning = true;
-    }
     if (!checkMachOAndArchFlags(O, Filename))
       return;
     dumpSymbolNamesFromObject(*O, true);
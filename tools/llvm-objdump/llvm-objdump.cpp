@@ -24,6 +24,7 @@
 #include "llvm/ADT/Triple.h"
 #include "llvm/CodeGen/FaultMaps.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
+#include "llvm/DebugInfo/DWARF/DWARFDebugLine.h"
 #include "llvm/DebugInfo/Symbolize/Symbolize.h"
 #include "llvm/MC/MCAsmInfo.h"
 #include "llvm/MC/MCContext.h"
@@ -56,10 +57,13 @@
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cctype>
 #include <cstring>
+#include <mutex>
 #include <system_error>
 #include <unordered_map>
 #include <utility>
@@ -232,6 +236,18 @@ cl::opt<unsigned long long>
 cl::opt<unsigned long long>
     StopAddress("stop-address", cl::desc("Stop disassembly at address"),
                 cl::value_desc("address"), cl::init(UINT64_MAX));
+
+static cl::opt<unsigned> DisassemblyThreads(
+    "disassembly-threads",
+    cl::desc("Number of threads to disassemble with, 0 for one per hardware "
+             "thread. The output is the same as with a single thread"),
+    cl::init(1));
+
+static cl::opt<unsigned long long> DisassemblyRangeSize(
+    "disassembly-range-size",
+    cl::desc("Number of bytes of symbols each thread disassembles at once"),
+    cl::init(64 * 1024), cl::Hidden);
+
 static StringRef ToolName;
 
 typedef std::vector<std::tuple<uint64_t, StringRef, uint8_t>> SectionSymbolsTy;
@@ -851,33 +867,119 @@ static bool getHidden(RelocationRef RelRef) {
 }
 
 namespace {
-class SourcePrinter {
-protected:
-  DILineInfo OldLineInfo;
-  const ObjectFile *Obj = nullptr;
+/// The address ranges of the line table sequences of an object, sorted, so
+/// that the line of an instruction is found with a binary search rather than
+/// with a symbolizer query.
+class LineTableIndex {
+  struct Range {
+    uint64_t LowPC;
+    uint64_t HighPC;
+    const DWARFDebugLine::LineTable *LineTable;
+    const char *CompDir;
+  };
+  std::unique_ptr<DWARFContext> DICtx;
+  std::vector<Range> Ranges;
+
+public:
+  /// Returns null if the object has no line tables or if their ranges
+  /// overlap, as in relocatable objects.
+  static std::unique_ptr<LineTableIndex> create(const ObjectFile &Obj);
+  bool lookup(uint64_t Address, DILineInfo &Result) const;
+};
+
+std::unique_ptr<LineTableIndex> LineTableIndex::create(const ObjectFile &Obj) {
+  if (Obj.isRelocatableObject())
+    return nullptr;
+  auto Index = llvm::make_unique<LineTableIndex>();
+  Index->DICtx = DWARFContext::create(Obj);
+  for (const auto &CU : Index->DICtx->compile_units()) {
+    const DWARFDebugLine::LineTable *LineTable =
+        Index->DICtx->getLineTableForUnit(CU.get());
+    if (!LineTable)
+      continue;
+    for (const DWARFDebugLine::Sequence &Seq : LineTable->Sequences)
+      if (Seq.LowPC < Seq.HighPC)
+        Index->Ranges.push_back(
+            {Seq.LowPC, Seq.HighPC, LineTable, CU->getCompilationDir()});
+  }
+  // The debug info may be in another file, let the symbolizer find it.
+  if (Index->Ranges.empty())
+    return nullptr;
+  llvm::sort(Index->Ranges.begin(), Index->Ranges.end(),
+             [](const Range &LHS, const Range &RHS) {
+               return LHS.LowPC < RHS.LowPC;
+             });
+  for (size_t I = 1, E = Index->Ranges.size(); I != E; ++I)
+    if (Index->Ranges[I].LowPC < Index->Ranges[I - 1].HighPC)
+      return nullptr;
+  return Index;
+}
+
+bool LineTableIndex::lookup(uint64_t Address, DILineInfo &Result) const {
+  auto R = std::upper_bound(Ranges.begin(), Ranges.end(), Address,
+                            [](uint64_t LHS, const Range &RHS) {
+                              return LHS < RHS.LowPC;
+                            });
+  if (R == Ranges.begin())
+    return false;
+  --R;
+  if (Address >= R->HighPC)
+    return false;
+  return R->LineTable->getFileLineInfoForAddress(
+      Address, R->CompDir,
+      DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath, Result);
+}
+
+/// What the SourcePrinters of an object share: the line information and the
+/// source files read so far. It can be used from several threads.
+class SourceInfo {
+  const ObjectFile *Obj;
   std::unique_ptr<symbolize::LLVMSymbolizer> Symbolizer;
+  std::unique_ptr<LineTableIndex> Lines;
   // File name to file contents of source
   std::unordered_map<std::string, std::unique_ptr<MemoryBuffer>> SourceCache;
   // Mark the line endings of the cached source
   std::unordered_map<std::string, std::vector<StringRef>> LineCache;
+  std::mutex Mutex;
 
-private:
   bool cacheSource(const DILineInfo& LineInfoFile);
 
 public:
-  SourcePrinter() = default;
-  SourcePrinter(const ObjectFile *Obj, StringRef DefaultArch) : Obj(Obj) {
+  SourceInfo(const ObjectFile *Obj, StringRef DefaultArch) : Obj(Obj) {
     symbolize::LLVMSymbolizer::Options SymbolizerOpts(
         DILineInfoSpecifier::FunctionNameKind::None, true, false, false,
         DefaultArch);
     Symbolizer.reset(new symbolize::LLVMSymbolizer(SymbolizerOpts));
+    if (PrintSource || PrintLines)
+      Lines = LineTableIndex::create(*Obj);
   }
+  DILineInfo getLineInfo(uint64_t Address);
+  /// Returns false if the source file cannot be read. Otherwise, \p Lines is
+  /// null or points to its lines.
+  bool getSourceLines(const DILineInfo &LineInfo,
+                      const std::vector<StringRef> *&Lines);
+};
+
+class SourcePrinter {
+protected:
+  DILineInfo OldLineInfo;
+  SourceInfo *Info = nullptr;
+  // The first line printed, or that would have been printed if it weren't
+  // the same as OldLineInfo.
+  uint32_t FirstLine = 0;
+
+public:
+  SourcePrinter() = default;
+  SourcePrinter(SourceInfo &Info, DILineInfo OldLineInfo = DILineInfo())
+      : OldLineInfo(OldLineInfo), Info(&Info) {}
   virtual ~SourcePrinter() = default;
   virtual void printSourceLine(raw_ostream &OS, uint64_t Address,
                                StringRef Delimiter = "; ");
+  const DILineInfo &getOldLineInfo() const { return OldLineInfo; }
+  uint32_t getFirstLine() const { return FirstLine; }
 };
 
-bool SourcePrinter::cacheSource(const DILineInfo &LineInfo) {
+bool SourceInfo::cacheSource(const DILineInfo &LineInfo) {
   std::unique_ptr<MemoryBuffer> Buffer;
   if (LineInfo.Source) {
     Buffer = MemoryBuffer::getMemBuffer(*LineInfo.Source);
@@ -903,38 +1005,58 @@ bool SourcePrinter::cacheSource(const DILineInfo &LineInfo) {
   return true;
 }
 
-void SourcePrinter::printSourceLine(raw_ostream &OS, uint64_t Address,
-                                    StringRef Delimiter) {
-  if (!Symbolizer)
-    return;
+DILineInfo SourceInfo::getLineInfo(uint64_t Address) {
   DILineInfo LineInfo = DILineInfo();
+  if (Lines) {
+    Lines->lookup(Address, LineInfo);
+    return LineInfo;
+  }
+  std::lock_guard<std::mutex> Lock(Mutex);
   auto ExpectecLineInfo =
       Symbolizer->symbolizeCode(Obj->getFileName(), Address);
   if (!ExpectecLineInfo)
     consumeError(ExpectecLineInfo.takeError());
   else
     LineInfo = *ExpectecLineInfo;
+  return LineInfo;
+}
+
+bool SourceInfo::getSourceLines(const DILineInfo &LineInfo,
+                                const std::vector<StringRef> *&Lines) {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  if (SourceCache.find(LineInfo.FileName) == SourceCache.end())
+    if (!cacheSource(LineInfo))
+      return false;
+  // The map never removes its elements, so the lines stay where they are.
+  auto LineBuffer = LineCache.find(LineInfo.FileName);
+  Lines = LineBuffer != LineCache.end() ? &LineBuffer->second : nullptr;
+  return true;
+}
 
-  if ((LineInfo.FileName == "<invalid>") || OldLineInfo.Line == LineInfo.Line ||
-      LineInfo.Line == 0)
+void SourcePrinter::printSourceLine(raw_ostream &OS, uint64_t Address,
+                                    StringRef Delimiter) {
+  if (!Info)
+    return;
+  DILineInfo LineInfo = Info->getLineInfo(Address);
+
+  if ((LineInfo.FileName == "<invalid>") || LineInfo.Line == 0)
+    return;
+  if (!FirstLine)
+    FirstLine = LineInfo.Line;
+  if (OldLineInfo.Line == LineInfo.Line)
     return;
 
   if (PrintLines)
     OS << Delimiter << LineInfo.FileName << ":" << LineInfo.Line << "\n";
   if (PrintSource) {
-    if (SourceCache.find(LineInfo.FileName) == SourceCache.end())
-      if (!cacheSource(LineInfo))
+    const std::vector<StringRef> *Lines;
+    if (!Info->getSourceLines(LineInfo, Lines))
+      return;
+    if (Lines) {
+      if (LineInfo.Line > Lines->size())
         return;
-    auto FileBuffer = SourceCache.find(LineInfo.FileName);
-    if (FileBuffer != SourceCache.end()) {
-      auto LineBuffer = LineCache.find(LineInfo.FileName);
-      if (LineBuffer != LineCache.end()) {
-        if (LineInfo.Line > LineBuffer->second.size())
-          return;
-        // Vector begins at 0, line numbers are non-zero
-        OS << Delimiter << LineBuffer->second[LineInfo.Line - 1].ltrim()
-           << "\n";
-      }
+      // Vector begins at 0, line numbers are non-zero
+      OS << Delimiter << (*Lines)[LineInfo.Line - 1].ltrim() << "\n";
     }
   }
   OldLineInfo = LineInfo;
@@ -956,7 +1078,7 @@ public:
                          ArrayRef<uint8_t> Bytes, uint64_t Address,
                          raw_ostream &OS, StringRef Annot,
                          MCSubtargetInfo const &STI, SourcePrinter *SP,
-                         std::vector<RelocationRef> *Rels = nullptr) {
+                         const std::vector<RelocationRef> *Rels = nullptr) {
     if (SP && (PrintSource || PrintLines))
       SP->printSourceLine(OS, Address);
     if (!NoLeadingAddr)
@@ -989,7 +1111,7 @@ public:
   void printInst(MCInstPrinter &IP, const MCInst *MI, ArrayRef<uint8_t> Bytes,
                  uint64_t Address, raw_ostream &OS, StringRef Annot,
                  MCSubtargetInfo const &STI, SourcePrinter *SP,
-                 std::vector<RelocationRef> *Rels) override {
+                 const std::vector<RelocationRef> *Rels) override {
     if (SP && (PrintSource || PrintLines))
       SP->printSourceLine(OS, Address, "");
     if (!MI) {
@@ -1064,7 +1186,7 @@ public:
   void printInst(MCInstPrinter &IP, const MCInst *MI, ArrayRef<uint8_t> Bytes,
                  uint64_t Address, raw_ostream &OS, StringRef Annot,
                  MCSubtargetInfo const &STI, SourcePrinter *SP,
-                 std::vector<RelocationRef> *Rels) override {
+                 const std::vector<RelocationRef> *Rels) override {
     if (SP && (PrintSource || PrintLines))
       SP->printSourceLine(OS, Address);
 
@@ -1116,7 +1238,7 @@ public:
   void printInst(MCInstPrinter &IP, const MCInst *MI, ArrayRef<uint8_t> Bytes,
                  uint64_t Address, raw_ostream &OS, StringRef Annot,
                  MCSubtargetInfo const &STI, SourcePrinter *SP,
-                 std::vector<RelocationRef> *Rels) override {
+                 const std::vector<RelocationRef> *Rels) override {
     if (SP && (PrintSource || PrintLines))
       SP->printSourceLine(OS, Address);
     if (!NoLeadingAddr)
@@ -1207,6 +1329,399 @@ addDynamicElfSymbols(const ObjectFile *Obj,
     llvm_unreachable("Unsupported binary format");
 }
 
+namespace {
+/// The MC objects that disassemble and print the instructions. They have
+/// state, so each thread has its own.
+struct DisassemblerInstance {
+  std::unique_ptr<const MCSubtargetInfo> STI;
+  std::unique_ptr<MCObjectFileInfo> MOFI;
+  std::unique_ptr<MCContext> Ctx;
+  std::unique_ptr<MCDisassembler> DisAsm;
+  std::unique_ptr<MCInstPrinter> IP;
+};
+
+/// What the threads disassembling a section share.
+struct SectionDisassembly {
+  const ObjectFile *Obj;
+  const Target *TheTarget;
+  SectionRef Section;
+  uint64_t SectionAddr;
+  uint64_t SectSize;
+  SectionSymbolsTy *Symbols;
+  std::vector<uint64_t> DataMappingSymsAddr;
+  std::vector<uint64_t> TextMappingSymsAddr;
+  std::vector<RelocationRef> Rels;
+  ArrayRef<uint8_t> Bytes;
+  std::string Header;
+  const std::vector<std::pair<uint64_t, SectionRef>> *SectionAddresses;
+  const std::map<SectionRef, SectionSymbolsTy> *AllSymbols;
+  const SectionSymbolsTy *AbsoluteSymbols;
+  const MCInstrAnalysis *MIA;
+  PrettyPrinter *PIP;
+  StringRef Fmt;
+};
+
+/// The output of a range of symbols disassembled on a thread pool, and the
+/// state of the disassembly after it.
+struct SymbolRangeDisassembly {
+  std::string Output;
+  bool PrintedSection = false;
+  size_t RelIndex = 0;
+  DILineInfo OldLineInfo;
+  uint32_t FirstLine = 0;
+};
+} // end anonymous namespace
+
+static void setSectionSymbolizer(const SectionDisassembly &SD,
+                                 DisassemblerInstance &D) {
+  if (!SD.Obj->isELF() || SD.Obj->getArch() != Triple::amdgcn)
+    return;
+  // AMDGPU disassembler uses symbolizer for printing labels
+  std::unique_ptr<MCRelocationInfo> RelInfo(
+    SD.TheTarget->createMCRelocationInfo(TripleName, *D.Ctx));
+  if (RelInfo) {
+    std::unique_ptr<MCSymbolizer> Symbolizer(
+      SD.TheTarget->createMCSymbolizer(
+        TripleName, nullptr, nullptr, SD.Symbols, D.Ctx.get(),
+        std::move(RelInfo)));
+    D.DisAsm->setSymbolizer(std::move(Symbolizer));
+  }
+}
+
+// Returns the first relocation from RelIndex that the disassembly prints.
+static size_t skipHiddenRelocations(const SectionDisassembly &SD,
+                                    size_t RelIndex) {
+  while (RelIndex != SD.Rels.size() &&
+         (getHidden(SD.Rels[RelIndex]) ||
+          SD.SectionAddr + SD.Rels[RelIndex].getOffset() < StartAddress))
+    ++RelIndex;
+  return RelIndex;
+}
+
+// Disassembles the symbols [FirstSymbol, LastSymbol) of a section to OS.
+// RelIndex is the first relocation not printed yet, and is updated.
+static void disassembleSymbols(const SectionDisassembly &SD,
+                               DisassemblerInstance &D, SourcePrinter &SP,
+                               unsigned FirstSymbol, unsigned LastSymbol,
+                               size_t &RelIndex, bool &PrintedSection,
+                               raw_ostream &OS) {
+  const ObjectFile *Obj = SD.Obj;
+  const SectionRef &Section = SD.Section;
+  const uint64_t SectionAddr = SD.SectionAddr;
+  const uint64_t SectSize = SD.SectSize;
+  const SectionSymbolsTy &Symbols = *SD.Symbols;
+  const std::vector<uint64_t> &DataMappingSymsAddr = SD.DataMappingSymsAddr;
+  const std::vector<uint64_t> &TextMappingSymsAddr = SD.TextMappingSymsAddr;
+  const std::vector<RelocationRef> &Rels = SD.Rels;
+  const ArrayRef<uint8_t> Bytes = SD.Bytes;
+  const auto &SectionAddresses = *SD.SectionAddresses;
+  const auto &AllSymbols = *SD.AllSymbols;
+  const SectionSymbolsTy &AbsoluteSymbols = *SD.AbsoluteSymbols;
+  const SectionSymbolsTy EmptySymbols;
+  const MCInstrAnalysis *MIA = SD.MIA;
+  const StringRef Fmt = SD.Fmt;
+
+  SmallString<40> Comments;
+  raw_svector_ostream CommentStream(Comments);
+
+  uint64_t Size;
+  uint64_t Index;
+
+  std::vector<RelocationRef>::const_iterator rel_cur = Rels.begin() + RelIndex;
+  std::vector<RelocationRef>::const_iterator rel_end = Rels.end();
+  // Disassemble symbol by symbol.
+  for (unsigned si = FirstSymbol, se = Symbols.size(); si != LastSymbol;
+       ++si) {
+    uint64_t Start = std::get<0>(Symbols[si]) - SectionAddr;
+    // The end is either the section end or the beginning of the next
+    // symbol.
+    uint64_t End =
+        (si == se - 1) ? SectSize : std::get<0>(Symbols[si + 1]) - SectionAddr;
+    // Don't try to disassemble beyond the end of section contents.
+    if (End > SectSize)
+      End = SectSize;
+    // If this symbol has the same address as the next symbol, then skip it.
+    if (Start >= End)
+      continue;
+
+    // Check if we need to skip symbol
+    // Skip if the symbol's data is not between StartAddress and StopAddress
+    if (End + SectionAddr < StartAddress ||
+        Start + SectionAddr > StopAddress) {
+      continue;
+    }
+
+    /// Skip if user requested specific symbols and this is not in the list
+    if (!DisasmFuncsSet.empty() &&
+        !DisasmFuncsSet.count(std::get<1>(Symbols[si])))
+      continue;
+
+    if (!PrintedSection) {
+      PrintedSection = true;
+      OS << SD.Header;
+    }
+
+    // Stop disassembly at the stop address specified
+    if (End + SectionAddr > StopAddress)
+      End = StopAddress - SectionAddr;
+
+    if (Obj->isELF() && Obj->getArch() == Triple::amdgcn) {
+      if (std::get<2>(Symbols[si]) == ELF::STT_AMDGPU_HSA_KERNEL) {
+        // skip amd_kernel_code_t at the begining of kernel symbol (256 bytes)
+        Start += 256;
+      }
+      if (si == se - 1 ||
+          std::get<2>(Symbols[si + 1]) == ELF::STT_AMDGPU_HSA_KERNEL) {
+        // cut trailing zeroes at the end of kernel
+        // cut up to 256 bytes
+        const uint64_t EndAlign = 256;
+        const auto Limit = End - (std::min)(EndAlign, End - Start);
+        while (End > Limit &&
+          *reinterpret_cast<const support::ulittle32_t*>(&Bytes[End - 4]) == 0)
+          End -= 4;
+      }
+    }
+
+    OS << '\n' << std::get<1>(Symbols[si]) << ":\n";
+
+    // Don't print raw contents of a virtual section. A virtual section
+    // doesn't have any contents in the file.
+    if (Section.isVirtual()) {
+      OS << "...\n";
+      continue;
+    }
+
+#ifndef NDEBUG
+    raw_ostream &DebugOut = DebugFlag ? dbgs() : nulls();
+#else
+    raw_ostream &DebugOut = nulls();
+#endif
+
+    for (Index = Start; Index < End; Index += Size) {
+      MCInst Inst;
+
+      if (Index + SectionAddr < StartAddress ||
+          Index + SectionAddr > StopAddress) {
+        // skip byte by byte till StartAddress is reached
+        Size = 1;
+        continue;
+      }
+      // AArch64 ELF binaries can interleave data and text in the
+      // same section. We rely on the markers introduced to
+      // understand what we need to dump. If the data marker is within a
+      // function, it is denoted as a word/short etc
+      if (isArmElf(Obj) && std::get<2>(Symbols[si]) != ELF::STT_OBJECT &&
+          !DisassembleAll) {
+        uint64_t Stride = 0;
+
+        auto DAI = std::lower_bound(DataMappingSymsAddr.begin(),
+                                    DataMappingSymsAddr.end(), Index);
+        if (DAI != DataMappingSymsAddr.end() && *DAI == Index) {
+          // Switch to data.
+          while (Index < End) {
+            OS << format("%8" PRIx64 ":", SectionAddr + Index);
+            OS << "\t";
+            if (Index + 4 <= End) {
+              Stride = 4;
+              dumpBytes(Bytes.slice(Index, 4), OS);
+              OS << "\t.word\t";
+              uint32_t Data = 0;
+              if (Obj->isLittleEndian()) {
+                const auto Word =
+                    reinterpret_cast<const support::ulittle32_t *>(
+                        Bytes.data() + Index);
+                Data = *Word;
+              } else {
+                const auto Word = reinterpret_cast<const support::ubig32_t *>(
+                    Bytes.data() + Index);
+                Data = *Word;
+              }
+              OS << "0x" << format("%08" PRIx32, Data);
+            } else if (Index + 2 <= End) {
+              Stride = 2;
+              dumpBytes(Bytes.slice(Index, 2), OS);
+              OS << "\t\t.short\t";
+              uint16_t Data = 0;
+              if (Obj->isLittleEndian()) {
+                const auto Short =
+                    reinterpret_cast<const support::ulittle16_t *>(
+                        Bytes.data() + Index);
+                Data = *Short;
+              } else {
+                const auto Short =
+                    reinterpret_cast<const support::ubig16_t *>(Bytes.data() +
+                                                                Index);
+                Data = *Short;
+              }
+              OS << "0x" << format("%04" PRIx16, Data);
+            } else {
+              Stride = 1;
+              dumpBytes(Bytes.slice(Index, 1), OS);
+              OS << "\t\t.byte\t";
+              OS << "0x" << format("%02" PRIx8, Bytes.slice(Index, 1)[0]);
+            }
+            Index += Stride;
+            OS << "\n";
+            auto TAI = std::lower_bound(TextMappingSymsAddr.begin(),
+                                        TextMappingSymsAddr.end(), Index);
+            if (TAI != TextMappingSymsAddr.end() && *TAI == Index)
+              break;
+          }
+        }
+      }
+
+      // If there is a data symbol inside an ELF text section and we are only
+      // disassembling text (applicable all architectures),
+      // we are in a situation where we must print the data and not
+      // disassemble it.
+      if (Obj->isELF() && std::get<2>(Symbols[si]) == ELF::STT_OBJECT &&
+          !DisassembleAll && Section.isText()) {
+        // print out data up to 8 bytes at a time in hex and ascii
+        uint8_t AsciiData[9] = {'\0'};
+        uint8_t Byte;
+        int NumBytes = 0;
+
+        for (Index = Start; Index < End; Index += 1) {
+          if (((SectionAddr + Index) < StartAddress) ||
+              ((SectionAddr + Index) > StopAddress))
+            continue;
+          if (NumBytes == 0) {
+            OS << format("%8" PRIx64 ":", SectionAddr + Index);
+            OS << "\t";
+          }
+          Byte = Bytes.slice(Index)[0];
+          OS << format(" %02x", Byte);
+          AsciiData[NumBytes] = isprint(Byte) ? Byte : '.';
+
+          uint8_t IndentOffset = 0;
+          NumBytes++;
+          if (Index == End - 1 || NumBytes > 8) {
+            // Indent the space for less than 8 bytes data.
+            // 2 spaces for byte and one for space between bytes
+            IndentOffset = 3 * (8 - NumBytes);
+            for (int Excess = 8 - NumBytes; Excess < 8; Excess++)
+              AsciiData[Excess] = '\0';
+            NumBytes = 8;
+          }
+          if (NumBytes == 8) {
+            AsciiData[8] = '\0';
+            OS << std::string(IndentOffset, ' ') << "         ";
+            OS << reinterpret_cast<char *>(AsciiData);
+            OS << '\n';
+            NumBytes = 0;
+          }
+        }
+      }
+      if (Index >= End)
+        break;
+
+      // Disassemble a real instruction or a data when disassemble all is
+      // provided
+      bool Disassembled = D.DisAsm->getInstruction(
+          Inst, Size, Bytes.slice(Index), SectionAddr + Index, DebugOut,
+          CommentStream);
+      if (Size == 0)
+        Size = 1;
+
+      SD.PIP->printInst(*D.IP, Disassembled ? &Inst : nullptr,
+                        Bytes.slice(Index, Size), SectionAddr + Index, OS, "",
+                        *D.STI, &SP, &Rels);
+      OS << CommentStream.str();
+      Comments.clear();
+
+      // Try to resolve the target of a call, tail call, etc. to a specific
+      // symbol.
+      if (MIA && (MIA->isCall(Inst) || MIA->isUnconditionalBranch(Inst) ||
+                  MIA->isConditionalBranch(Inst))) {
+        uint64_t Target;
+        if (MIA->evaluateBranch(Inst, SectionAddr + Index, Size, Target)) {
+          // In a relocatable object, the target's section must reside in
+          // the same section as the call instruction or it is accessed
+          // through a relocation.
+          //
+          // In a non-relocatable object, the target may be in any section.
+          //
+          // N.B. We don't walk the relocations in the relocatable case yet.
+          const SectionSymbolsTy *TargetSectionSymbols = &Symbols;
+          if (!Obj->isRelocatableObject()) {
+            auto SectionAddress = std::upper_bound(
+                SectionAddresses.begin(), SectionAddresses.end(), Target,
+                [](uint64_t LHS,
+                    const std::pair<uint64_t, SectionRef> &RHS) {
+                  return LHS < RHS.first;
+                });
+            if (SectionAddress != SectionAddresses.begin()) {
+              --SectionAddress;
+              auto SecSyms = AllSymbols.find(SectionAddress->second);
+              TargetSectionSymbols = SecSyms != AllSymbols.end()
+                                         ? &SecSyms->second
+                                         : &EmptySymbols;
+            } else {
+              TargetSectionSymbols = &AbsoluteSymbols;
+            }
+          }
+
+          // Find the first symbol in the section whose offset is less than
+          // or equal to the target. If there isn't a section that contains
+          // the target, find the nearest preceding absolute symbol.
+          auto TargetSym = std::upper_bound(
+              TargetSectionSymbols->begin(), TargetSectionSymbols->end(),
+              Target, [](uint64_t LHS,
+                         const std::tuple<uint64_t, StringRef, uint8_t> &RHS) {
+                return LHS < std::get<0>(RHS);
+              });
+          if (TargetSym == TargetSectionSymbols->begin()) {
+            TargetSectionSymbols = &AbsoluteSymbols;
+            TargetSym = std::upper_bound(
+                AbsoluteSymbols.begin(), AbsoluteSymbols.end(),
+                Target, [](uint64_t LHS,
+                           const std::tuple<uint64_t, StringRef, uint8_t> &RHS) {
+                          return LHS < std::get<0>(RHS);
+                        });
+          }
+          if (TargetSym != TargetSectionSymbols->begin()) {
+            --TargetSym;
+            uint64_t TargetAddress = std::get<0>(*TargetSym);
+            StringRef TargetName = std::get<1>(*TargetSym);
+            OS << " <" << TargetName;
+            uint64_t Disp = Target - TargetAddress;
+            if (Disp)
+              OS << "+0x" << Twine::utohexstr(Disp);
+            OS << '>';
+          }
+        }
+      }
+      OS << "\n";
+
+      // Hexagon does this in pretty printer
+      if (Obj->getArch() != Triple::hexagon)
+        // Print relocation for instruction.
+        while (rel_cur != rel_end) {
+          bool hidden = getHidden(*rel_cur);
+          uint64_t addr = rel_cur->getOffset();
+          SmallString<16> name;
+          SmallString<32> val;
+
+          // If this relocation is hidden, skip it.
+          if (hidden || ((SectionAddr + addr) < StartAddress)) {
+            ++rel_cur;
+            continue;
+          }
+
+          // Stop when rel_cur's address is past the current instruction.
+          if (addr >= Index + Size) break;
+          rel_cur->getTypeName(name);
+          error(getRelocationValueString(*rel_cur, val));
+          OS << format(Fmt.data(), SectionAddr + addr) << name
+                 << "\t" << val << "\n";
+          ++rel_cur;
+        }
+    }
+  }
+
+  RelIndex = rel_cur - Rels.begin();
+}
+
 static void DisassembleObject(const ObjectFile *Obj, bool InlineRelocs) {
   if (StartAddress > StopAddress)
     error("Start address should be less than stop address");
@@ -1232,42 +1747,66 @@ static void DisassembleObject(const ObjectFile *Obj, bool InlineRelocs) {
   if (!AsmInfo)
     report_error(Obj->getFileName(), "no assembly info for target " +
                  TripleName);
-  std::unique_ptr<const MCSubtargetInfo> STI(
-      TheTarget->createMCSubtargetInfo(TripleName, MCPU, Features.getString()));
-  if (!STI)
-    report_error(Obj->getFileName(), "no subtarget info for target " +
-                 TripleName);
   std::unique_ptr<const MCInstrInfo> MII(TheTarget->createMCInstrInfo());
   if (!MII)
     report_error(Obj->getFileName(), "no instruction info for target " +
                  TripleName);
-  MCObjectFileInfo MOFI;
-  MCContext Ctx(AsmInfo.get(), MRI.get(), &MOFI);
-  // FIXME: for now initialize MCObjectFileInfo with default values
-  MOFI.InitMCObjectFileInfo(Triple(TripleName), false, Ctx);
-
-  std::unique_ptr<MCDisassembler> DisAsm(
-    TheTarget->createMCDisassembler(*STI, Ctx));
-  if (!DisAsm)
-    report_error(Obj->getFileName(), "no disassembler for target " +
-                 TripleName);
+  int AsmPrinterVariant = AsmInfo->getAssemblerDialect();
+
+  auto CreateDisassembler = [&]() {
+    auto D = llvm::make_unique<DisassemblerInstance>();
+    D->STI.reset(TheTarget->createMCSubtargetInfo(TripleName, MCPU,
+                                                  Features.getString()));
+    if (!D->STI)
+      report_error(Obj->getFileName(), "no subtarget info for target " +
+                   TripleName);
+    D->MOFI = llvm::make_unique<MCObjectFileInfo>();
+    D->Ctx =
+        llvm::make_unique<MCContext>(AsmInfo.get(), MRI.get(), D->MOFI.get());
+    // FIXME: for now initialize MCObjectFileInfo with default values
+    D->MOFI->InitMCObjectFileInfo(Triple(TripleName), false, *D->Ctx);
+
+    D->DisAsm.reset(TheTarget->createMCDisassembler(*D->STI, *D->Ctx));
+    if (!D->DisAsm)
+      report_error(Obj->getFileName(), "no disassembler for target " +
+                   TripleName);
+
+    D->IP.reset(TheTarget->createMCInstPrinter(
+        Triple(TripleName), AsmPrinterVariant, *AsmInfo, *MII, *MRI));
+    if (!D->IP)
+      report_error(Obj->getFileName(), "no instruction printer for target " +
+                   TripleName);
+    D->IP->setPrintImmHex(PrintImmHex);
+    return D;
+  };
+  std::unique_ptr<DisassemblerInstance> MainDisassembler = CreateDisassembler();
 
   std::unique_ptr<const MCInstrAnalysis> MIA(
       TheTarget->createMCInstrAnalysis(MII.get()));
 
-  int AsmPrinterVariant = AsmInfo->getAssemblerDialect();
-  std::unique_ptr<MCInstPrinter> IP(TheTarget->createMCInstPrinter(
-      Triple(TripleName), AsmPrinterVariant, *AsmInfo, *MII, *MRI));
-  if (!IP)
-    report_error(Obj->getFileName(), "no instruction printer for target " +
-                 TripleName);
-  IP->setPrintImmHex(PrintImmHex);
   PrettyPrinter &PIP = selectPrettyPrinter(Triple(TripleName));
 
   StringRef Fmt = Obj->getBytesInAddress() > 4 ? "\t\t%016" PRIx64 ":  " :
                                                  "\t\t\t%08" PRIx64 ":  ";
 
-  SourcePrinter SP(Obj, TheTarget->getName());
+  SourceInfo SI(Obj, TheTarget->getName());
+  // The last source line printed, as the next one is only printed if it is
+  // different.
+  DILineInfo OldLineInfo;
+
+  // With several threads, the symbols of a section are split into ranges of
+  // about DisassemblyRangeSize bytes, disassembled in parallel into buffers
+  // which are printed in order.
+  unsigned NumThreads =
+      DisassemblyThreads ? DisassemblyThreads : hardware_concurrency();
+  std::unique_ptr<ThreadPool> Pool;
+  std::vector<std::unique_ptr<DisassemblerInstance>> FreeDisassemblers;
+  std::mutex FreeDisassemblersMutex;
+  if (NumThreads > 1) {
+    Pool = llvm::make_unique<ThreadPool>(NumThreads);
+    for (unsigned I = 0; I != NumThreads; ++I)
+      FreeDisassemblers.push_back(CreateDisassembler());
+  }
 
   // Create a mapping, RelocSecs = SectionRelocMap[S], where sections
   // in RelocSecs contain the relocations for section S.
@@ -1364,52 +1903,51 @@ static void DisassembleObject(const ObjectFile *Obj, bool InlineRelocs) {
     if (!SectSize)
       continue;
 
+    SectionDisassembly SD;
+    SD.Obj = Obj;
+    SD.TheTarget = TheTarget;
+    SD.Section = Section;
+    SD.SectionAddr = SectionAddr;
+    SD.SectSize = SectSize;
+    SD.SectionAddresses = &SectionAddresses;
+    SD.AllSymbols = &AllSymbols;
+    SD.AbsoluteSymbols = &AbsoluteSymbols;
+    SD.MIA = MIA.get();
+    SD.PIP = &PIP;
+    SD.Fmt = Fmt;
+
     // Get the list of all the symbols in this section.
     SectionSymbolsTy &Symbols = AllSymbols[Section];
-    std::vector<uint64_t> DataMappingSymsAddr;
-    std::vector<uint64_t> TextMappingSymsAddr;
+    SD.Symbols = &Symbols;
     if (isArmElf(Obj)) {
       for (const auto &Symb : Symbols) {
         uint64_t Address = std::get<0>(Symb);
         StringRef Name = std::get<1>(Symb);
         if (Name.startswith("$d"))
-          DataMappingSymsAddr.push_back(Address - SectionAddr);
+          SD.DataMappingSymsAddr.push_back(Address - SectionAddr);
         if (Name.startswith("$x"))
-          TextMappingSymsAddr.push_back(Address - SectionAddr);
+          SD.TextMappingSymsAddr.push_back(Address - SectionAddr);
         if (Name.startswith("$a"))
-          TextMappingSymsAddr.push_back(Address - SectionAddr);
+          SD.TextMappingSymsAddr.push_back(Address - SectionAddr);
         if (Name.startswith("$t"))
-          TextMappingSymsAddr.push_back(Address - SectionAddr);
+          SD.TextMappingSymsAddr.push_back(Address - SectionAddr);
       }
     }
 
-    llvm::sort(DataMappingSymsAddr.begin(), DataMappingSymsAddr.end());
-    llvm::sort(TextMappingSymsAddr.begin(), TextMappingSymsAddr.end());
-
-    if (Obj->isELF() && Obj->getArch() == Triple::amdgcn) {
-      // AMDGPU disassembler uses symbolizer for printing labels
-      std::unique_ptr<MCRelocationInfo> RelInfo(
-        TheTarget->createMCRelocationInfo(TripleName, Ctx));
-      if (RelInfo) {
-        std::unique_ptr<MCSymbolizer> Symbolizer(
-          TheTarget->createMCSymbolizer(
-            TripleName, nullptr, nullptr, &Symbols, &Ctx, std::move(RelInfo)));
-        DisAsm->setSymbolizer(std::move(Symbolizer));
-      }
-    }
+    llvm::sort(SD.DataMappingSymsAddr.begin(), SD.DataMappingSymsAddr.end());
+    llvm::sort(SD.TextMappingSymsAddr.begin(), SD.TextMappingSymsAddr.end());
 
     // Make a list of all the relocations for this section.
-    std::vector<RelocationRef> Rels;
     if (InlineRelocs) {
       for (const SectionRef &RelocSec : SectionRelocMap[Section]) {
         for (const RelocationRef &Reloc : RelocSec.relocations()) {
-          Rels.push_back(Reloc);
+          SD.Rels.push_back(Reloc);
         }
       }
     }
 
     // Sort relocations by address.
-    llvm::sort(Rels.begin(), Rels.end(), RelocAddressLess);
+    llvm::sort(SD.Rels.begin(), SD.Rels.end(), RelocAddressLess);
 
     StringRef SegmentName = "";
     if (const MachOObjectFile *MachO = dyn_cast<const MachOObjectFile>(Obj)) {
@@ -1418,6 +1956,10 @@ static void DisassembleObject(const ObjectFile *Obj, bool InlineRelocs) {
     }
     StringRef SectionName;
     error(Section.getName(SectionName));
+    SD.Header = "Disassembly of section ";
+    if (!SegmentName.empty())
+      SD.Header += (SegmentName + ",").str();
+    SD.Header += (SectionName + ":").str();
 
     // If the section has no symbol at the start, just insert a dummy one.
     if (Symbols.empty() || std::get<0>(Symbols[0]) != 0) {
@@ -1427,306 +1969,109 @@ static void DisassembleObject(const ObjectFile *Obj, bool InlineRelocs) {
                           Section.isText() ? ELF::STT_FUNC : ELF::STT_OBJECT));
     }
 
-    SmallString<40> Comments;
-    raw_svector_ostream CommentStream(Comments);
-
     StringRef BytesStr;
     error(Section.getContents(BytesStr));
-    ArrayRef<uint8_t> Bytes(reinterpret_cast<const uint8_t *>(BytesStr.data()),
-                            BytesStr.size());
+    SD.Bytes = ArrayRef<uint8_t>(
+        reinterpret_cast<const uint8_t *>(BytesStr.data()), BytesStr.size());
 
-    uint64_t Size;
-    uint64_t Index;
+    size_t RelIndex = 0;
     bool PrintedSection = false;
 
-    std::vector<RelocationRef>::const_iterator rel_cur = Rels.begin();
-    std::vector<RelocationRef>::const_iterator rel_end = Rels.end();
-    // Disassemble symbol by symbol.
+    if (!Pool) {
+      setSectionSymbolizer(SD, *MainDisassembler);
+      SourcePrinter SP(SI, OldLineInfo);
+      disassembleSymbols(SD, *MainDisassembler, SP, 0, Symbols.size(),
+                         RelIndex, PrintedSection, outs());
+      OldLineInfo = SP.getOldLineInfo();
+      continue;
+    }
+
+    // Split the symbols into ranges.
+    std::vector<unsigned> RangeStarts;
+    uint64_t RangeStartAddr = 0;
     for (unsigned si = 0, se = Symbols.size(); si != se; ++si) {
       uint64_t Start = std::get<0>(Symbols[si]) - SectionAddr;
-      // The end is either the section end or the beginning of the next
-      // symbol.
-      uint64_t End =
-          (si == se - 1) ? SectSize : std::get<0>(Symbols[si + 1]) - SectionAddr;
-      // Don't try to disassemble beyond the end of section contents.
-      if (End > SectSize)
-        End = SectSize;
-      // If this symbol has the same address as the next symbol, then skip it.
-      if (Start >= End)
-        continue;
-
-      // Check if we need to skip symbol
-      // Skip if the symbol's data is not between StartAddress and StopAddress
-      if (End + SectionAddr < StartAddress ||
-          Start + SectionAddr > StopAddress) {
-        continue;
-      }
-
-      /// Skip if user requested specific symbols and this is not in the list
-      if (!DisasmFuncsSet.empty() &&
-          !DisasmFuncsSet.count(std::get<1>(Symbols[si])))
-        continue;
-
-      if (!PrintedSection) {
-        PrintedSection = true;
-        outs() << "Disassembly of section ";
-        if (!SegmentName.empty())
-          outs() << SegmentName << ",";
-        outs() << SectionName << ':';
-      }
-
-      // Stop disassembly at the stop address specified
-      if (End + SectionAddr > StopAddress)
-        End = StopAddress - SectionAddr;
-
-      if (Obj->isELF() && Obj->getArch() == Triple::amdgcn) {
-        if (std::get<2>(Symbols[si]) == ELF::STT_AMDGPU_HSA_KERNEL) {
-          // skip amd_kernel_code_t at the begining of kernel symbol (256 bytes)
-          Start += 256;
-        }
-        if (si == se - 1 ||
-            std::get<2>(Symbols[si + 1]) == ELF::STT_AMDGPU_HSA_KERNEL) {
-          // cut trailing zeroes at the end of kernel
-          // cut up to 256 bytes
-          const uint64_t EndAlign = 256;
-          const auto Limit = End - (std::min)(EndAlign, End - Start);
-          while (End > Limit &&
-            *reinterpret_cast<const support::ulittle32_t*>(&Bytes[End - 4]) == 0)
-            End -= 4;
-        }
-      }
-
-      outs() << '\n' << std::get<1>(Symbols[si]) << ":\n";
-
-      // Don't print raw contents of a virtual section. A virtual section
-      // doesn't have any contents in the file.
-      if (Section.isVirtual()) {
-        outs() << "...\n";
-        continue;
+      if (RangeStarts.empty() ||
+          Start >= RangeStartAddr + DisassemblyRangeSize) {
+        RangeStarts.push_back(si);
+        RangeStartAddr = Start;
       }
+    }
 
-#ifndef NDEBUG
-      raw_ostream &DebugOut = DebugFlag ? dbgs() : nulls();
-#else
-      raw_ostream &DebugOut = nulls();
-#endif
-
-      for (Index = Start; Index < End; Index += Size) {
-        MCInst Inst;
-
-        if (Index + SectionAddr < StartAddress ||
-            Index + SectionAddr > StopAddress) {
-          // skip byte by byte till StartAddress is reached
-          Size = 1;
-          continue;
-        }
-        // AArch64 ELF binaries can interleave data and text in the
-        // same section. We rely on the markers introduced to
-        // understand what we need to dump. If the data marker is within a
-        // function, it is denoted as a word/short etc
-        if (isArmElf(Obj) && std::get<2>(Symbols[si]) != ELF::STT_OBJECT &&
-            !DisassembleAll) {
-          uint64_t Stride = 0;
-
-          auto DAI = std::lower_bound(DataMappingSymsAddr.begin(),
-                                      DataMappingSymsAddr.end(), Index);
-          if (DAI != DataMappingSymsAddr.end() && *DAI == Index) {
-            // Switch to data.
-            while (Index < End) {
-              outs() << format("%8" PRIx64 ":", SectionAddr + Index);
-              outs() << "\t";
-              if (Index + 4 <= End) {
-                Stride = 4;
-                dumpBytes(Bytes.slice(Index, 4), outs());
-                outs() << "\t.word\t";
-                uint32_t Data = 0;
-                if (Obj->isLittleEndian()) {
-                  const auto Word =
-                      reinterpret_cast<const support::ulittle32_t *>(
-                          Bytes.data() + Index);
-                  Data = *Word;
-                } else {
-                  const auto Word = reinterpret_cast<const support::ubig32_t *>(
-                      Bytes.data() + Index);
-                  Data = *Word;
-                }
-                outs() << "0x" << format("%08" PRIx32, Data);
-              } else if (Index + 2 <= End) {
-                Stride = 2;
-                dumpBytes(Bytes.slice(Index, 2), outs());
-                outs() << "\t\t.short\t";
-                uint16_t Data = 0;
-                if (Obj->isLittleEndian()) {
-                  const auto Short =
-                      reinterpret_cast<const support::ulittle16_t *>(
-                          Bytes.data() + Index);
-                  Data = *Short;
-                } else {
-                  const auto Short =
-                      reinterpret_cast<const support::ubig16_t *>(Bytes.data() +
-                                                                  Index);
-                  Data = *Short;
-                }
-                outs() << "0x" << format("%04" PRIx16, Data);
-              } else {
-                Stride = 1;
-                dumpBytes(Bytes.slice(Index, 1), outs());
-                outs() << "\t\t.byte\t";
-                outs() << "0x" << format("%02" PRIx8, Bytes.slice(Index, 1)[0]);
-              }
-              Index += Stride;
-              outs() << "\n";
-              auto TAI = std::lower_bound(TextMappingSymsAddr.begin(),
-                                          TextMappingSymsAddr.end(), Index);
-              if (TAI != TextMappingSymsAddr.end() && *TAI == Index)
-                break;
-            }
-          }
-        }
+    auto DisassembleRange = [&](unsigned Range, size_t StartRelIndex,
+                                const DILineInfo &StartLineInfo,
+                                DisassemblerInstance &D,
+                                SymbolRangeDisassembly &Result) {
+      unsigned FirstSymbol = RangeStarts[Range];
+      unsigned LastSymbol = Range + 1 == RangeStarts.size()
+                                ? Symbols.size()
+                                : RangeStarts[Range + 1];
+      setSectionSymbolizer(SD, D);
+      SourcePrinter SP(SI, StartLineInfo);
+      raw_string_ostream OS(Result.Output);
+      Result.RelIndex = StartRelIndex;
+      disassembleSymbols(SD, D, SP, FirstSymbol, LastSymbol, Result.RelIndex,
+                         Result.PrintedSection, OS);
+      OS.flush();
+      Result.OldLineInfo = SP.getOldLineInfo();
+      Result.FirstLine = SP.getFirstLine();
+    };
 
-        // If there is a data symbol inside an ELF text section and we are only
-        // disassembling text (applicable all architectures),
-        // we are in a situation where we must print the data and not
-        // disassemble it.
-        if (Obj->isELF() && std::get<2>(Symbols[si]) == ELF::STT_OBJECT &&
-            !DisassembleAll && Section.isText()) {
-          // print out data up to 8 bytes at a time in hex and ascii
-          uint8_t AsciiData[9] = {'\0'};
-          uint8_t Byte;
-          int NumBytes = 0;
-
-          for (Index = Start; Index < End; Index += 1) {
-            if (((SectionAddr + Index) < StartAddress) ||
-                ((SectionAddr + Index) > StopAddress))
-              continue;
-            if (NumBytes == 0) {
-              outs() << format("%8" PRIx64 ":", SectionAddr + Index);
-              outs() << "\t";
-            }
-            Byte = Bytes.slice(Index)[0];
-            outs() << format(" %02x", Byte);
-            AsciiData[NumBytes] = isprint(Byte) ? Byte : '.';
-
-            uint8_t IndentOffset = 0;
-            NumBytes++;
-            if (Index == End - 1 || NumBytes > 8) {
-              // Indent the space for less than 8 bytes data.
-              // 2 spaces for byte and one for space between bytes
-              IndentOffset = 3 * (8 - NumBytes);
-              for (int Excess = 8 - NumBytes; Excess < 8; Excess++)
-                AsciiData[Excess] = '\0';
-              NumBytes = 8;
-            }
-            if (NumBytes == 8) {
-              AsciiData[8] = '\0';
-              outs() << std::string(IndentOffset, ' ') << "         ";
-              outs() << reinterpret_cast<char *>(AsciiData);
-              outs() << '\n';
-              NumBytes = 0;
-            }
-          }
-        }
-        if (Index >= End)
-          break;
-
-        // Disassemble a real instruction or a data when disassemble all is
-        // provided
-        bool Disassembled = DisAsm->getInstruction(Inst, Size, Bytes.slice(Index),
-                                                   SectionAddr + Index, DebugOut,
-                                                   CommentStream);
-        if (Size == 0)
-          Size = 1;
-
-        PIP.printInst(*IP, Disassembled ? &Inst : nullptr,
-                      Bytes.slice(Index, Size), SectionAddr + Index, outs(), "",
-                      *STI, &SP, &Rels);
-        outs() << CommentStream.str();
-        Comments.clear();
-
-        // Try to resolve the target of a call, tail call, etc. to a specific
-        // symbol.
-        if (MIA && (MIA->isCall(Inst) || MIA->isUnconditionalBranch(Inst) ||
-                    MIA->isConditionalBranch(Inst))) {
-          uint64_t Target;
-          if (MIA->evaluateBranch(Inst, SectionAddr + Index, Size, Target)) {
-            // In a relocatable object, the target's section must reside in
-            // the same section as the call instruction or it is accessed
-            // through a relocation.
-            //
-            // In a non-relocatable object, the target may be in any section.
-            //
-            // N.B. We don't walk the relocations in the relocatable case yet.
-            auto *TargetSectionSymbols = &Symbols;
-            if (!Obj->isRelocatableObject()) {
-              auto SectionAddress = std::upper_bound(
-                  SectionAddresses.begin(), SectionAddresses.end(), Target,
-                  [](uint64_t LHS,
-                      const std::pair<uint64_t, SectionRef> &RHS) {
-                    return LHS < RHS.first;
-                  });
-              if (SectionAddress != SectionAddresses.begin()) {
-                --SectionAddress;
-                TargetSectionSymbols = &AllSymbols[SectionAddress->second];
-              } else {
-                TargetSectionSymbols = &AbsoluteSymbols;
-              }
-            }
+    // A range is disassembled assuming that the relocations before its first
+    // symbol have been printed, and that no source line has been printed yet.
+    // If this turns out to be wrong once the ranges before it are done, it is
+    // disassembled again.
+    auto GetStartRelIndex = [&](unsigned Range) -> size_t {
+      // The Hexagon pretty printer prints the relocations itself.
+      if (Obj->getArch() == Triple::hexagon)
+        return skipHiddenRelocations(SD, 0);
+      uint64_t Start = std::get<0>(Symbols[RangeStarts[Range]]) - SectionAddr;
+      auto Rel = std::lower_bound(SD.Rels.begin(), SD.Rels.end(), Start,
+                                  [](const RelocationRef &LHS, uint64_t RHS) {
+                                    return LHS.getOffset() < RHS;
+                                  });
+      return skipHiddenRelocations(SD, Rel - SD.Rels.begin());
+    };
 
-            // Find the first symbol in the section whose offset is less than
-            // or equal to the target. If there isn't a section that contains
-            // the target, find the nearest preceding absolute symbol.
-            auto TargetSym = std::upper_bound(
-                TargetSectionSymbols->begin(), TargetSectionSymbols->end(),
-                Target, [](uint64_t LHS,
-                           const std::tuple<uint64_t, StringRef, uint8_t> &RHS) {
-                  return LHS < std::get<0>(RHS);
-                });
-            if (TargetSym == TargetSectionSymbols->begin()) {
-              TargetSectionSymbols = &AbsoluteSymbols;
-              TargetSym = std::upper_bound(
-                  AbsoluteSymbols.begin(), AbsoluteSymbols.end(),
-                  Target, [](uint64_t LHS,
-                             const std::tuple<uint64_t, StringRef, uint8_t> &RHS) {
-                            return LHS < std::get<0>(RHS);
-                          });
-            }
-            if (TargetSym != TargetSectionSymbols->begin()) {
-              --TargetSym;
-              uint64_t TargetAddress = std::get<0>(*TargetSym);
-              StringRef TargetName = std::get<1>(*TargetSym);
-              outs() << " <" << TargetName;
-              uint64_t Disp = Target - TargetAddress;
-              if (Disp)
-                outs() << "+0x" << Twine::utohexstr(Disp);
-              outs() << '>';
-            }
+    const unsigned BatchSize = 4 * NumThreads;
+    for (unsigned Batch = 0, NumRanges = RangeStarts.size(); Batch < NumRanges;
+         Batch += BatchSize) {
+      const unsigned BatchEnd = std::min(Batch + BatchSize, NumRanges);
+      std::vector<SymbolRangeDisassembly> Results(BatchEnd - Batch);
+      for (unsigned Range = Batch; Range != BatchEnd; ++Range) {
+        SymbolRangeDisassembly *Result = &Results[Range - Batch];
+        Pool->async([&, Range, Result]() {
+          std::unique_ptr<DisassemblerInstance> D;
+          {
+            std::lock_guard<std::mutex> Lock(FreeDisassemblersMutex);
+            D = std::move(FreeDisassemblers.back());
+            FreeDisassemblers.pop_back();
           }
+          DisassembleRange(Range, GetStartRelIndex(Range), DILineInfo(), *D,
+                           *Result);
+          std::lock_guard<std::mutex> Lock(FreeDisassemblersMutex);
+          FreeDisassemblers.push_back(std::move(D));
+        });
+      }
+      Pool->wait();
+
+      for (unsigned Range = Batch; Range != BatchEnd; ++Range) {
+        SymbolRangeDisassembly &Result = Results[Range - Batch];
+        if (skipHiddenRelocations(SD, RelIndex) != GetStartRelIndex(Range) ||
+            (OldLineInfo.Line && Result.FirstLine == OldLineInfo.Line)) {
+          Result = SymbolRangeDisassembly();
+          DisassembleRange(Range, RelIndex, OldLineInfo, *MainDisassembler,
+                           Result);
         }
-        outs() << "\n";
-
-        // Hexagon does this in pretty printer
-        if (Obj->getArch() != Triple::hexagon)
-          // Print relocation for instruction.
-          while (rel_cur != rel_end) {
-            bool hidden = getHidden(*rel_cur);
-            uint64_t addr = rel_cur->getOffset();
-            SmallString<16> name;
-            SmallString<32> val;
-
-            // If this relocation is hidden, skip it.
-            if (hidden || ((SectionAddr + addr) < StartAddress)) {
-              ++rel_cur;
-              continue;
-            }
-
-            // Stop when rel_cur's address is past the current instruction.
-            if (addr >= Index + Size) break;
-            rel_cur->getTypeName(name);
-            error(getRelocationValueString(*rel_cur, val));
-            outs() << format(Fmt.data(), SectionAddr + addr) << name
-                   << "\t" << val << "\n";
-            ++rel_cur;
-          }
+        StringRef Output = Result.Output;
+        // Only the first range that prints something has the section header.
+        if (Result.PrintedSection && PrintedSection)
+          Output = Output.drop_front(SD.Header.size());
+        outs() << Output;
+        PrintedSection |= Result.PrintedSection;
+        RelIndex = Result.RelIndex;
+        if (Result.OldLineInfo.Line)
+          OldLineInfo = Result.OldLineInfo;
       }
     }
   }
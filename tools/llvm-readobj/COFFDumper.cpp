@@ -1552,7 +1552,7 @@ void COFFDumper::printNeededLibraries() {
   std::stable_sort(Libs.begin(), Libs.end());
 
   for (const auto &L : Libs) {
-    outs() << "  " << L << "\n";
+    W.getOStream() << "  " << L << "\n";
   }
 }
 
@@ -700,7 +700,7 @@ void MachODumper::printNeededLibraries() {
   std::stable_sort(Libs.begin(), Libs.end());
 
   for (const auto &L : Libs) {
-    outs() << "  " << L << "\n";
+    W.getOStream() << "  " << L << "\n";
   }
 }
 
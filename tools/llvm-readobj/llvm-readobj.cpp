@@ -31,6 +31,7 @@
 #include "llvm/Object/WindowsResource.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Compiler.h"
 #include "llvm/Support/DataTypes.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FileSystem.h"
@@ -39,6 +40,11 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
 
 using namespace llvm;
 using namespace llvm::object;
@@ -301,13 +307,66 @@ namespace opts {
              cl::values(clEnumVal(LLVM, "LLVM default style"),
                         clEnumVal(GNU, "GNU readelf style")),
              cl::init(LLVM));
+
+  // -num-threads
+  cl::opt<unsigned>
+      NumThreads("num-threads",
+                 cl::desc("Number of threads used to dump the members of "
+                          "archives (0 = number of hardware threads)"),
+                 cl::init(1));
 } // namespace opts
 
+namespace {
+/// Writes the outputs of archive members dumped in parallel in member order.
+class OrderedOutput {
+public:
+  explicit OrderedOutput(raw_ostream &OS) : OS(OS) {}
+
+  /// Writes \p Text as the output of the member \p Index once the outputs of
+  /// the members before it have been written.
+  void write(size_t Index, StringRef Text) {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    Cond.wait(Lock, [&] { return Next == Index; });
+    OS << Text;
+    ++Next;
+    Cond.notify_all();
+  }
+
+private:
+  raw_ostream &OS;
+  std::mutex Mutex;
+  std::condition_variable Cond;
+  size_t Next = 0;
+};
+
+/// An archive member being dumped by a worker thread.
+struct MemberDump {
+  OrderedOutput *Output;
+  size_t Index;
+  raw_string_ostream *OS;
+};
+} // namespace
+
+/// The member dumped by the current thread, when it is a worker of a parallel
+/// archive dump.
+static LLVM_THREAD_LOCAL MemberDump *CurrentMember = nullptr;
+
 namespace llvm {
 
 LLVM_ATTRIBUTE_NORETURN void reportError(Twine Msg) {
+  // Like in a serial dump, the error follows what was dumped of the members
+  // up to and including the failing one.
+  if (CurrentMember)
+    CurrentMember->Output->write(CurrentMember->Index,
+                                 CurrentMember->OS->str());
   errs() << "\nError reading file: " << Msg << ".\n";
   errs().flush();
+  if (CurrentMember) {
+    // The other workers are still running, so the globals they use must not
+    // be destroyed.
+    outs().flush();
+    std::_Exit(1);
+  }
   exit(1);
 }
 
@@ -500,24 +559,71 @@ static void dumpObject(const ObjectFile *Obj, ScopedPrinter &Writer) {
     Dumper->printStackMap();
 }
 
+/// Dumps the object file \a Child of \a Arc;
+static void dumpArchiveMember(const Archive *Arc, const Archive::Child &Child,
+                              ScopedPrinter &Writer) {
+  Expected<std::unique_ptr<Binary>> ChildOrErr = Child.getAsBinary();
+  if (!ChildOrErr) {
+    if (auto E = isNotObjectErrorInvalidFileType(ChildOrErr.takeError())) {
+      reportError(Arc->getFileName(), ChildOrErr.takeError());
+    }
+    return;
+  }
+  if (ObjectFile *Obj = dyn_cast<ObjectFile>(&*ChildOrErr.get()))
+    dumpObject(Obj, Writer);
+  else if (COFFImportFile *Imp = dyn_cast<COFFImportFile>(&*ChildOrErr.get()))
+    dumpCOFFImportFile(Imp, Writer);
+  else
+    reportError(Arc->getFileName(), readobj_error::unrecognized_file_format);
+}
+
+/// Dumps each object file in \a Arc on a thread pool. The members are read
+/// in place from the archive buffer and dumped into their own buffers, which
+/// are written in member order as soon as they are complete.
+static void dumpArchiveInParallel(const Archive *Arc, ScopedPrinter &Writer) {
+  Error Err = Error::success();
+  std::vector<Archive::Child> Children;
+  for (auto &Child : Arc->children(Err))
+    Children.push_back(Child);
+
+  OrderedOutput Output(Writer.getOStream());
+  std::vector<std::string> Buffers(Children.size());
+  std::vector<std::shared_future<void>> Done;
+  Done.reserve(Children.size());
+  ThreadPool Pool(opts::NumThreads ? opts::NumThreads
+                                   : hardware_concurrency());
+  for (size_t I = 0, E = Children.size(); I != E; ++I)
+    Done.push_back(Pool.async([&, I]() {
+      raw_string_ostream OS(Buffers[I]);
+      ScopedPrinter MemberWriter(OS);
+      MemberDump Member = {&Output, I, &OS};
+      CurrentMember = &Member;
+      dumpArchiveMember(Arc, Children[I], MemberWriter);
+      CurrentMember = nullptr;
+    }));
+  for (size_t I = 0, E = Children.size(); I != E; ++I) {
+    Done[I].wait();
+    Output.write(I, Buffers[I]);
+    std::string().swap(Buffers[I]);
+  }
+
+  if (Err)
+    reportError(Arc->getFileName(), std::move(Err));
+}
+
 /// Dumps each object file in \a Arc;
 static void dumpArchive(const Archive *Arc, ScopedPrinter &Writer) {
-  Error Err = Error::success();
-  for (auto &Child : Arc->children(Err)) {
-    Expected<std::unique_ptr<Binary>> ChildOrErr = Child.getAsBinary();
-    if (!ChildOrErr) {
-      if (auto E = isNotObjectErrorInvalidFileType(ChildOrErr.takeError())) {
-        reportError(Arc->getFileName(), ChildOrErr.takeError());
-      }
-      continue;
-    }
-    if (ObjectFile *Obj = dyn_cast<ObjectFile>(&*ChildOrErr.get()))
-      dumpObject(Obj, Writer);
-    else if (COFFImportFile *Imp = dyn_cast<COFFImportFile>(&*ChildOrErr.get()))
-      dumpCOFFImportFile(Imp, Writer);
-    else
-      reportError(Arc->getFileName(), readobj_error::unrecognized_file_format);
+  // The merged CodeView types and the symbol numbering of the GNU style are
+  // shared between the members, which must then be dumped in order.
+  if (opts::NumThreads != 1 && opts::Output == opts::LLVM &&
+      !opts::CodeViewMergedTypes) {
+    dumpArchiveInParallel(Arc, Writer);
+    return;
   }
+
+  Error Err = Error::success();
+  for (auto &Child : Arc->children(Err))
+    dumpArchiveMember(Arc, Child, Writer);
   if (Err)
     reportError(Arc->getFileName(), std::move(Err));
 }
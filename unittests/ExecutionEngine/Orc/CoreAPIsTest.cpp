@@ -834,6 +834,70 @@ TEST(CoreAPIsTest, TestLookupWithThreadedMaterialization) {
 #endif
 }
 
+TEST(CoreAPIsTest, TestFinalizedLookupRespectsSearchOrder) {
+  ExecutionSession ES;
+  auto Foo = ES.getSymbolStringPool().intern("foo");
+  JITEvaluatedSymbol FooSym1(0xdeadbeef, JITSymbolFlags::Exported);
+  JITEvaluatedSymbol FooSym2(0xcafef00d, JITSymbolFlags::Exported);
+
+  auto &V1 = ES.createVSO("V1");
+  auto &V2 = ES.createVSO("V2");
+  cantFail(V1.define(absoluteSymbols({{Foo, FooSym1}})));
+  cantFail(V2.define(absoluteSymbols({{Foo, FooSym2}})));
+
+  // Finalize foo in V2 only: it is still lazy in V1, which shadows V2.
+  EXPECT_EQ(cantFail(lookup({&V2}, Foo)).getAddress(), FooSym2.getAddress());
+  EXPECT_EQ(cantFail(lookup({&V1, &V2}, Foo)).getAddress(),
+            FooSym1.getAddress())
+      << "lookup did not return the definition from the first VSO";
+
+  // Now that foo is finalized in V1 too, it is found in V1 without a query.
+  SymbolMap Result;
+  SymbolNameSet Names({Foo});
+  V1.lookupFinalized(Result, Names);
+  EXPECT_TRUE(Names.empty()) << "foo should have been found";
+  EXPECT_EQ(Result[Foo].getAddress(), FooSym1.getAddress());
+  EXPECT_EQ(cantFail(lookup({&V1, &V2}, Foo)).getAddress(),
+            FooSym1.getAddress());
+}
+
+TEST(CoreAPIsTest, TestConcurrentLookupOfFinalizedSymbols) {
+#if LLVM_ENABLE_THREADS
+  constexpr unsigned NumSymbols = 64;
+  constexpr unsigned NumThreads = 8;
+
+  ExecutionSession ES;
+  auto &V = ES.createVSO("V");
+
+  SymbolMap Defs;
+  SymbolNameSet Names;
+  for (unsigned I = 0; I != NumSymbols; ++I) {
+    auto Name = ES.getSymbolStringPool().intern("sym" + std::to_string(I));
+    Defs[Name] = JITEvaluatedSymbol(0x1000 + I, JITSymbolFlags::Exported);
+    Names.insert(Name);
+  }
+  cantFail(V.define(absoluteSymbols(Defs)));
+
+  // The first lookup materializes and finalizes the symbols; the following
+  // ones only read the finalized symbols.
+  EXPECT_EQ(cantFail(lookup({&V}, Names)).size(), NumSymbols);
+
+  std::vector<std::thread> Threads;
+  for (unsigned T = 0; T != NumThreads; ++T)
+    Threads.push_back(std::thread([&]() {
+      for (unsigned Iter = 0; Iter != 100; ++Iter) {
+        auto Result = cantFail(lookup({&V}, Names));
+        EXPECT_EQ(Result.size(), NumSymbols);
+        for (auto &KV : Result)
+          EXPECT_EQ(KV.second.getAddress(),
+                    Defs.find(KV.first)->second.getAddress());
+      }
+    }));
+  for (auto &Thread : Threads)
+    Thread.join();
+#endif
+}
+
 TEST(CoreAPIsTest, TestGetRequestedSymbolsAndDelegate) {
   ExecutionSession ES;
   auto Foo = ES.getSymbolStringPool().intern("foo");
@@ -0,0 +1,64 @@
+//===------------- LLJITTest.cpp - Unit tests for LLJIT -------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "OrcTestCommon.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+class LLJITTest : public testing::Test, public OrcExecutionTest {};
+
+TEST_F(LLJITTest, ConcurrentCompilation) {
+  if (!SupportsJIT)
+    return;
+
+  const unsigned NumModules = 8;
+  JITTargetMachineBuilder JTMB(TM->getTargetTriple());
+  DataLayout DL = TM->createDataLayout();
+  auto J = cantFail(LLJIT::Create(llvm::make_unique<ExecutionSession>(),
+                                  std::move(JTMB), DL,
+                                  /*NumCompileThreads=*/4));
+
+  // Modules compiled concurrently need their own contexts.
+  std::vector<std::unique_ptr<LLVMContext>> Contexts;
+  MangleAndInterner Mangle(J->getExecutionSession(), DL);
+  SymbolNameSet Names;
+  for (unsigned I = 0; I != NumModules; ++I) {
+    Contexts.push_back(llvm::make_unique<LLVMContext>());
+    std::string Name = ("f" + Twine(I)).str();
+    ModuleBuilder MB(*Contexts.back(), TM->getTargetTriple().str(), Name);
+    Function *F = MB.createFunctionDecl<int32_t(void)>(Name);
+    IRBuilder<> Builder(BasicBlock::Create(F->getContext(), "entry", F));
+    Builder.CreateRet(Builder.getInt32(I));
+    cantFail(J->addIRModule(MB.takeModule()));
+    Names.insert(Mangle(Name));
+  }
+
+  // Looking up all symbols at once dispatches all modules to the compile
+  // threads together.
+  auto Result = lookup({&J->getMainVSO()}, Names);
+  ASSERT_TRUE(!!Result) << "Lookup failed";
+  ASSERT_EQ(Result->size(), NumModules) << "Missing symbols";
+
+  for (unsigned I = 0; I != NumModules; ++I) {
+    auto &Sym = (*Result)[Mangle(("f" + Twine(I)).str())];
+    auto *Fn = reinterpret_cast<int32_t (*)()>(
+        static_cast<uintptr_t>(Sym.getAddress()));
+    EXPECT_EQ(Fn(), static_cast<int32_t>(I)) << "Wrong result for f" << I;
+  }
+}
+
+} // namespace
@@ -0,0 +1,75 @@
+//===- PersistentObjectCacheTest.cpp - Unit tests for the on-disk cache ---===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/PersistentObjectCache.h"
+#include "OrcTestCommon.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/Support/FileSystem.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+class PersistentObjectCacheTest : public testing::Test,
+                                  public OrcExecutionTest {
+protected:
+  std::unique_ptr<Module> createModule(LLVMContext &Ctx, int32_t Result) {
+    ModuleBuilder MB(Ctx, TM->getTargetTriple().str(), "cached");
+    Function *F = MB.createFunctionDecl<int32_t(void)>("f");
+    IRBuilder<> Builder(BasicBlock::Create(Ctx, "entry", F));
+    Builder.CreateRet(Builder.getInt32(Result));
+    return MB.takeModule();
+  }
+};
+
+TEST_F(PersistentObjectCacheTest, ReuseAcrossContexts) {
+  if (!SupportsJIT)
+    return;
+
+  SmallString<128> CacheDir;
+  ASSERT_FALSE(sys::fs::createUniqueDirectory("orc-object-cache", CacheDir));
+
+  std::string CachedPath;
+  std::string CompiledObj;
+  {
+    PersistentObjectCache Cache(CacheDir, *TM);
+    LLVMContext Ctx;
+    auto M = createModule(Ctx, 42);
+    CachedPath = Cache.getCachePath(*M);
+    auto Obj = SimpleCompiler(*TM, &Cache)(*M);
+    ASSERT_TRUE(!!Obj) << "Compile failed";
+    CompiledObj = Obj->getBuffer();
+    EXPECT_TRUE(sys::fs::exists(CachedPath)) << "Object was not cached";
+  }
+
+  {
+    // An identical module in a new context, e.g. in a restarted process, hits
+    // in the cache.
+    PersistentObjectCache Cache(CacheDir, *TM);
+    LLVMContext Ctx;
+    auto M = createModule(Ctx, 42);
+    auto Obj = Cache.getObject(M.get());
+    ASSERT_TRUE(!!Obj) << "Cache miss for identical module";
+    EXPECT_EQ(Obj->getBuffer(), CompiledObj) << "Wrong object returned";
+
+    // A different module misses.
+    auto Other = createModule(Ctx, 7);
+    EXPECT_FALSE(Cache.getObject(Other.get())) << "Cache hit for other module";
+  }
+
+  sys::fs::remove(CachedPath);
+  sys::fs::remove(CacheDir);
+}
+
+} // namespace
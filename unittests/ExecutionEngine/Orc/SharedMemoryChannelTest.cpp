@@ -0,0 +1,141 @@
+//===-- SharedMemoryChannelTest.cpp - Unit tests for SharedMemoryChannel --===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/SharedMemoryChannel.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/ExecutionEngine/Orc/RPCUtils.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+using namespace llvm;
+using namespace llvm::orc;
+using namespace llvm::orc::rpc;
+
+#ifdef LLVM_ON_UNIX
+
+#include <unistd.h>
+
+namespace {
+
+std::string getUniqueChannelName() {
+  static unsigned Counter = 0;
+  return ("/llvm-orc-shm-test-" + Twine(::getpid()) + "-" +
+          Twine(Counter++))
+      .str();
+}
+
+class IntInt : public Function<IntInt, int32_t(int32_t)> {
+public:
+  static const char *getName() { return "IntInt"; }
+};
+
+class VoidBuffer : public Function<VoidBuffer, void(std::vector<uint8_t>)> {
+public:
+  static const char *getName() { return "VoidBuffer"; }
+};
+
+class ChannelRPCEndpoint : public SingleThreadedRPCEndpoint<RawByteChannel> {
+public:
+  ChannelRPCEndpoint(RawByteChannel &C)
+      : SingleThreadedRPCEndpoint(C, true) {}
+};
+
+TEST(SharedMemoryChannelTest, MessagesWrapAroundTheRing) {
+  std::string Name = getUniqueChannelName();
+  auto Client = SharedMemoryChannel::create(Name, 256);
+  ASSERT_TRUE(!!Client) << toString(Client.takeError());
+  auto Server = SharedMemoryChannel::open(Name);
+  ASSERT_TRUE(!!Server) << toString(Server.takeError());
+
+  // Send messages both smaller and larger than the ring, so that the writer
+  // has to wait for the reader to drain it.
+  std::vector<char> Data(4096);
+  for (size_t I = 0; I != Data.size(); ++I)
+    Data[I] = static_cast<char>(I * 7);
+
+  std::thread Reader([&]() {
+    for (unsigned Size : {1u, 100u, 255u, 256u, 1000u, 4096u}) {
+      std::vector<char> Received(Size);
+      EXPECT_FALSE(!!(*Server)->readBytes(Received.data(), Size));
+      EXPECT_TRUE(std::equal(Received.begin(), Received.end(), Data.begin()));
+    }
+  });
+  for (unsigned Size : {1u, 100u, 255u, 256u, 1000u, 4096u}) {
+    EXPECT_FALSE(!!(*Client)->appendBytes(Data.data(), Size));
+    EXPECT_FALSE(!!(*Client)->send());
+  }
+  Reader.join();
+}
+
+TEST(SharedMemoryChannelTest, RPCCalls) {
+  std::string Name = getUniqueChannelName();
+  auto ClientChannel = SharedMemoryChannel::create(Name, 1024);
+  ASSERT_TRUE(!!ClientChannel) << toString(ClientChannel.takeError());
+  auto ServerChannel = SharedMemoryChannel::open(Name);
+  ASSERT_TRUE(!!ServerChannel) << toString(ServerChannel.takeError());
+
+  ChannelRPCEndpoint Client(**ClientChannel);
+  ChannelRPCEndpoint Server(**ServerChannel);
+
+  std::thread ServerThread([&]() {
+    size_t Received = 0;
+    Server.addHandler<IntInt>([](int32_t X) { return X + 1; });
+    Server.addHandler<VoidBuffer>(
+        [&](std::vector<uint8_t> Buffer) { Received += Buffer.size(); });
+    // Handle the negotiate calls and the two calls.
+    for (unsigned I = 0; I != 4; ++I)
+      EXPECT_FALSE(!!Server.handleOne()) << "Server failed to handle call";
+    EXPECT_EQ(64u * 1024, Received);
+  });
+
+  {
+    auto Result = Client.callB<IntInt>(41);
+    ASSERT_TRUE(!!Result) << toString(Result.takeError());
+    EXPECT_EQ(42, *Result);
+  }
+  {
+    // A buffer much larger than the ring, like the code sent by writeMem.
+    auto Err = Client.callB<VoidBuffer>(std::vector<uint8_t>(64 * 1024, 0x90));
+    EXPECT_FALSE(!!Err) << "Client failed to send the buffer";
+  }
+
+  ServerThread.join();
+}
+
+TEST(SharedMemoryChannelTest, ClosedChannel) {
+  std::string Name = getUniqueChannelName();
+  auto Client = SharedMemoryChannel::create(Name);
+  ASSERT_TRUE(!!Client) << toString(Client.takeError());
+  auto Server = SharedMemoryChannel::open(Name);
+  ASSERT_TRUE(!!Server) << toString(Server.takeError());
+
+  // The bytes sent before closing are still delivered.
+  char Byte = 'x';
+  EXPECT_FALSE(!!(*Client)->appendBytes(&Byte, 1));
+  Client->reset();
+
+  char Received = 0;
+  EXPECT_FALSE(!!(*Server)->readBytes(&Received, 1));
+  EXPECT_EQ('x', Received);
+  Error Err = (*Server)->readBytes(&Received, 1);
+  EXPECT_TRUE(Err.isA<ConnectionClosed>());
+  consumeError(std::move(Err));
+
+  // The name was unlinked with the channel that created it.
+  auto Reopened = SharedMemoryChannel::open(Name);
+  EXPECT_FALSE(!!Reopened);
+  consumeError(Reopened.takeError());
+}
+
+} // end anonymous namespace
+
+#endif // LLVM_ON_UNIX
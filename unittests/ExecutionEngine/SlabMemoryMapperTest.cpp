@@ -0,0 +1,102 @@
+//===- SlabMemoryMapperTest.cpp - Unit tests for the slab memory mapper ---===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/SlabMemoryMapper.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/Process.h"
+#include "gtest/gtest.h"
+#include <deque>
+
+using namespace llvm;
+
+namespace {
+
+const size_t PageSize = sys::Process::getPageSize();
+
+// Allocates and finalizes the sections of a small object, and returns the
+// address of its code.
+uint8_t *emitSmallObject(SectionMemoryManager &MemMgr) {
+  uint8_t *Code = MemMgr.allocateCodeSection(64, 0, 1, "");
+  uint8_t *ROData = MemMgr.allocateDataSection(32, 0, 2, "", true);
+  uint8_t *RWData = MemMgr.allocateDataSection(32, 0, 3, "", false);
+  if (!Code || !ROData || !RWData)
+    return nullptr;
+  memset(Code, 0xc3, 64);
+  memset(ROData, 1, 32);
+  memset(RWData, 2, 32);
+  std::string Error;
+  if (MemMgr.finalizeMemory(&Error))
+    return nullptr;
+  return Code;
+}
+
+TEST(SlabMemoryMapperTest, PacksObjects) {
+  SlabMemoryMapper Mapper(32 * PageSize);
+  std::vector<std::unique_ptr<SectionMemoryManager>> MemMgrs;
+  std::vector<uint8_t *> Code;
+  for (unsigned I = 0; I != 16; ++I) {
+    MemMgrs.push_back(llvm::make_unique<SectionMemoryManager>(&Mapper));
+    Code.push_back(emitSmallObject(*MemMgrs.back()));
+    ASSERT_NE(nullptr, Code.back());
+  }
+
+  // One slab per purpose, with the code of the objects on adjacent pages.
+  EXPECT_EQ(3u, Mapper.getNumSlabs());
+  for (unsigned I = 1; I != 16; ++I)
+    EXPECT_EQ(Code[I - 1] + PageSize, Code[I]);
+}
+
+TEST(SlabMemoryMapperTest, ReusesReleasedMemory) {
+  SlabMemoryMapper Mapper(32 * PageSize);
+  uint8_t *Code;
+  {
+    SectionMemoryManager MemMgr(&Mapper);
+    Code = emitSmallObject(MemMgr);
+    ASSERT_NE(nullptr, Code);
+  }
+
+  // The released pages are handed out again, and are writable.
+  SectionMemoryManager MemMgr(&Mapper);
+  uint8_t *NewCode = MemMgr.allocateCodeSection(64, 0, 1, "");
+  EXPECT_EQ(Code, NewCode);
+  memset(NewCode, 0x90, 64);
+  EXPECT_EQ(3u, Mapper.getNumSlabs());
+}
+
+TEST(SlabMemoryMapperTest, LargeAllocation) {
+  SlabMemoryMapper Mapper(4 * PageSize);
+  std::error_code EC;
+  sys::MemoryBlock MB = Mapper.allocateMappedMemory(
+      SlabMemoryMapper::AllocationPurpose::Code, 8 * PageSize, nullptr,
+      sys::Memory::MF_READ | sys::Memory::MF_WRITE, EC);
+  ASSERT_FALSE(EC);
+  EXPECT_LE(8 * PageSize, MB.size());
+  EXPECT_EQ(0u, Mapper.getNumSlabs());
+  EXPECT_FALSE(Mapper.releaseMappedMemory(MB));
+}
+
+TEST(SlabMemoryMapperTest, ManySmallObjects) {
+  // Emit 10000 small objects with at most 64 of them alive at a time; the
+  // released memory is recycled, so the slabs don't grow with the number of
+  // objects emitted.
+  SlabMemoryMapper Mapper(128 * PageSize, /*UseHugePages=*/true);
+  std::deque<std::unique_ptr<SectionMemoryManager>> Live;
+  for (unsigned I = 0; I != 10000; ++I) {
+    if (Live.size() == 64)
+      Live.pop_front();
+    Live.push_back(llvm::make_unique<SectionMemoryManager>(&Mapper));
+    ASSERT_NE(nullptr, emitSmallObject(*Live.back()));
+  }
+  EXPECT_EQ(3u, Mapper.getNumSlabs());
+
+  Live.clear();
+  EXPECT_EQ(3u, Mapper.getNumSlabs());
+}
+
+} // end anonymous namespace
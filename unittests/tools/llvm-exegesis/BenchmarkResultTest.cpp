@@ -120,6 +120,93 @@ TEST(BenchmarkResultTest, WriteToAndReadFromDisk) {
   }
 }
 
+TEST(BenchmarkResultTest, WriteToAndReadFromBinary) {
+  llvm::ExitOnError ExitOnErr;
+  BenchmarkResultContext Ctx;
+  Ctx.addInstrEntry(kInstrId, kInstrName);
+  Ctx.addRegEntry(kReg1Id, kReg1Name);
+  Ctx.addRegEntry(kReg2Id, kReg2Name);
+
+  InstructionBenchmark ToDisk;
+
+  ToDisk.Key.Instructions.push_back(llvm::MCInstBuilder(kInstrId)
+                                        .addReg(kReg1Id)
+                                        .addReg(kReg2Id)
+                                        .addImm(-123)
+                                        .addFPImm(0.5));
+  ToDisk.Key.Config = "config";
+  ToDisk.Mode = InstructionBenchmark::Uops;
+  ToDisk.CpuName = "cpu_name";
+  ToDisk.LLVMTriple = "llvm_triple";
+  ToDisk.NumRepetitions = 1;
+  ToDisk.Measurements.push_back(BenchmarkMeasure{"a", 1, "debug a"});
+  ToDisk.Measurements.push_back(BenchmarkMeasure{"b", 2, ""});
+  ToDisk.Error = "error";
+  ToDisk.Info = "info";
+  ToDisk.AssembledSnippet = {0x90, 0x00, 0xc3};
+
+  llvm::SmallString<64> Filename;
+  std::error_code EC;
+  EC = llvm::sys::fs::createUniqueDirectory("BenchmarkResultTestDir", Filename);
+  ASSERT_FALSE(EC);
+  llvm::sys::path::append(Filename, "data.bin");
+  {
+    // Write two concatenated files, as when merging the results of workers.
+    llvm::raw_fd_ostream OS(Filename, EC, llvm::sys::fs::F_None);
+    ASSERT_FALSE(EC);
+    InstructionBenchmark::writeBinaryHeader(OS);
+    ToDisk.writeBinaryTo(Ctx, OS);
+    InstructionBenchmark::writeBinaryHeader(OS);
+    ToDisk.writeBinaryTo(Ctx, OS);
+  }
+
+  const auto FromDiskVector =
+      ExitOnErr(InstructionBenchmark::readFile(Ctx, Filename));
+  ASSERT_EQ(FromDiskVector.size(), size_t{2});
+  for (const auto &FromDisk : FromDiskVector) {
+    EXPECT_THAT(FromDisk.Key.Instructions,
+                Pointwise(EqMCInst(), ToDisk.Key.Instructions));
+    EXPECT_EQ(FromDisk.Key.Config, ToDisk.Key.Config);
+    EXPECT_EQ(FromDisk.Mode, ToDisk.Mode);
+    EXPECT_EQ(FromDisk.CpuName, ToDisk.CpuName);
+    EXPECT_EQ(FromDisk.LLVMTriple, ToDisk.LLVMTriple);
+    EXPECT_EQ(FromDisk.NumRepetitions, ToDisk.NumRepetitions);
+    EXPECT_THAT(FromDisk.Measurements, ToDisk.Measurements);
+    EXPECT_THAT(FromDisk.Error, ToDisk.Error);
+    EXPECT_EQ(FromDisk.Info, ToDisk.Info);
+    EXPECT_EQ(FromDisk.AssembledSnippet, ToDisk.AssembledSnippet);
+  }
+}
+
+TEST(BenchmarkResultTest, ReadTruncatedBinary) {
+  BenchmarkResultContext Ctx;
+  Ctx.addInstrEntry(kInstrId, kInstrName);
+
+  InstructionBenchmark ToDisk;
+  ToDisk.Key.Instructions.push_back(llvm::MCInstBuilder(kInstrId));
+  std::string Buffer;
+  {
+    llvm::raw_string_ostream OS(Buffer);
+    InstructionBenchmark::writeBinaryHeader(OS);
+    ToDisk.writeBinaryTo(Ctx, OS);
+  }
+
+  llvm::SmallString<64> Filename;
+  std::error_code EC;
+  EC = llvm::sys::fs::createUniqueDirectory("BenchmarkResultTestDir", Filename);
+  ASSERT_FALSE(EC);
+  llvm::sys::path::append(Filename, "truncated.bin");
+  {
+    llvm::raw_fd_ostream OS(Filename, EC, llvm::sys::fs::F_None);
+    ASSERT_FALSE(EC);
+    OS << llvm::StringRef(Buffer).drop_back();
+  }
+
+  auto FromDisk = InstructionBenchmark::readBinaries(Ctx, Filename);
+  EXPECT_FALSE(static_cast<bool>(FromDisk));
+  llvm::consumeError(FromDisk.takeError());
+}
+
 TEST(BenchmarkResultTest, BenchmarkMeasureStats) {
   BenchmarkMeasureStats Stats;
   Stats.push(BenchmarkMeasure{"a", 0.5, "debug a"});
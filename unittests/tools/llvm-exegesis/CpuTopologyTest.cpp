@@ -0,0 +1,54 @@
+//===-- CpuTopologyTest.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "CpuTopology.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace exegesis {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(CpuTopologyTest, ParseCpuList) {
+  auto Cpus = parseCpuList("0-3,8,10-11\n");
+  ASSERT_TRUE(static_cast<bool>(Cpus)) << llvm::toString(Cpus.takeError());
+  EXPECT_THAT(*Cpus, ElementsAre(0, 1, 2, 3, 8, 10, 11));
+}
+
+TEST(CpuTopologyTest, ParseCpuListSortsAndRemovesDuplicates) {
+  auto Cpus = parseCpuList("5,1-2,2");
+  ASSERT_TRUE(static_cast<bool>(Cpus)) << llvm::toString(Cpus.takeError());
+  EXPECT_THAT(*Cpus, ElementsAre(1, 2, 5));
+}
+
+TEST(CpuTopologyTest, ParseEmptyCpuList) {
+  auto Cpus = parseCpuList("\n");
+  ASSERT_TRUE(static_cast<bool>(Cpus)) << llvm::toString(Cpus.takeError());
+  EXPECT_THAT(*Cpus, IsEmpty());
+}
+
+TEST(CpuTopologyTest, ParseInvalidCpuList) {
+  for (const char *List : {"a", "1-", "3-1", "1,x-2"}) {
+    auto Cpus = parseCpuList(List);
+    EXPECT_FALSE(static_cast<bool>(Cpus)) << List;
+    llvm::consumeError(Cpus.takeError());
+  }
+}
+
+TEST(CpuTopologyTest, PhysicalCoresAreDistinct) {
+  const std::vector<unsigned> Cores = getPhysicalCores();
+  EXPECT_FALSE(Cores.empty());
+  for (const unsigned Core : Cores)
+    EXPECT_EQ(Core, getCoreSiblings(Core).front());
+}
+
+} // namespace
+} // namespace exegesis
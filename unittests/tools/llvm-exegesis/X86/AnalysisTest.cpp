@@ -3,6 +3,8 @@
 #include <cassert>
 #include <memory>
 
+#include "X86InstrInfo.h"
+#include "llvm/MC/MCInstBuilder.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
 #include "gmock/gmock.h"
@@ -26,6 +28,8 @@ protected:
       return;
     }
     STI.reset(TheTarget->createMCSubtargetInfo(TT, "haswell", ""));
+    InstrInfo.reset(TheTarget->createMCInstrInfo());
+    RegInfo.reset(TheTarget->createMCRegInfo(TT));
 
     // Compute the ProxResIdx of ports unes in tests.
     const auto &SM = STI->getSchedModel();
@@ -61,6 +65,8 @@ protected:
 
 protected:
   std::unique_ptr<const llvm::MCSubtargetInfo> STI;
+  std::unique_ptr<const llvm::MCInstrInfo> InstrInfo;
+  std::unique_ptr<const llvm::MCRegisterInfo> RegInfo;
   uint16_t P0Idx = 0;
   uint16_t P1Idx = 0;
   uint16_t P5Idx = 0;
@@ -98,5 +104,32 @@ TEST_F(AnalysisTest, ComputeIdealizedProcResPressure_1P1_1P05_2P0156) {
                                    Pair(P5Idx, 1.0), Pair(P6Idx, 1.0)));
 }
 
+static llvm::MCInst imul32rr(unsigned Dst, unsigned Src) {
+  return llvm::MCInstBuilder(llvm::X86::IMUL32rr)
+      .addReg(Dst)
+      .addReg(Dst)
+      .addReg(Src);
+}
+
+TEST_F(AnalysisTest, PredictCyclesPerIteration_LoopCarriedDependency) {
+  // Each multiply depends on the previous one: 3 cycles of latency.
+  const auto Cycles = predictCyclesPerIteration(
+      *STI, *InstrInfo, *RegInfo, {imul32rr(llvm::X86::EAX, llvm::X86::EBX)});
+  ASSERT_TRUE(Cycles.hasValue());
+  EXPECT_DOUBLE_EQ(3.0, *Cycles);
+}
+
+TEST_F(AnalysisTest, PredictCyclesPerIteration_ResourcePressure) {
+  // Four independent chains of multiplies, all on P1.
+  const auto Cycles = predictCyclesPerIteration(
+      *STI, *InstrInfo, *RegInfo,
+      {imul32rr(llvm::X86::EAX, llvm::X86::EBX),
+       imul32rr(llvm::X86::ECX, llvm::X86::EBX),
+       imul32rr(llvm::X86::EDX, llvm::X86::EBX),
+       imul32rr(llvm::X86::ESI, llvm::X86::EBX)});
+  ASSERT_TRUE(Cycles.hasValue());
+  EXPECT_DOUBLE_EQ(4.0, *Cycles);
+}
+
 } // namespace
 } // namespace exegesis